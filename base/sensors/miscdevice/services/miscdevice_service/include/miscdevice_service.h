@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -40,6 +41,7 @@
 #include "miscdevice_service_stub.h"
 #include "vibrator_hdi_connection.h"
 #include "vibrator_infos.h"
+#include "vibrator_package_cache.h"
 #include "vibrator_thread.h"
 
 namespace OHOS {
@@ -89,6 +91,10 @@ private:
     bool InitInterface();
     bool InitLightInterface();
     std::string GetPackageName(AccessTokenID tokenId);
+    std::optional<HdfEffectInfo> GetEffectInfo(const std::string &effect);
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    int32_t DecodeCustomPackage(const RawFileDescriptor &rawFd, VibratePackage &package);
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
     void StartVibrateThread(VibrateInfo info);
     void StopVibrateThread();
     bool ShouldIgnoreVibrate(const VibrateInfo &info);
@@ -115,6 +121,11 @@ private:
     MiscdeviceServiceState state_;
     std::shared_ptr<VibratorThread> vibratorThread_ = nullptr;
     std::mutex vibratorThreadMutex_;
+    std::unordered_map<std::string, HdfEffectInfo> effectInfos_;
+    std::mutex effectInfoMutex_;
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    VibratorPackageCache packageCache_;
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
     sptr<IRemoteObject::DeathRecipient> clientDeathObserver_ = nullptr;
     std::mutex clientDeathObserverMutex_;
     std::map<sptr<IRemoteObject>, int32_t> clientPidMap_;
@@ -16,9 +16,13 @@
 #ifndef VIBRATION_PRIORITY_MANAGER_H
 #define VIBRATION_PRIORITY_MANAGER_H
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "app_mgr_client.h"
@@ -64,12 +68,20 @@ public:
     DISALLOW_COPY_AND_MOVE(VibrationPriorityManager);
     bool Init();
     VibrateStatus ShouldIgnoreVibrate(const VibrateInfo &vibrateInfo, std::shared_ptr<VibratorThread> vibratorThread);
+    void RemoveInputMethodVerdict(int32_t pid);
+    void ClearInputMethodVerdicts();
 
 private:
+    struct InputMethodVerdict {
+        int32_t uid = -1;
+        std::string packageName;
+        bool isInputMethod = false;
+    };
     bool IsCurrentVibrate(std::shared_ptr<VibratorThread> vibratorThread) const;
     bool IsLoopVibrate(const VibrateInfo &vibrateInfo) const;
     VibrateStatus ShouldIgnoreVibrate(const VibrateInfo &vibrateInfo, VibrateInfo currentVibrateInfo) const;
     bool ShouldIgnoreInputMethod(const VibrateInfo &vibrateInfo);
+    int32_t QueryInputMethod(const VibrateInfo &vibrateInfo, bool &isInputMethod);
     static void ExecRegisterCb(const sptr<MiscDeviceObserver> &observer);
     int32_t RegisterObserver(const sptr<MiscDeviceObserver> &observer);
     int32_t UnregisterObserver(const sptr<MiscDeviceObserver> &observer);
@@ -80,14 +92,24 @@ private:
     std::shared_ptr<DataShare::DataShareHelper> CreateDataShareHelper();
     bool ReleaseDataShareHelper(std::shared_ptr<DataShare::DataShareHelper> &helper);
     sptr<MiscDeviceObserver> CreateObserver(const MiscDeviceObserver::UpdateFunc &func);
+    bool ReadIntSetting(const std::string &key, int32_t defaultValue, std::atomic_int32_t &setting);
+    void ReadSettings();
     void UpdateStatus();
     bool IsSystemServiceCalling();
     bool IsSystemCalling();
     sptr<IRemoteObject> remoteObj_ { nullptr };
+    std::mutex observerMutex_;
     sptr<MiscDeviceObserver> observer_ { nullptr };
     std::shared_ptr<AppExecFwk::AppMgrClient> appMgrClientPtr_ {nullptr};
     std::atomic_int32_t miscFeedback_ = FEEDBACK_MODE_INVALID;
     std::atomic_int32_t miscAudioRingerMode_ = RINGER_MODE_INVALID;
+    // Both settings were read, or found absent, by UpdateStatus or by the observer
+    std::atomic_bool isSettingsValid_ = false;
+    // Steady clock time in ms of the last read by UpdateStatus, 0 before the first one
+    std::atomic_int64_t lastSettingsReadTime_ = 0;
+    // Verdicts keyed by pid, dropped when the process dies or packages change
+    std::mutex inputMethodMutex_;
+    std::unordered_map<int32_t, InputMethodVerdict> inputMethodVerdicts_;
 };
 #define PriorityManager DelayedSingleton<VibrationPriorityManager>::GetInstance()
 }  // namespace Sensors
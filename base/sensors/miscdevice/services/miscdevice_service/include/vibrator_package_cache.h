@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATOR_PACKAGE_CACHE_H
+#define VIBRATOR_PACKAGE_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "nocopyable.h"
+
+#include "raw_file_descriptor.h"
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+// Memory kept for decoded packages, estimated from their patterns, events and curve points
+constexpr size_t PACKAGE_CACHE_BUDGET = 256 * 1024;
+
+// Identity of the haptic file range passed by the client
+struct PackageCacheKey {
+    uint64_t dev = 0;
+    uint64_t ino = 0;
+    int64_t mtimeNs = 0;
+    int64_t fileSize = 0;
+    int64_t offset = 0;
+    int64_t length = 0;
+    bool operator==(const PackageCacheKey &rhs) const
+    {
+        return (dev == rhs.dev) && (ino == rhs.ino) && (mtimeNs == rhs.mtimeNs) && (fileSize == rhs.fileSize) &&
+            (offset == rhs.offset) && (length == rhs.length);
+    }
+};
+
+struct PackageCacheKeyHash {
+    size_t operator()(const PackageCacheKey &key) const;
+};
+
+// LRU cache of decoded haptic packages, so replaying the same asset skips reading and parsing the file
+class VibratorPackageCache {
+public:
+    explicit VibratorPackageCache(size_t budget = PACKAGE_CACHE_BUDGET) : budget_(budget) {}
+    ~VibratorPackageCache() = default;
+    static bool GetKey(const RawFileDescriptor &rawFd, PackageCacheKey &key);
+    // Memory charged to the budget for a package
+    static size_t EstimateSize(const VibratePackage &package);
+    std::shared_ptr<const VibratePackage> Find(const PackageCacheKey &key);
+    void Insert(const PackageCacheKey &key, const VibratePackage &package);
+    void Clear();
+
+private:
+    DISALLOW_COPY_AND_MOVE(VibratorPackageCache);
+    struct CacheEntry {
+        PackageCacheKey key;
+        std::shared_ptr<const VibratePackage> package;
+        size_t size = 0;
+    };
+    std::mutex cacheMutex_;
+    // Most recently used first
+    std::list<CacheEntry> entries_;
+    std::unordered_map<PackageCacheKey, std::list<CacheEntry>::iterator, PackageCacheKeyHash> entryMap_;
+    size_t budget_;
+    size_t usedSize_ = 0;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATOR_PACKAGE_CACHE_H
@@ -16,40 +16,79 @@
 #ifndef VIBRATOR_THREAD_H
 #define VIBRATOR_THREAD_H
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 
-#include "thread_ex.h"
+#include "nocopyable.h"
 
 #include "vibrator_hdi_connection.h"
 #include "vibrator_infos.h"
 
 namespace OHOS {
 namespace Sensors {
-class VibratorThread : public Thread {
+struct VibrateCommand {
+    VibrateInfo info;
+    // Stops the vibration being played instead of starting a new one
+    bool isStop = false;
+    uint64_t seq = 0;
+    std::chrono::steady_clock::time_point submitTime;
+};
+
+// Long-lived vibration executor. A submitted command preempts the vibration being played, the worker picks it up
+// without being restarted. All the HDI starts and stops of the vibrations are made by the worker.
+class VibratorThread {
 public:
-    void UpdateVibratorEffect(const VibrateInfo &vibrateInfo);
+    VibratorThread();
+    ~VibratorThread();
+    void Submit(const VibrateInfo &info);
+    void Stop();
+    bool IsRunning();
     VibrateInfo GetCurrentVibrateInfo();
-    void SetExitStatus(bool status);
-    void WakeUp();
-
-protected:
-    virtual bool Run();
 
 private:
-    int32_t PlayOnce(const VibrateInfo &info);
-    int32_t PlayEffect(const VibrateInfo &info);
-    int32_t PlayCustomByHdHptic(const VibrateInfo &info);
-    int32_t PlayCustomByCompositeEffect(const VibrateInfo &info);
-    int32_t PlayCompositeEffect(const VibrateInfo &info, const HdfCompositeEffect &hdfCompositeEffect);
+    DISALLOW_COPY_AND_MOVE(VibratorThread);
+    void Run();
+    uint64_t Post(std::shared_ptr<VibrateCommand> command);
+    void StopPrevious(const VibrateCommand &command);
+    void MarkHandled(uint64_t seq);
+    void Play(const VibrateCommand &command);
+    bool IsPreempted() const;
+    bool WaitPreempted(int32_t delayTime);
+    void StopDevice(const VibrateInfo &info, HdfVibratorModeV1_2 mode);
+    void RecordStartLatency(const VibrateCommand &command);
+    int32_t PlayOnce(const VibrateCommand &command);
+    int32_t PlayEffect(const VibrateCommand &command);
+    int32_t PlayCustomByHdHptic(const VibrateCommand &command);
+    int32_t PlayCustomByCompositeEffect(const VibrateCommand &command);
+    int32_t PlayCompositeEffect(const VibrateCommand &command, const HdfCompositeEffect &hdfCompositeEffect);
     std::mutex currentVibrationMutex_;
     VibrateInfo currentVibration_;
+    // A vibration is pending or being played, guarded by currentVibrationMutex_
+    bool isRunning_ = false;
+    // The newest command not yet picked up by the worker, exchanged lock-free
+    std::shared_ptr<VibrateCommand> pendingCommand_ = nullptr;
+    // Sequence of the last posted command, guarded by currentVibrationMutex_
+    uint64_t postedSeq_ = 0;
+    // Sequence of the last command whose previous vibration the worker has stopped
+    std::mutex handledMutex_;
+    std::condition_variable handledCv_;
+    uint64_t handledSeq_ = 0;
     std::mutex vibrateMutex_;
     std::condition_variable cv_;
     std::atomic<bool> exitFlag_ = false;
+    // Only touched by the worker: the device was left running for the next command in the same mode
+    bool isDeviceMerged_ = false;
+    HdfVibratorModeV1_2 mergedMode_ = HDF_VIBRATOR_MODE_ONCE;
+    std::string mergedVibrateMode_;
+    std::thread worker_;
 };
 #define VibratorDevice VibratorHdiConnection::GetInstance()
 }  // namespace Sensors
 }  // namespace OHOS
-#endif  // VIBRATOR_THREAD_H
\ No newline at end of file
+#endif  // VIBRATOR_THREAD_H
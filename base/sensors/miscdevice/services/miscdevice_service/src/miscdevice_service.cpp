@@ -66,6 +66,13 @@ constexpr int32_t BASE_YEAR = 1900;
 constexpr int32_t BASE_MON = 1;
 constexpr int32_t CONVERSION_RATE = 1000;
 VibratorCapacity g_capacity;
+// Installing, updating or removing a package may change which processes are input methods
+const std::vector<std::string> PACKAGE_CHANGE_EVENTS = {
+    "usual.event.PACKAGE_ADDED",
+    "usual.event.PACKAGE_CHANGED",
+    "usual.event.PACKAGE_REMOVED",
+    "usual.event.PACKAGE_REPLACED",
+};
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
 const std::string PHONE_TYPE = "phone";
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
@@ -130,6 +137,13 @@ void MiscdeviceService::OnAddSystemAbility(int32_t systemAbilityId, const std::s
             if (ret != ERR_OK) {
                 MISC_HILOGE("Subscribe usual.event.DATA_SHARE_READY fail");
             }
+            for (const auto &eventName : PACKAGE_CHANGE_EVENTS) {
+                ret = SubscribeCommonEvent(eventName,
+                    std::bind(&MiscdeviceService::OnReceiveEvent, this, std::placeholders::_1));
+                if (ret != ERR_OK) {
+                    MISC_HILOGE("Subscribe %{public}s fail", eventName.c_str());
+                }
+            }
             AddSystemAbilityListener(DISTRIBUTED_KV_DATA_SERVICE_ABILITY_ID);
             break;
         }
@@ -155,6 +169,12 @@ void MiscdeviceService::OnReceiveEvent(const EventFwk::CommonEventData &data)
 {
     const auto &want = data.GetWant();
     std::string action = want.GetAction();
+    if (std::find(PACKAGE_CHANGE_EVENTS.begin(), PACKAGE_CHANGE_EVENTS.end(), action) !=
+        PACKAGE_CHANGE_EVENTS.end()) {
+        MISC_HILOGD("On receive %{public}s", action.c_str());
+        PriorityManager->ClearInputMethodVerdicts();
+        return;
+    }
     if (action == "usual.event.DATA_SHARE_READY") {
         MISC_HILOGI("On receive usual.event.DATA_SHARE_READY");
         std::lock_guard<std::mutex> lock(isVibrationPriorityReadyMutex_);
@@ -349,10 +369,6 @@ int32_t MiscdeviceService::StopVibrator(int32_t vibratorId)
         MISC_HILOGD("No vibration, no need to stop");
         return ERROR;
     }
-    if (vibratorHdiConnection_.IsVibratorRunning()) {
-        vibratorHdiConnection_.Stop(HDF_VIBRATOR_MODE_PRESET);
-        vibratorHdiConnection_.Stop(HDF_VIBRATOR_MODE_HDHAPTIC);
-    }
 #else
     if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsRunning())) {
         MISC_HILOGD("No vibration, no need to stop");
@@ -374,7 +390,7 @@ int32_t MiscdeviceService::PlayVibratorEffect(int32_t vibratorId, const std::str
         MISC_HILOGE("Invalid parameter");
         return PARAMETER_ERROR;
     }
-    std::optional<HdfEffectInfo> effectInfo = vibratorHdiConnection_.GetEffectInfo(effect);
+    std::optional<HdfEffectInfo> effectInfo = GetEffectInfo(effect);
     if (!effectInfo) {
         MISC_HILOGE("GetEffectInfo fail");
         return ERROR;
@@ -408,30 +424,38 @@ int32_t MiscdeviceService::PlayVibratorEffect(int32_t vibratorId, const std::str
     return NO_ERROR;
 }
 
+std::optional<HdfEffectInfo> MiscdeviceService::GetEffectInfo(const std::string &effect)
+{
+    {
+        std::lock_guard<std::mutex> effectInfoLock(effectInfoMutex_);
+        auto iter = effectInfos_.find(effect);
+        if (iter != effectInfos_.end()) {
+            return iter->second;
+        }
+    }
+    // Effect information does not change at runtime, keep it so repeated effects skip the HDI query
+    std::optional<HdfEffectInfo> effectInfo = vibratorHdiConnection_.GetEffectInfo(effect);
+    if (effectInfo) {
+        std::lock_guard<std::mutex> effectInfoLock(effectInfoMutex_);
+        effectInfos_.emplace(effect, *effectInfo);
+    }
+    return effectInfo;
+}
+
 void MiscdeviceService::StartVibrateThread(VibrateInfo info)
 {
     if (vibratorThread_ == nullptr) {
         vibratorThread_ = std::make_shared<VibratorThread>();
     }
-    StopVibrateThread();
-#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
-    if (vibratorHdiConnection_.IsVibratorRunning()) {
-        vibratorHdiConnection_.Stop(HDF_VIBRATOR_MODE_PRESET);
-        vibratorHdiConnection_.Stop(HDF_VIBRATOR_MODE_HDHAPTIC);
-    }
-#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
-    vibratorThread_->UpdateVibratorEffect(info);
-    vibratorThread_->Start("VibratorThread");
+    vibratorThread_->Submit(info);
     DumpHelper->SaveVibrateRecord(info);
 }
 
 void MiscdeviceService::StopVibrateThread()
 {
-    if ((vibratorThread_ != nullptr) && (vibratorThread_->IsRunning())) {
-        vibratorThread_->SetExitStatus(true);
-        vibratorThread_->WakeUp();
-        vibratorThread_->NotifyExitSync();
-        vibratorThread_->SetExitStatus(false);
+    // The worker also stops the effects it did not start, so it is asked even when it is idle
+    if (vibratorThread_ != nullptr) {
+        vibratorThread_->Stop();
     }
 }
 
@@ -457,7 +481,7 @@ int32_t MiscdeviceService::StopVibrator(int32_t vibratorId, const std::string &m
 
 int32_t MiscdeviceService::IsSupportEffect(const std::string &effect, bool &state)
 {
-    std::optional<HdfEffectInfo> effectInfo = vibratorHdiConnection_.GetEffectInfo(effect);
+    std::optional<HdfEffectInfo> effectInfo = GetEffectInfo(effect);
     if (!effectInfo) {
         MISC_HILOGE("GetEffectInfo fail");
         return ERROR;
@@ -485,6 +509,33 @@ std::string MiscdeviceService::GetCurrentTime()
 }
 
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+int32_t MiscdeviceService::DecodeCustomPackage(const RawFileDescriptor &rawFd, VibratePackage &package)
+{
+    PackageCacheKey key;
+    bool isCacheable = VibratorPackageCache::GetKey(rawFd, key);
+    if (isCacheable) {
+        std::shared_ptr<const VibratePackage> cachePackage = packageCache_.Find(key);
+        if (cachePackage != nullptr) {
+            MISC_HILOGD("Decoded package found in cache");
+            package = *cachePackage;
+            return SUCCESS;
+        }
+    }
+    JsonParser parser(rawFd);
+    VibratorDecoderCreator creator;
+    std::unique_ptr<IVibratorDecoder> decoder(creator.CreateDecoder(parser));
+    CHKPR(decoder, ERROR);
+    int32_t ret = decoder->DecodeEffect(rawFd, parser, package);
+    if (ret != SUCCESS || package.patterns.empty()) {
+        MISC_HILOGE("Decode effect error");
+        return ERROR;
+    }
+    if (isCacheable) {
+        packageCache_.Insert(key, package);
+    }
+    return SUCCESS;
+}
+
 int32_t MiscdeviceService::PlayVibratorCustom(int32_t vibratorId, const RawFileDescriptor &rawFd, int32_t usage,
     bool systemUsage, const VibrateParameter &parameter)
 {
@@ -496,12 +547,8 @@ int32_t MiscdeviceService::PlayVibratorCustom(int32_t vibratorId, const RawFileD
         MISC_HILOGE("Invalid parameter, usage:%{public}d", usage);
         return PARAMETER_ERROR;
     }
-    JsonParser parser(rawFd);
-    VibratorDecoderCreator creator;
-    std::unique_ptr<IVibratorDecoder> decoder(creator.CreateDecoder(parser));
-    CHKPR(decoder, ERROR);
     VibratePackage package;
-    int32_t ret = decoder->DecodeEffect(rawFd, parser, package);
+    int32_t ret = DecodeCustomPackage(rawFd, package);
     if (ret != SUCCESS || package.patterns.empty()) {
         MISC_HILOGE("Decode effect error");
         return ERROR;
@@ -772,6 +819,9 @@ void MiscdeviceService::ProcessDeathObserver(const wptr<IRemoteObject> &object)
     }
     int32_t vibratePid = info.pid;
     MISC_HILOGI("ClientPid:%{public}d, VibratePid:%{public}d", clientPid, vibratePid);
+    if (clientPid != INVALID_PID) {
+        PriorityManager->RemoveInputMethodVerdict(clientPid);
+    }
     if ((clientPid != INVALID_PID) && (clientPid == vibratePid)) {
         StopVibrator(VIBRATOR_ID);
     }
@@ -859,7 +909,7 @@ int32_t MiscdeviceService::PlayPrimitiveEffect(int32_t vibratorId, const std::st
         MISC_HILOGE("Invalid parameter");
         return PARAMETER_ERROR;
     }
-    std::optional<HdfEffectInfo> effectInfo = vibratorHdiConnection_.GetEffectInfo(effect);
+    std::optional<HdfEffectInfo> effectInfo = GetEffectInfo(effect);
     if (!effectInfo) {
         MISC_HILOGE("GetEffectInfo fail");
         return ERROR;
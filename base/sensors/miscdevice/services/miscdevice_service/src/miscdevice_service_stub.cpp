@@ -15,6 +15,7 @@
 
 #include "miscdevice_service_stub.h"
 
+#include <cerrno>
 #include <string>
 #include <unistd.h>
 
@@ -186,6 +187,10 @@ int32_t MiscdeviceServiceStub::PlayVibratorCustomStub(MessageParcel &data, Messa
         return ERROR;
     }
     ret = PlayVibratorCustom(vibratorId, rawFd, usage, systemUsage, parameter.value());
+    // The file is read with pread and may not be read at all on a cache hit, the stub owns the received fd
+    if (close(rawFd.fd) != 0) {
+        MISC_HILOGW("Close fd failed, errno:%{public}d", errno);
+    }
     if (ret != ERR_OK) {
         MISC_HILOGD("PlayVibratorCustom failed, ret:%{public}d", ret);
         return ret;
@@ -15,6 +15,7 @@
 
 #include "vibration_priority_manager.h"
 
+#include <chrono>
 #include <tokenid_kit.h>
 
 #include "accesstoken_kit.h"
@@ -44,6 +45,8 @@ constexpr const char *SETTINGS_DATA_EXT_URI = "datashare:///com.ohos.settingsdat
 constexpr int32_t DECEM_BASE = 10;
 constexpr int32_t DATA_SHARE_READY = 0;
 constexpr int32_t DATA_SHARE_NOT_READY = 1055;
+constexpr size_t INPUT_METHOD_VERDICT_MAX = 128;
+constexpr int64_t SETTINGS_RETRY_INTERVAL_MS = 1000;
 }  // namespace
 
 VibrationPriorityManager::VibrationPriorityManager() {}
@@ -51,6 +54,7 @@ VibrationPriorityManager::VibrationPriorityManager() {}
 VibrationPriorityManager::~VibrationPriorityManager()
 {
     remoteObj_ = nullptr;
+    std::lock_guard<std::mutex> observerLock(observerMutex_);
     if (UnregisterObserver(observer_) != ERR_OK) {
         MISC_HILOGE("UnregisterObserver failed");
     }
@@ -69,26 +73,22 @@ bool VibrationPriorityManager::Init()
         return false;
     }
     MiscDeviceObserver::UpdateFunc updateFunc = [&]() {
-        int32_t feedback = miscFeedback_;
-        if (GetIntValue(SETTING_FEEDBACK_KEY, feedback) != ERR_OK) {
-            MISC_HILOGE("Get feedback failed");
-        }
-        miscFeedback_ = feedback;
-        MISC_HILOGI("feedback:%{public}d", feedback);
-        int32_t ringerMode = miscAudioRingerMode_;
-        if (GetIntValue(SETTING_RINGER_MODE_KEY, ringerMode) != ERR_OK) {
-            MISC_HILOGE("Get ringerMode failed");
-        }
-        miscAudioRingerMode_ = ringerMode;
-        MISC_HILOGI("ringerMode:%{public}d", ringerMode);
+        ReadSettings();
+        MISC_HILOGI("feedback:%{public}d, ringerMode:%{public}d", static_cast<int32_t>(miscFeedback_),
+            static_cast<int32_t>(miscAudioRingerMode_));
     };
-    auto observer_ = CreateObserver(updateFunc);
+    std::lock_guard<std::mutex> observerLock(observerMutex_);
+    if (observer_ != nullptr) {
+        return true;
+    }
+    observer_ = CreateObserver(updateFunc);
     if (observer_ == nullptr) {
         MISC_HILOGE("observer is null");
         return false;
     }
     if (RegisterObserver(observer_) != ERR_OK) {
         MISC_HILOGE("RegisterObserver failed");
+        observer_ = nullptr;
         return false;
     }
     return true;
@@ -155,24 +155,47 @@ int32_t VibrationPriorityManager::GetStringValue(const std::string &key, std::st
     return ERR_OK;
 }
 
+bool VibrationPriorityManager::ReadIntSetting(const std::string &key, int32_t defaultValue,
+    std::atomic_int32_t &setting)
+{
+    int32_t value = defaultValue;
+    int32_t ret = GetIntValue(key, value);
+    if ((ret != ERR_OK) && (ret != MISC_NAME_NOT_FOUND_ERR)) {
+        // The value read before is kept, an invalid one neither ignores nor silences vibrations
+        MISC_HILOGE("Get %{public}s failed, ret:%{public}d", key.c_str(), ret);
+        return false;
+    }
+    // An absent key keeps the default until the observer reports that it was written
+    setting = value;
+    return true;
+}
+
+void VibrationPriorityManager::ReadSettings()
+{
+    bool isFeedbackRead = ReadIntSetting(SETTING_FEEDBACK_KEY, FEEDBACK_MODE_ON, miscFeedback_);
+    bool isRingerModeRead = ReadIntSetting(SETTING_RINGER_MODE_KEY, RINGER_MODE_NORMAL, miscAudioRingerMode_);
+    if (isFeedbackRead && isRingerModeRead) {
+        isSettingsValid_ = true;
+    }
+}
+
 void VibrationPriorityManager::UpdateStatus()
 {
-    if (miscFeedback_ == FEEDBACK_MODE_INVALID) {
-        int32_t feedback = FEEDBACK_MODE_INVALID;
-        if (GetIntValue(SETTING_FEEDBACK_KEY, feedback) != ERR_OK) {
-            feedback = FEEDBACK_MODE_ON;
-            MISC_HILOGE("Get feedback failed");
-        }
-        miscFeedback_ = feedback;
+    // Once both settings are read the observer keeps them up to date
+    if (isSettingsValid_) {
+        return;
     }
-    if (miscAudioRingerMode_ == RINGER_MODE_INVALID) {
-        int32_t ringerMode = RINGER_MODE_INVALID;
-        if (GetIntValue(SETTING_RINGER_MODE_KEY, ringerMode) != ERR_OK) {
-            ringerMode = RINGER_MODE_NORMAL;
-            MISC_HILOGE("Get ringerMode failed");
-        }
-        miscAudioRingerMode_ = ringerMode;
+    // Until then a failed read is retried at most once per interval, not on every vibration
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t lastReadTime = lastSettingsReadTime_.load();
+    if ((lastReadTime != 0) && (now - lastReadTime < SETTINGS_RETRY_INTERVAL_MS)) {
+        return;
     }
+    if (!lastSettingsReadTime_.compare_exchange_strong(lastReadTime, now)) {
+        return;
+    }
+    ReadSettings();
 }
 
 bool VibrationPriorityManager::IsSystemServiceCalling()
@@ -200,30 +223,55 @@ bool VibrationPriorityManager::ShouldIgnoreInputMethod(const VibrateInfo &vibrat
         MISC_HILOGD("Can not ignore for %{public}s", vibrateInfo.packageName.c_str());
         return false;
     }
+    {
+        std::lock_guard<std::mutex> inputMethodLock(inputMethodMutex_);
+        auto iter = inputMethodVerdicts_.find(vibrateInfo.pid);
+        // A reused pid belongs to another uid or package, the verdict is queried again
+        if ((iter != inputMethodVerdicts_.end()) && (iter->second.uid == vibrateInfo.uid) &&
+            (iter->second.packageName == vibrateInfo.packageName)) {
+            return iter->second.isInputMethod;
+        }
+    }
+    bool isInputMethod = false;
+    if (QueryInputMethod(vibrateInfo, isInputMethod) != ERR_OK) {
+        return false;
+    }
+    std::lock_guard<std::mutex> inputMethodLock(inputMethodMutex_);
+    if (inputMethodVerdicts_.size() >= INPUT_METHOD_VERDICT_MAX) {
+        inputMethodVerdicts_.clear();
+    }
+    inputMethodVerdicts_[vibrateInfo.pid] = { vibrateInfo.uid, vibrateInfo.packageName, isInputMethod };
+    return isInputMethod;
+}
+
+int32_t VibrationPriorityManager::QueryInputMethod(const VibrateInfo &vibrateInfo, bool &isInputMethod)
+{
+    isInputMethod = false;
     int32_t pid = vibrateInfo.pid;
     AppExecFwk::RunningProcessInfo processinfo{};
     appMgrClientPtr_ = DelayedSingleton<AppExecFwk::AppMgrClient>::GetInstance();
     if (appMgrClientPtr_ == nullptr) {
         MISC_HILOGE("appMgrClientPtr is nullptr");
-        return false;
+        return ERROR;
     }
     int32_t ret = appMgrClientPtr_->AppExecFwk::AppMgrClient::GetRunningProcessInfoByPid(pid, processinfo);
     if (ret != ERR_OK) {
         MISC_HILOGE("Getrunningprocessinfobypid failed");
-        return false;
+        return ERROR;
     }
     if (processinfo.extensionType_ == AppExecFwk::ExtensionAbilityType::INPUTMETHOD) {
-        return true;
+        isInputMethod = true;
+        return ERR_OK;
     }
     std::vector<int32_t> activeUserIds;
     int retId = AccountSA::OsAccountManager::QueryActiveOsAccountIds(activeUserIds);
     if (retId != 0) {
         MISC_HILOGE("QueryActiveOsAccountIds failed %{public}d", retId);
-        return false;
+        return ERROR;
     }
     if (activeUserIds.empty()) {
         MISC_HILOGE("activeUserId empty");
-        return false;
+        return ERROR;
     }
     for (const auto &bundleName : processinfo.bundleNames) {
         MISC_HILOGD("bundleName = %{public}s", bundleName.c_str());
@@ -233,16 +281,29 @@ bool VibrationPriorityManager::ShouldIgnoreInputMethod(const VibrateInfo &vibrat
             AppExecFwk::BundleFlag::GET_BUNDLE_WITH_EXTENSION_INFO, bundleInfo, activeUserIds[0]);
         if (!res) {
             MISC_HILOGE("Getbundleinfo fail");
-            return false;
+            return ERROR;
         }
         for (const auto &extensionInfo : bundleInfo.extensionInfos) {
             if (extensionInfo.type == AppExecFwk::ExtensionAbilityType::INPUTMETHOD) {
                 MISC_HILOGD("extensioninfo type is %{public}d", extensionInfo.type);
-                return true;
+                isInputMethod = true;
+                return ERR_OK;
             }
         }
     }
-    return false;
+    return ERR_OK;
+}
+
+void VibrationPriorityManager::RemoveInputMethodVerdict(int32_t pid)
+{
+    std::lock_guard<std::mutex> inputMethodLock(inputMethodMutex_);
+    inputMethodVerdicts_.erase(pid);
+}
+
+void VibrationPriorityManager::ClearInputMethodVerdicts()
+{
+    std::lock_guard<std::mutex> inputMethodLock(inputMethodMutex_);
+    inputMethodVerdicts_.clear();
 }
 
 VibrateStatus VibrationPriorityManager::ShouldIgnoreVibrate(const VibrateInfo &vibrateInfo,
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vibrator_package_cache.h"
+
+#include <cerrno>
+#include <functional>
+#include <sys/stat.h>
+
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratorPackageCache"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr int64_t SECOND_NS = 1000000000;
+constexpr size_t HASH_SEED = 0x9e3779b9;
+constexpr size_t HASH_LEFT_SHIFT = 6;
+constexpr size_t HASH_RIGHT_SHIFT = 2;
+
+template<typename T>
+void HashCombine(size_t &seed, const T &value)
+{
+    seed ^= std::hash<T>()(value) + HASH_SEED + (seed << HASH_LEFT_SHIFT) + (seed >> HASH_RIGHT_SHIFT);
+}
+}  // namespace
+
+size_t PackageCacheKeyHash::operator()(const PackageCacheKey &key) const
+{
+    size_t seed = 0;
+    HashCombine(seed, key.dev);
+    HashCombine(seed, key.ino);
+    HashCombine(seed, key.mtimeNs);
+    HashCombine(seed, key.fileSize);
+    HashCombine(seed, key.offset);
+    HashCombine(seed, key.length);
+    return seed;
+}
+
+bool VibratorPackageCache::GetKey(const RawFileDescriptor &rawFd, PackageCacheKey &key)
+{
+    if (rawFd.fd < 0) {
+        MISC_HILOGE("fd is invalid, fd:%{public}d", rawFd.fd);
+        return false;
+    }
+    struct stat64 statbuf = { 0 };
+    if (fstat64(rawFd.fd, &statbuf) != 0) {
+        MISC_HILOGE("fstat error, errno:%{public}d", errno);
+        return false;
+    }
+    // Pipes and sockets have no stable content behind their identity
+    if (!S_ISREG(statbuf.st_mode)) {
+        MISC_HILOGD("Not a regular file, skip cache");
+        return false;
+    }
+    key.dev = static_cast<uint64_t>(statbuf.st_dev);
+    key.ino = static_cast<uint64_t>(statbuf.st_ino);
+    key.mtimeNs = static_cast<int64_t>(statbuf.st_mtim.tv_sec) * SECOND_NS + statbuf.st_mtim.tv_nsec;
+    key.fileSize = static_cast<int64_t>(statbuf.st_size);
+    key.offset = rawFd.offset;
+    key.length = rawFd.length;
+    return true;
+}
+
+std::shared_ptr<const VibratePackage> VibratorPackageCache::Find(const PackageCacheKey &key)
+{
+    std::lock_guard<std::mutex> cacheLock(cacheMutex_);
+    auto iter = entryMap_.find(key);
+    if (iter == entryMap_.end()) {
+        return nullptr;
+    }
+    entries_.splice(entries_.begin(), entries_, iter->second);
+    return iter->second->package;
+}
+
+void VibratorPackageCache::Insert(const PackageCacheKey &key, const VibratePackage &package)
+{
+    size_t size = EstimateSize(package);
+    if (size > budget_) {
+        MISC_HILOGW("Package is too large to cache, size:%{public}zu", size);
+        return;
+    }
+    auto cachePackage = std::make_shared<const VibratePackage>(package);
+    std::lock_guard<std::mutex> cacheLock(cacheMutex_);
+    auto iter = entryMap_.find(key);
+    if (iter != entryMap_.end()) {
+        usedSize_ -= iter->second->size;
+        entries_.erase(iter->second);
+        entryMap_.erase(iter);
+    }
+    while (!entries_.empty() && (usedSize_ + size > budget_)) {
+        usedSize_ -= entries_.back().size;
+        entryMap_.erase(entries_.back().key);
+        entries_.pop_back();
+    }
+    entries_.push_front({ key, cachePackage, size });
+    entryMap_[key] = entries_.begin();
+    usedSize_ += size;
+}
+
+void VibratorPackageCache::Clear()
+{
+    std::lock_guard<std::mutex> cacheLock(cacheMutex_);
+    entries_.clear();
+    entryMap_.clear();
+    usedSize_ = 0;
+}
+
+size_t VibratorPackageCache::EstimateSize(const VibratePackage &package)
+{
+    size_t size = sizeof(CacheEntry) + sizeof(VibratePackage);
+    for (const auto &pattern : package.patterns) {
+        size += sizeof(VibratePattern);
+        for (const auto &event : pattern.events) {
+            size += sizeof(VibrateEvent) + event.points.size() * sizeof(VibrateCurvePoint);
+        }
+    }
+    return size;
+}
+}  // namespace Sensors
+}  // namespace OHOS
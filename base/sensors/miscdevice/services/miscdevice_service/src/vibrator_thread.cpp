@@ -15,6 +15,7 @@
 
 #include "vibrator_thread.h"
 
+#include <cinttypes>
 #include <sys/prctl.h>
 
 #include "custom_vibration_matcher.h"
@@ -30,59 +31,156 @@ const std::string VIBRATE_CONTROL_THREAD_NAME = "OS_VibControl";
 constexpr size_t COMPOSITE_EFFECT_PART = 128;
 }  // namespace
 
-bool VibratorThread::Run()
+VibratorThread::VibratorThread()
+{
+    worker_ = std::thread([this] { Run(); });
+}
+
+VibratorThread::~VibratorThread()
+{
+    exitFlag_.store(true);
+    {
+        std::lock_guard<std::mutex> vibrateLock(vibrateMutex_);
+    }
+    cv_.notify_one();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void VibratorThread::Run()
 {
     CALL_LOG_ENTER;
     prctl(PR_SET_NAME, VIBRATE_CONTROL_THREAD_NAME.c_str());
-    VibrateInfo info = GetCurrentVibrateInfo();
+    while (!exitFlag_.load()) {
+        {
+            std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
+            cv_.wait(vibrateLck, [this] { return IsPreempted(); });
+        }
+        std::shared_ptr<VibrateCommand> command = std::atomic_exchange(&pendingCommand_,
+            std::shared_ptr<VibrateCommand>(nullptr));
+        if (command == nullptr) {
+            continue;
+        }
+        StopPrevious(*command);
+        MarkHandled(command->seq);
+        if (!command->isStop) {
+            Play(*command);
+        }
+        std::lock_guard<std::mutex> currentVibrationLock(currentVibrationMutex_);
+        if (std::atomic_load(&pendingCommand_) == nullptr) {
+            isRunning_ = false;
+        }
+    }
+    if (isDeviceMerged_) {
+        VibratorDevice.Stop(mergedMode_);
+    }
+}
+
+void VibratorThread::StopPrevious(const VibrateCommand &command)
+{
+    bool isMerged = isDeviceMerged_ && !command.isStop && (command.info.mode == mergedVibrateMode_);
+    if (isDeviceMerged_ && !isMerged) {
+        VibratorDevice.Stop(mergedMode_);
+    }
+    isDeviceMerged_ = false;
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    // The device may still play an effect this worker did not start
+    if (!isMerged && VibratorDevice.IsVibratorRunning()) {
+        VibratorDevice.Stop(HDF_VIBRATOR_MODE_PRESET);
+        VibratorDevice.Stop(HDF_VIBRATOR_MODE_HDHAPTIC);
+    }
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+}
+
+void VibratorThread::MarkHandled(uint64_t seq)
+{
+    {
+        std::lock_guard<std::mutex> handledLock(handledMutex_);
+        handledSeq_ = seq;
+    }
+    handledCv_.notify_all();
+}
+
+void VibratorThread::Play(const VibrateCommand &command)
+{
+    const VibrateInfo &info = command.info;
     if (info.mode == VIBRATE_TIME) {
-        int32_t ret = PlayOnce(info);
+        int32_t ret = PlayOnce(command);
         if (ret != SUCCESS) {
             MISC_HILOGE("Play once vibration fail, package:%{public}s", info.packageName.c_str());
-            return false;
         }
     } else if (info.mode == VIBRATE_PRESET) {
-        int32_t ret = PlayEffect(info);
+        int32_t ret = PlayEffect(command);
         if (ret != SUCCESS) {
             MISC_HILOGE("Play effect vibration fail, package:%{public}s", info.packageName.c_str());
-            return false;
         }
     } else if (info.mode == VIBRATE_CUSTOM_HD) {
-        int32_t ret = PlayCustomByHdHptic(info);
+        int32_t ret = PlayCustomByHdHptic(command);
         if (ret != SUCCESS) {
             MISC_HILOGE("Play custom vibration by hd haptic fail, package:%{public}s", info.packageName.c_str());
-            return false;
         }
     } else if (info.mode == VIBRATE_CUSTOM_COMPOSITE_EFFECT || info.mode == VIBRATE_CUSTOM_COMPOSITE_TIME) {
-        int32_t ret = PlayCustomByCompositeEffect(info);
+        int32_t ret = PlayCustomByCompositeEffect(command);
         if (ret != SUCCESS) {
             MISC_HILOGE("Play custom vibration by composite effect fail, package:%{public}s", info.packageName.c_str());
-            return false;
         }
     }
-    return false;
 }
 
-int32_t VibratorThread::PlayOnce(const VibrateInfo &info)
+bool VibratorThread::IsPreempted() const
+{
+    return exitFlag_.load() || (std::atomic_load(&pendingCommand_) != nullptr);
+}
+
+bool VibratorThread::WaitPreempted(int32_t delayTime)
 {
     std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
+    return cv_.wait_for(vibrateLck, std::chrono::milliseconds(delayTime), [this] { return IsPreempted(); });
+}
+
+void VibratorThread::StopDevice(const VibrateInfo &info, HdfVibratorModeV1_2 mode)
+{
+    // A preempting vibration of the same kind restarts the device right away, stopping it first only adds latency
+    std::shared_ptr<VibrateCommand> next = std::atomic_load(&pendingCommand_);
+    if (!exitFlag_.load() && (next != nullptr) && !next->isStop && (next->info.mode == info.mode) &&
+        ((info.mode == VIBRATE_TIME) || (info.mode == VIBRATE_PRESET))) {
+        isDeviceMerged_ = true;
+        mergedMode_ = mode;
+        mergedVibrateMode_ = info.mode;
+        return;
+    }
+    VibratorDevice.Stop(mode);
+}
+
+void VibratorThread::RecordStartLatency(const VibrateCommand &command)
+{
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - command.submitTime);
+    MISC_HILOGD("Start latency:%{public}" PRId64 "us, mode:%{public}s",
+        static_cast<int64_t>(latency.count()), command.info.mode.c_str());
+}
+
+int32_t VibratorThread::PlayOnce(const VibrateCommand &command)
+{
+    const VibrateInfo &info = command.info;
     int32_t ret = VibratorDevice.StartOnce(static_cast<uint32_t>(info.duration));
     if (ret != SUCCESS) {
         MISC_HILOGE("StartOnce fail, duration:%{public}d", info.duration);
         return ERROR;
     }
-    cv_.wait_for(vibrateLck, std::chrono::milliseconds(info.duration), [this] { return exitFlag_.load(); });
-    VibratorDevice.Stop(HDF_VIBRATOR_MODE_ONCE);
-    if (exitFlag_) {
+    RecordStartLatency(command);
+    WaitPreempted(info.duration);
+    StopDevice(info, HDF_VIBRATOR_MODE_ONCE);
+    if (IsPreempted()) {
         MISC_HILOGD("Stop duration:%{public}d, package:%{public}s", info.duration, info.packageName.c_str());
-        return SUCCESS;
     }
     return SUCCESS;
 }
 
-int32_t VibratorThread::PlayEffect(const VibrateInfo &info)
+int32_t VibratorThread::PlayEffect(const VibrateCommand &command)
 {
-    std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
+    const VibrateInfo &info = command.info;
     for (int32_t i = 0; i < info.count; ++i) {
         std::string effect = info.effect;
         int32_t ret = VibratorDevice.StartByIntensity(effect, info.intensity);
@@ -90,9 +188,12 @@ int32_t VibratorThread::PlayEffect(const VibrateInfo &info)
             MISC_HILOGE("Vibrate effect %{public}s failed, ", effect.c_str());
             return ERROR;
         }
-        cv_.wait_for(vibrateLck, std::chrono::milliseconds(info.duration), [this] { return exitFlag_.load(); });
-        VibratorDevice.Stop(HDF_VIBRATOR_MODE_PRESET);
-        if (exitFlag_) {
+        if (i == 0) {
+            RecordStartLatency(command);
+        }
+        WaitPreempted(info.duration);
+        StopDevice(info, HDF_VIBRATOR_MODE_PRESET);
+        if (IsPreempted()) {
             MISC_HILOGD("Stop effect:%{public}s, package:%{public}s", effect.c_str(), info.packageName.c_str());
             return SUCCESS;
         }
@@ -100,9 +201,9 @@ int32_t VibratorThread::PlayEffect(const VibrateInfo &info)
     return SUCCESS;
 }
 
-int32_t VibratorThread::PlayCustomByHdHptic(const VibrateInfo &info)
+int32_t VibratorThread::PlayCustomByHdHptic(const VibrateCommand &command)
 {
-    std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
+    const VibrateInfo &info = command.info;
     const std::vector<VibratePattern> &patterns = info.package.patterns;
     size_t patternSize = patterns.size();
     for (size_t i = 0; i < patternSize; ++i) {
@@ -112,8 +213,7 @@ int32_t VibratorThread::PlayCustomByHdHptic(const VibrateInfo &info)
         } else {
             delayTime = patterns[i].startTime - patterns[i - 1].startTime;
         }
-        cv_.wait_for(vibrateLck, std::chrono::milliseconds(delayTime), [this] { return exitFlag_.load(); });
-        if (exitFlag_) {
+        if (WaitPreempted(delayTime)) {
             VibratorDevice.Stop(HDF_VIBRATOR_MODE_HDHAPTIC);
             MISC_HILOGD("Stop hd haptic, package:%{public}s", info.packageName.c_str());
             return SUCCESS;
@@ -123,12 +223,16 @@ int32_t VibratorThread::PlayCustomByHdHptic(const VibrateInfo &info)
             MISC_HILOGE("Vibrate hd haptic failed");
             return ERROR;
         }
+        if (i == 0) {
+            RecordStartLatency(command);
+        }
     }
     return SUCCESS;
 }
 
-int32_t VibratorThread::PlayCustomByCompositeEffect(const VibrateInfo &info)
+int32_t VibratorThread::PlayCustomByCompositeEffect(const VibrateCommand &command)
 {
+    const VibrateInfo &info = command.info;
     auto &matcher = CustomVibrationMatcher::GetInstance();
     HdfCompositeEffect hdfCompositeEffect;
     if (info.mode == VIBRATE_CUSTOM_COMPOSITE_EFFECT) {
@@ -146,16 +250,18 @@ int32_t VibratorThread::PlayCustomByCompositeEffect(const VibrateInfo &info)
             return ERROR;
         }
     }
-    return PlayCompositeEffect(info, hdfCompositeEffect);
+    return PlayCompositeEffect(command, hdfCompositeEffect);
 }
 
-int32_t VibratorThread::PlayCompositeEffect(const VibrateInfo &info, const HdfCompositeEffect &hdfCompositeEffect)
+int32_t VibratorThread::PlayCompositeEffect(const VibrateCommand &command,
+    const HdfCompositeEffect &hdfCompositeEffect)
 {
-    std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
+    const VibrateInfo &info = command.info;
     HdfCompositeEffect effectsPart;
     effectsPart.type = hdfCompositeEffect.type;
     size_t effectSize = hdfCompositeEffect.compositeEffects.size();
     int32_t delayTime = 0;
+    bool isStarted = false;
     for (size_t i = 0; i < effectSize; ++i) {
         effectsPart.compositeEffects.push_back(hdfCompositeEffect.compositeEffects[i]);
         if (effectsPart.type == HDF_EFFECT_TYPE_TIME) {
@@ -172,11 +278,15 @@ int32_t VibratorThread::PlayCompositeEffect(const VibrateInfo &info, const HdfCo
                 MISC_HILOGE("EnableCompositeEffect failed");
                 return ERROR;
             }
-            cv_.wait_for(vibrateLck, std::chrono::milliseconds(delayTime), [this] { return exitFlag_.load(); });
+            if (!isStarted) {
+                RecordStartLatency(command);
+                isStarted = true;
+            }
+            WaitPreempted(delayTime);
             delayTime = 0;
             effectsPart.compositeEffects.clear();
         }
-        if (exitFlag_) {
+        if (IsPreempted()) {
             VibratorDevice.Stop(HDF_VIBRATOR_MODE_PRESET);
             MISC_HILOGD("Stop composite effect part, package:%{public}s", info.packageName.c_str());
             return SUCCESS;
@@ -185,27 +295,55 @@ int32_t VibratorThread::PlayCompositeEffect(const VibrateInfo &info, const HdfCo
     return SUCCESS;
 }
 
-void VibratorThread::UpdateVibratorEffect(const VibrateInfo &info)
+uint64_t VibratorThread::Post(std::shared_ptr<VibrateCommand> command)
 {
-    std::unique_lock<std::mutex> lck(currentVibrationMutex_);
+    command->seq = ++postedSeq_;
+    std::atomic_store(&pendingCommand_, command);
+    {
+        // Pairs with the wait of the worker, so the wakeup cannot slip in between its check and its sleep
+        std::lock_guard<std::mutex> vibrateLock(vibrateMutex_);
+    }
+    cv_.notify_one();
+    return command->seq;
+}
+
+void VibratorThread::Submit(const VibrateInfo &info)
+{
+    auto command = std::make_shared<VibrateCommand>();
+    command->info = info;
+    command->submitTime = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> currentVibrationLock(currentVibrationMutex_);
     currentVibration_ = info;
+    isRunning_ = true;
+    Post(command);
 }
 
-VibrateInfo VibratorThread::GetCurrentVibrateInfo()
+void VibratorThread::Stop()
 {
-    std::unique_lock<std::mutex> lck(currentVibrationMutex_);
-    return currentVibration_;
+    auto command = std::make_shared<VibrateCommand>();
+    command->isStop = true;
+    command->submitTime = std::chrono::steady_clock::now();
+    uint64_t seq = 0;
+    {
+        std::lock_guard<std::mutex> currentVibrationLock(currentVibrationMutex_);
+        isRunning_ = false;
+        seq = Post(command);
+    }
+    // The motor is stopped once the worker has picked up this command or a newer one
+    std::unique_lock<std::mutex> handledLock(handledMutex_);
+    handledCv_.wait(handledLock, [this, seq] { return handledSeq_ >= seq; });
 }
 
-void VibratorThread::SetExitStatus(bool status)
+bool VibratorThread::IsRunning()
 {
-    exitFlag_.store(status);
+    std::lock_guard<std::mutex> currentVibrationLock(currentVibrationMutex_);
+    return isRunning_;
 }
 
-void VibratorThread::WakeUp()
+VibrateInfo VibratorThread::GetCurrentVibrateInfo()
 {
-    MISC_HILOGD("Notify the vibratorThread");
-    cv_.notify_one();
+    std::lock_guard<std::mutex> currentVibrationLock(currentVibrationMutex_);
+    return currentVibration_;
 }
 }  // namespace Sensors
 }  // namespace OHOS
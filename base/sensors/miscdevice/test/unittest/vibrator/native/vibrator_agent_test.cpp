@@ -42,6 +42,8 @@ constexpr int32_t INTENSITY_HIGH = 100;
 constexpr int32_t INTENSITY_MEDIUM = 50;
 constexpr int32_t INTENSITY_LOW = 20;
 constexpr int32_t INTENSITY_INVALID = -1;
+constexpr int32_t KEY_PRESS_NUM = 20;
+constexpr int32_t KEY_PRESS_INTERVAL = 30;
 
 PermissionStateFull g_infoManagerTestState = {
     .grantFlags = {1},
@@ -1253,6 +1255,25 @@ HWTEST_F(VibratorAgentTest, PlayPrimitiveEffect_005, TestSize.Level1)
     }
 }
 
+HWTEST_F(VibratorAgentTest, PlayPrimitiveEffect_006, TestSize.Level1)
+{
+    MISC_HILOGI("PlayPrimitiveEffect_006 in");
+    bool state { false };
+    int32_t ret = IsSupportEffect(VIBRATOR_TYPE_SLIDE, &state);
+    ASSERT_EQ(ret, 0);
+    if (!state) {
+        MISC_HILOGI("Do not support %{public}s", VIBRATOR_TYPE_SLIDE);
+        return;
+    }
+    // Key presses at typing speed, each one preempts the previous effect
+    for (int32_t i = 0; i < KEY_PRESS_NUM; ++i) {
+        ret = PlayPrimitiveEffect(VIBRATOR_TYPE_SLIDE, INTENSITY_MEDIUM);
+        ASSERT_EQ(ret, 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(KEY_PRESS_INTERVAL));
+    }
+    Cancel();
+}
+
 HWTEST_F(VibratorAgentTest, IsHdHapticSupported_001, TestSize.Level1)
 {
     MISC_HILOGI("IsHdHapticSupported_001 in");
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mock_vibrator_hdi_connection.h"
+
+#include <chrono>
+
+#include "sensors_errors.h"
+#include "vibrator_hdi_connection.h"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr int32_t WAIT_CALL_TIMEOUT_MS = 3000;
+}  // namespace
+
+MockVibratorHdi &MockVibratorHdi::GetInstance()
+{
+    static MockVibratorHdi mockVibratorHdi;
+    return mockVibratorHdi;
+}
+
+void MockVibratorHdi::Reset()
+{
+    std::lock_guard<std::mutex> callLock(callMutex_);
+    calls_.clear();
+    isStopHeld_ = false;
+}
+
+void MockVibratorHdi::RecordCall(const std::string &call)
+{
+    {
+        std::lock_guard<std::mutex> callLock(callMutex_);
+        calls_.push_back(call);
+    }
+    callCv_.notify_all();
+}
+
+std::vector<std::string> MockVibratorHdi::GetCalls()
+{
+    std::lock_guard<std::mutex> callLock(callMutex_);
+    return calls_;
+}
+
+bool MockVibratorHdi::WaitCallNum(size_t callNum)
+{
+    std::unique_lock<std::mutex> callLock(callMutex_);
+    return callCv_.wait_for(callLock, std::chrono::milliseconds(WAIT_CALL_TIMEOUT_MS),
+        [this, callNum] { return calls_.size() >= callNum; });
+}
+
+void MockVibratorHdi::HoldStop()
+{
+    std::lock_guard<std::mutex> callLock(callMutex_);
+    isStopHeld_ = true;
+}
+
+void MockVibratorHdi::ReleaseStop()
+{
+    {
+        std::lock_guard<std::mutex> callLock(callMutex_);
+        isStopHeld_ = false;
+    }
+    callCv_.notify_all();
+}
+
+void MockVibratorHdi::WaitStopReleased()
+{
+    std::unique_lock<std::mutex> callLock(callMutex_);
+    // Never blocks the worker for good, even if a failed test does not release it
+    callCv_.wait_for(callLock, std::chrono::milliseconds(WAIT_CALL_TIMEOUT_MS), [this] { return !isStopHeld_; });
+}
+
+std::string StartOnceCall()
+{
+    return "StartOnce";
+}
+
+std::string StartByIntensityCall(const std::string &effect)
+{
+    return "StartByIntensity:" + effect;
+}
+
+std::string StopCall(int32_t mode)
+{
+    return "Stop:" + std::to_string(mode);
+}
+
+int32_t VibratorHdiConnection::ConnectHdi()
+{
+    return ERR_OK;
+}
+
+int32_t VibratorHdiConnection::StartOnce(uint32_t duration)
+{
+    MockVibratorHdi::GetInstance().RecordCall(StartOnceCall());
+    return ERR_OK;
+}
+
+int32_t VibratorHdiConnection::Start(const std::string &effectType)
+{
+    MockVibratorHdi::GetInstance().RecordCall("Start:" + effectType);
+    return ERR_OK;
+}
+
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+int32_t VibratorHdiConnection::EnableCompositeEffect(const HdfCompositeEffect &hdfCompositeEffect)
+{
+    MockVibratorHdi::GetInstance().RecordCall("EnableCompositeEffect");
+    return ERR_OK;
+}
+
+bool VibratorHdiConnection::IsVibratorRunning()
+{
+    return false;
+}
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+
+std::optional<HdfEffectInfo> VibratorHdiConnection::GetEffectInfo(const std::string &effect)
+{
+    return std::nullopt;
+}
+
+int32_t VibratorHdiConnection::Stop(HdfVibratorModeV1_2 mode)
+{
+    MockVibratorHdi::GetInstance().RecordCall(StopCall(static_cast<int32_t>(mode)));
+    MockVibratorHdi::GetInstance().WaitStopReleased();
+    return ERR_OK;
+}
+
+int32_t VibratorHdiConnection::DestroyHdiConnection()
+{
+    return ERR_OK;
+}
+
+int32_t VibratorHdiConnection::GetDelayTime(int32_t mode, int32_t &delayTime)
+{
+    delayTime = 0;
+    return ERR_OK;
+}
+
+int32_t VibratorHdiConnection::GetVibratorCapacity(VibratorCapacity &capacity)
+{
+    return ERR_OK;
+}
+
+int32_t VibratorHdiConnection::PlayPattern(const VibratePattern &pattern)
+{
+    MockVibratorHdi::GetInstance().RecordCall("PlayPattern");
+    return ERR_OK;
+}
+
+int32_t VibratorHdiConnection::StartByIntensity(const std::string &effect, int32_t intensity)
+{
+    MockVibratorHdi::GetInstance().RecordCall(StartByIntensityCall(effect));
+    return ERR_OK;
+}
+
+int32_t VibratorHdiConnection::GetAllWaveInfo(std::vector<HdfWaveInformation> &waveInfos)
+{
+    return ERR_OK;
+}
+}  // namespace Sensors
+}  // namespace OHOS
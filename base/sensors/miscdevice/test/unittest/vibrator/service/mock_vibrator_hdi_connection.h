@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MOCK_VIBRATOR_HDI_CONNECTION_H
+#define MOCK_VIBRATOR_HDI_CONNECTION_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace Sensors {
+// Records the calls made to VibratorHdiConnection, whose methods mock_vibrator_hdi_connection.cpp replaces
+class MockVibratorHdi {
+public:
+    static MockVibratorHdi &GetInstance();
+    void Reset();
+    void RecordCall(const std::string &call);
+    std::vector<std::string> GetCalls();
+    bool WaitCallNum(size_t callNum);
+    // Stop blocks, after recording its call, until ReleaseStop
+    void HoldStop();
+    void ReleaseStop();
+    void WaitStopReleased();
+
+private:
+    MockVibratorHdi() = default;
+    std::mutex callMutex_;
+    std::condition_variable callCv_;
+    std::vector<std::string> calls_;
+    bool isStopHeld_ = false;
+};
+
+std::string StartOnceCall();
+std::string StartByIntensityCall(const std::string &effect);
+std::string StopCall(int32_t mode);
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // MOCK_VIBRATOR_HDI_CONNECTION_H
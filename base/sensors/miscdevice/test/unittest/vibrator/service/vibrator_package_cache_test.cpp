@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "sensors_errors.h"
+#include "vibrator_package_cache.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratorPackageCacheTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t EVENT_NUM = 4;
+constexpr int32_t POINT_NUM = 8;
+constexpr int64_t PACKAGE_LENGTH = 64;
+constexpr time_t MTIME_SECOND = 1000;
+
+VibratePackage MakePackage(int32_t packageDuration)
+{
+    VibratePackage package;
+    package.packageDuration = packageDuration;
+    VibratePattern pattern;
+    pattern.patternDuration = packageDuration;
+    for (int32_t i = 0; i < EVENT_NUM; ++i) {
+        VibrateEvent event;
+        event.tag = EVENT_TAG_CONTINUOUS;
+        event.time = i;
+        event.points.resize(POINT_NUM);
+        pattern.events.push_back(event);
+    }
+    package.patterns.push_back(pattern);
+    return package;
+}
+
+PackageCacheKey MakeKey(int64_t offset)
+{
+    PackageCacheKey key;
+    key.dev = 1;
+    key.ino = 1;
+    key.fileSize = PACKAGE_LENGTH;
+    key.offset = offset;
+    key.length = PACKAGE_LENGTH;
+    return key;
+}
+
+int32_t FindDuration(VibratorPackageCache &cache, const PackageCacheKey &key)
+{
+    auto package = cache.Find(key);
+    return (package == nullptr) ? -1 : package->packageDuration;
+}
+}  // namespace
+
+class VibratorPackageCacheTest : public testing::Test {
+public:
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: VibratorPackageCacheTest_001
+ * @tc.desc: A package is found by its key only, and Clear drops it
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorPackageCacheTest, VibratorPackageCacheTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorPackageCacheTest_001 in");
+    VibratorPackageCache cache;
+    PackageCacheKey key = MakeKey(0);
+    EXPECT_EQ(cache.Find(key), nullptr);
+    cache.Insert(key, MakePackage(1));
+    auto package = cache.Find(key);
+    ASSERT_NE(package, nullptr);
+    EXPECT_EQ(package->packageDuration, 1);
+    ASSERT_EQ(package->patterns.size(), 1U);
+    EXPECT_EQ(package->patterns[0].events.size(), static_cast<size_t>(EVENT_NUM));
+    EXPECT_EQ(cache.Find(MakeKey(PACKAGE_LENGTH)), nullptr);
+    // A package replaced in the cache stays valid for its holder
+    cache.Insert(key, MakePackage(2));
+    EXPECT_EQ(package->packageDuration, 1);
+    EXPECT_EQ(FindDuration(cache, key), 2);
+    cache.Clear();
+    EXPECT_EQ(cache.Find(key), nullptr);
+}
+
+/**
+ * @tc.name: VibratorPackageCacheTest_002
+ * @tc.desc: The least recently used packages are evicted once the budget is exceeded
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorPackageCacheTest, VibratorPackageCacheTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorPackageCacheTest_002 in");
+    size_t packageSize = VibratorPackageCache::EstimateSize(MakePackage(0));
+    VibratorPackageCache cache(packageSize * 2);
+    PackageCacheKey first = MakeKey(0);
+    PackageCacheKey second = MakeKey(PACKAGE_LENGTH);
+    PackageCacheKey third = MakeKey(PACKAGE_LENGTH * 2);
+    cache.Insert(first, MakePackage(1));
+    cache.Insert(second, MakePackage(2));
+    // Using the first package makes the second one the least recently used
+    EXPECT_EQ(FindDuration(cache, first), 1);
+    cache.Insert(third, MakePackage(3));
+    EXPECT_EQ(cache.Find(second), nullptr);
+    EXPECT_EQ(FindDuration(cache, third), 3);
+    EXPECT_EQ(FindDuration(cache, first), 1);
+    cache.Insert(second, MakePackage(2));
+    EXPECT_EQ(cache.Find(third), nullptr);
+    EXPECT_EQ(FindDuration(cache, first), 1);
+    EXPECT_EQ(FindDuration(cache, second), 2);
+}
+
+/**
+ * @tc.name: VibratorPackageCacheTest_003
+ * @tc.desc: A package larger than the budget is not cached and evicts nothing
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorPackageCacheTest, VibratorPackageCacheTest_003, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorPackageCacheTest_003 in");
+    VibratePackage smallPackage = MakePackage(1);
+    smallPackage.patterns.clear();
+    VibratePackage largePackage = MakePackage(2);
+    size_t largeSize = VibratorPackageCache::EstimateSize(largePackage);
+    ASSERT_LT(VibratorPackageCache::EstimateSize(smallPackage), largeSize);
+    VibratorPackageCache cache(largeSize - 1);
+    PackageCacheKey smallKey = MakeKey(0);
+    PackageCacheKey largeKey = MakeKey(PACKAGE_LENGTH);
+    cache.Insert(smallKey, smallPackage);
+    cache.Insert(largeKey, largePackage);
+    EXPECT_EQ(cache.Find(largeKey), nullptr);
+    EXPECT_EQ(FindDuration(cache, smallKey), 1);
+}
+
+/**
+ * @tc.name: VibratorPackageCacheTest_004
+ * @tc.desc: The key of a file changes with its size and with its mtime
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorPackageCacheTest, VibratorPackageCacheTest_004, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorPackageCacheTest_004 in");
+    FILE *file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    RawFileDescriptor rawFd;
+    rawFd.fd = fileno(file);
+    rawFd.offset = 0;
+    rawFd.length = PACKAGE_LENGTH;
+    ASSERT_EQ(ftruncate(rawFd.fd, PACKAGE_LENGTH), 0);
+    struct timespec times[2] = { { MTIME_SECOND, 0 }, { MTIME_SECOND, 0 } };
+    ASSERT_EQ(futimens(rawFd.fd, times), 0);
+    PackageCacheKey key;
+    ASSERT_TRUE(VibratorPackageCache::GetKey(rawFd, key));
+    PackageCacheKey sameKey;
+    ASSERT_TRUE(VibratorPackageCache::GetKey(rawFd, sameKey));
+    EXPECT_TRUE(key == sameKey);
+    VibratorPackageCache cache;
+    cache.Insert(key, MakePackage(1));
+
+    ASSERT_EQ(ftruncate(rawFd.fd, PACKAGE_LENGTH * 2), 0);
+    ASSERT_EQ(futimens(rawFd.fd, times), 0);
+    PackageCacheKey resizedKey;
+    ASSERT_TRUE(VibratorPackageCache::GetKey(rawFd, resizedKey));
+    EXPECT_FALSE(resizedKey == key);
+    EXPECT_EQ(cache.Find(resizedKey), nullptr);
+
+    times[1].tv_nsec = 1;
+    ASSERT_EQ(futimens(rawFd.fd, times), 0);
+    PackageCacheKey touchedKey;
+    ASSERT_TRUE(VibratorPackageCache::GetKey(rawFd, touchedKey));
+    EXPECT_FALSE(touchedKey == resizedKey);
+    EXPECT_EQ(touchedKey.fileSize, resizedKey.fileSize);
+    EXPECT_EQ(cache.Find(touchedKey), nullptr);
+    EXPECT_EQ(FindDuration(cache, key), 1);
+    fclose(file);
+}
+
+/**
+ * @tc.name: VibratorPackageCacheTest_005
+ * @tc.desc: GetKey rejects an invalid fd and fds that are not regular files
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorPackageCacheTest, VibratorPackageCacheTest_005, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorPackageCacheTest_005 in");
+    RawFileDescriptor rawFd;
+    PackageCacheKey key;
+    EXPECT_FALSE(VibratorPackageCache::GetKey(rawFd, key));
+    int32_t pipeFds[2] = { -1, -1 };
+    ASSERT_EQ(pipe(pipeFds), 0);
+    rawFd.fd = pipeFds[0];
+    rawFd.length = PACKAGE_LENGTH;
+    EXPECT_FALSE(VibratorPackageCache::GetKey(rawFd, key));
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+    rawFd.fd = open("/dev/null", O_RDONLY);
+    ASSERT_GE(rawFd.fd, 0);
+    EXPECT_FALSE(VibratorPackageCache::GetKey(rawFd, key));
+    close(rawFd.fd);
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "mock_vibrator_hdi_connection.h"
+#include "sensors_errors.h"
+#include "vibrator_thread.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratorThreadTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+// Longer than any test, so a vibration only ends when it is preempted
+constexpr int32_t LONG_DURATION_MS = 10000;
+constexpr int32_t STOP_CHECK_MS = 50;
+
+VibrateInfo GetTimeInfo()
+{
+    VibrateInfo info;
+    info.mode = VIBRATE_TIME;
+    info.packageName = "vibratorThreadTest";
+    info.duration = LONG_DURATION_MS;
+    return info;
+}
+
+VibrateInfo GetPresetInfo(const std::string &effect)
+{
+    VibrateInfo info;
+    info.mode = VIBRATE_PRESET;
+    info.packageName = "vibratorThreadTest";
+    info.duration = LONG_DURATION_MS;
+    info.effect = effect;
+    info.count = 1;
+    return info;
+}
+}  // namespace
+
+class VibratorThreadTest : public testing::Test {
+public:
+    void SetUp();
+    void TearDown();
+};
+
+void VibratorThreadTest::SetUp()
+{
+    MockVibratorHdi::GetInstance().Reset();
+}
+
+void VibratorThreadTest::TearDown()
+{
+    MockVibratorHdi::GetInstance().ReleaseStop();
+}
+
+/**
+ * @tc.name: VibratorThreadTest_001
+ * @tc.desc: Only the newest of the commands submitted while the worker is busy is played
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorThreadTest, VibratorThreadTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorThreadTest_001 in");
+    auto &mockHdi = MockVibratorHdi::GetInstance();
+    VibratorThread vibratorThread;
+    vibratorThread.Submit(GetTimeInfo());
+    ASSERT_TRUE(mockHdi.WaitCallNum(1));
+    // The worker stops the once vibration for the preset one, and is held in Stop meanwhile
+    mockHdi.HoldStop();
+    vibratorThread.Submit(GetPresetInfo("first"));
+    ASSERT_TRUE(mockHdi.WaitCallNum(2));
+    vibratorThread.Submit(GetPresetInfo("second"));
+    EXPECT_EQ(vibratorThread.GetCurrentVibrateInfo().effect, "second");
+    mockHdi.ReleaseStop();
+    ASSERT_TRUE(mockHdi.WaitCallNum(3));
+    std::vector<std::string> expected = { StartOnceCall(), StopCall(HDF_VIBRATOR_MODE_ONCE),
+        StartByIntensityCall("second") };
+    EXPECT_EQ(mockHdi.GetCalls(), expected);
+    EXPECT_TRUE(vibratorThread.IsRunning());
+}
+
+/**
+ * @tc.name: VibratorThreadTest_002
+ * @tc.desc: A command preempting a vibration of the same mode restarts the device without stopping it
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorThreadTest, VibratorThreadTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorThreadTest_002 in");
+    auto &mockHdi = MockVibratorHdi::GetInstance();
+    VibratorThread vibratorThread;
+    vibratorThread.Submit(GetTimeInfo());
+    ASSERT_TRUE(mockHdi.WaitCallNum(1));
+    vibratorThread.Submit(GetTimeInfo());
+    ASSERT_TRUE(mockHdi.WaitCallNum(2));
+    vibratorThread.Submit(GetPresetInfo("first"));
+    ASSERT_TRUE(mockHdi.WaitCallNum(4));
+    vibratorThread.Submit(GetPresetInfo("second"));
+    ASSERT_TRUE(mockHdi.WaitCallNum(5));
+    std::vector<std::string> expected = { StartOnceCall(), StartOnceCall(), StopCall(HDF_VIBRATOR_MODE_ONCE),
+        StartByIntensityCall("first"), StartByIntensityCall("second") };
+    EXPECT_EQ(mockHdi.GetCalls(), expected);
+    vibratorThread.Stop();
+    expected.push_back(StopCall(HDF_VIBRATOR_MODE_PRESET));
+    EXPECT_EQ(mockHdi.GetCalls(), expected);
+}
+
+/**
+ * @tc.name: VibratorThreadTest_003
+ * @tc.desc: Stop returns only once the device has been stopped
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorThreadTest, VibratorThreadTest_003, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorThreadTest_003 in");
+    auto &mockHdi = MockVibratorHdi::GetInstance();
+    VibratorThread vibratorThread;
+    vibratorThread.Submit(GetTimeInfo());
+    ASSERT_TRUE(mockHdi.WaitCallNum(1));
+    mockHdi.HoldStop();
+    std::atomic_bool isStopReturned = false;
+    std::thread stopThread([&vibratorThread, &isStopReturned] {
+        vibratorThread.Stop();
+        isStopReturned = true;
+    });
+    ASSERT_TRUE(mockHdi.WaitCallNum(2));
+    EXPECT_FALSE(vibratorThread.IsRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(STOP_CHECK_MS));
+    EXPECT_FALSE(isStopReturned.load());
+    mockHdi.ReleaseStop();
+    stopThread.join();
+    EXPECT_TRUE(isStopReturned.load());
+    std::vector<std::string> expected = { StartOnceCall(), StopCall(HDF_VIBRATOR_MODE_ONCE) };
+    EXPECT_EQ(mockHdi.GetCalls(), expected);
+    // Stopping an idle thread neither touches the device nor blocks
+    vibratorThread.Stop();
+    EXPECT_EQ(mockHdi.GetCalls(), expected);
+}
+}  // namespace Sensors
+}  // namespace OHOS
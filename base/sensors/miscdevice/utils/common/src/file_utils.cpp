@@ -194,26 +194,20 @@ std::string ReadFd(const RawFileDescriptor &rawFd)
         MISC_HILOGE("length is invalid, length:%{public}" PRId64, rawFd.length);
         return {};
     }
-    FILE *fp = fdopen(rawFd.fd, "r");
-    CHKPS(fp);
-    if (fseek(fp, rawFd.offset, SEEK_SET) != 0) {
-        MISC_HILOGE("fseek failed, errno:%{public}d", errno);
-        if (fclose(fp) != 0) {
-            MISC_HILOGW("Close file failed, errno:%{public}d", errno);
-        }
-        return {};
-    }
-    std::string dataStr;
-    char buf[READ_DATA_BUFF_SIZE] = { '\0' };
+    // A single positioned read, the fd offset is left untouched and the fd stays open for its owner
+    std::string dataStr(static_cast<size_t>(rawFd.length), '\0');
     int64_t alreadyRead = 0;
     while (alreadyRead < rawFd.length) {
-        int64_t onceRead = std::min(rawFd.length - alreadyRead, READ_DATA_BUFF_SIZE - 1);
-        fgets(buf, onceRead + 1, fp);
-        dataStr += buf;
-        alreadyRead = ftell(fp) - rawFd.offset;
-    }
-    if (fclose(fp) != 0) {
-        MISC_HILOGW("Close file failed, errno:%{public}d", errno);
+        ssize_t onceRead = pread(rawFd.fd, &dataStr[alreadyRead], rawFd.length - alreadyRead,
+            rawFd.offset + alreadyRead);
+        if (onceRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (onceRead <= 0) {
+            MISC_HILOGE("pread failed, errno:%{public}d", errno);
+            return {};
+        }
+        alreadyRead += onceRead;
     }
     return dataStr;
 }
@@ -14,6 +14,8 @@
  */
 #ifndef ASYNC_CALLBACK_INFO_H
 #define ASYNC_CALLBACK_INFO_H
+#include <mutex>
+
 #include <uv.h>
 
 #include "napi/native_api.h"
@@ -35,6 +37,7 @@ using namespace OHOS::HiviewDFX;
 constexpr int32_t THREE_DIMENSIONAL_MATRIX_LENGTH = 9;
 constexpr static int32_t DATA_LENGTH = 16;
 constexpr int32_t CALLBACK_NUM = 3;
+constexpr uint32_t MAX_BATCH_SIZE = 64;
 enum CallbackDataType {
     SUBSCRIBE_FAIL = -2,
     FAIL = -1,
@@ -110,6 +113,13 @@ public:
     BusinessError error;
     CallbackDataType type;
     vector<SensorInfo> sensorInfos;
+    // Samples handed from the sensor thread to the JS thread, guarded by mailboxMutex
+    std::mutex mailboxMutex;
+    vector<CallbackSensorData> mailbox;
+    // A uv work item that drains the mailbox is queued
+    bool isPosted = false;
+    // Samples delivered per call as a Float32Array, 0 delivers only the latest sample as an object
+    uint32_t batchSize = 0;
     AsyncCallbackInfo(napi_env env, CallbackDataType type) : env(env), type(type) {}
     ~AsyncCallbackInfo()
     {
@@ -41,7 +41,8 @@ bool GetNativeFloat(const napi_env &env, const napi_value &value, float &number)
 napi_value GetNapiInt32(const napi_env &env, int32_t number);
 bool GetStringValue(const napi_env &env, const napi_value &value, string &result);
 void EmitAsyncCallbackWork(sptr<AsyncCallbackInfo> asyncCallbackInfo);
-void EmitUvEventLoop(sptr<AsyncCallbackInfo> asyncCallbackInfo);
+bool EmitUvEventLoop(sptr<AsyncCallbackInfo> asyncCallbackInfo);
+void PostSensorData(sptr<AsyncCallbackInfo> asyncCallbackInfo, const CallbackSensorData &sensorData);
 void EmitPromiseWork(sptr<AsyncCallbackInfo> asyncCallbackInfo);
 bool ConvertToFailData(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallbackInfo, napi_value result[2]);
 bool ConvertToGeomagneticData(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallbackInfo, napi_value result[2]);
@@ -49,6 +50,7 @@ bool ConvertToNumber(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallbackI
 bool ConvertToArray(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallbackInfo, napi_value result[2]);
 bool ConvertToRotationMatrix(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallbackInfo, napi_value result[2]);
 bool ConvertToSensorData(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallbackInfo, napi_value result[2]);
+bool ConvertToSensorBatch(const napi_env &env, const vector<CallbackSensorData> &samples, napi_value result[2]);
 bool CreateNapiArray(const napi_env &env, float *data, int32_t dataLength, napi_value &result);
 bool ConvertToSensorInfos(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallbackInfo, napi_value result[2]);
 bool ConvertToSingleSensor(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallbackInfo, napi_value result[2]);
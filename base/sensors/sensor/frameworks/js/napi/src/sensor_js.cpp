@@ -14,6 +14,7 @@
  */
 #include "sensor_js.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdlib>
 #include <map>
@@ -64,30 +65,28 @@ static bool CheckSubscribe(int32_t sensorTypeId)
     return iter != g_onCallbackInfos.end();
 }
 
-static bool copySensorData(sptr<AsyncCallbackInfo> callbackInfo, SensorEvent *event)
+static bool CopySensorData(CallbackDataType type, SensorEvent *event, CallbackSensorData &sensorData)
 {
-    CHKPF(callbackInfo);
     CHKPF(event);
     int32_t sensorTypeId = event->sensorTypeId;
-    callbackInfo->data.sensorData.sensorTypeId = sensorTypeId;
-    callbackInfo->data.sensorData.dataLength = event->dataLen;
-    callbackInfo->data.sensorData.timestamp = event->timestamp;
-    callbackInfo->data.sensorData.sensorAccuracy = event->option;
+    sensorData.sensorTypeId = sensorTypeId;
+    sensorData.dataLength = event->dataLen;
+    sensorData.timestamp = event->timestamp;
+    sensorData.sensorAccuracy = event->option;
     CHKPF(event->data);
     if (event->dataLen < sizeof(float)) {
         SEN_HILOGE("Event dataLen less than float size.");
         return false;
     }
     auto data = reinterpret_cast<float *>(event->data);
-    if (sensorTypeId == SENSOR_TYPE_ID_WEAR_DETECTION && callbackInfo->type == SUBSCRIBE_CALLBACK) {
+    if (sensorTypeId == SENSOR_TYPE_ID_WEAR_DETECTION && type == SUBSCRIBE_CALLBACK) {
         std::lock_guard<std::mutex> onBodyLock(bodyMutex_);
         g_bodyState = *data;
-        callbackInfo->data.sensorData.data[0] =
+        sensorData.data[0] =
             (fabs(g_bodyState - BODY_STATE_EXCEPT) < THRESHOLD) ? true : false;
         return true;
     }
-    if (memcpy_s(callbackInfo->data.sensorData.data, sizeof(callbackInfo->data.sensorData.data),
-        data, event->dataLen) != EOK) {
+    if (memcpy_s(sensorData.data, sizeof(sensorData.data), data, event->dataLen) != EOK) {
         SEN_HILOGE("Copy data failed");
         return false;
     }
@@ -111,14 +110,18 @@ static void EmitSubscribeCallback(SensorEvent *event)
     if (!CheckSystemSubscribe(sensorTypeId)) {
         return;
     }
+    CallbackSensorData sensorData = {};
+    if (!CopySensorData(SUBSCRIBE_CALLBACK, event, sensorData)) {
+        SEN_HILOGE("Copy sensor data failed");
+        return;
+    }
     std::lock_guard<std::mutex> subscribeLock(mutex_);
-    auto callbacks = g_subscribeCallbacks[sensorTypeId];
-    for (auto &callback : callbacks) {
-        if (!copySensorData(callback, event)) {
-            SEN_HILOGE("Copy sensor data failed");
-            continue;
-        }
-        EmitUvEventLoop(callback);
+    auto iter = g_subscribeCallbacks.find(sensorTypeId);
+    if (iter == g_subscribeCallbacks.end()) {
+        return;
+    }
+    for (const auto &callback : iter->second) {
+        PostSensorData(callback, sensorData);
     }
 }
 
@@ -129,14 +132,18 @@ static void EmitOnCallback(SensorEvent *event)
     if (!CheckSubscribe(sensorTypeId)) {
         return;
     }
+    CallbackSensorData sensorData = {};
+    if (!CopySensorData(ON_CALLBACK, event, sensorData)) {
+        SEN_HILOGE("Copy sensor data failed");
+        return;
+    }
     std::lock_guard<std::mutex> onCallbackLock(onMutex_);
-    auto onCallbackInfos = g_onCallbackInfos[sensorTypeId];
-    for (auto &onCallbackInfo : onCallbackInfos) {
-        if (!copySensorData(onCallbackInfo, event)) {
-            SEN_HILOGE("Copy sensor data failed");
-            continue;
-        }
-        EmitUvEventLoop(onCallbackInfo);
+    auto iter = g_onCallbackInfos.find(sensorTypeId);
+    if (iter == g_onCallbackInfos.end()) {
+        return;
+    }
+    for (const auto &onCallbackInfo : iter->second) {
+        PostSensorData(onCallbackInfo, sensorData);
     }
 }
 
@@ -154,7 +161,8 @@ static void EmitOnceCallback(SensorEvent *event)
         auto onceCallbackInfo = onceCallbackInfos.front();
         auto beginIter = onceCallbackInfos.begin();
         onceCallbackInfos.erase(beginIter);
-        if (!copySensorData(onceCallbackInfo, event)) {
+        CHKPC(onceCallbackInfo);
+        if (!CopySensorData(ONCE_CALLBACK, event, onceCallbackInfo->data.sensorData)) {
             SEN_HILOGE("Copy sensor data failed");
             continue;
         }
@@ -301,13 +309,14 @@ static bool IsSubscribed(napi_env env, int32_t sensorTypeId, napi_value callback
     return false;
 }
 
-static void UpdateCallbackInfos(napi_env env, int32_t sensorTypeId, napi_value callback)
+static void UpdateCallbackInfos(napi_env env, int32_t sensorTypeId, napi_value callback, uint32_t batchSize)
 {
     CALL_LOG_ENTER;
     std::lock_guard<std::mutex> onCallbackLock(onMutex_);
     CHKCV((!IsSubscribed(env, sensorTypeId, callback)), "The callback has been subscribed");
     sptr<AsyncCallbackInfo> asyncCallbackInfo = new (std::nothrow) AsyncCallbackInfo(env, ON_CALLBACK);
     CHKPV(asyncCallbackInfo);
+    asyncCallbackInfo->batchSize = batchSize;
     napi_status status = napi_create_reference(env, callback, 1, &asyncCallbackInfo->callback[0]);
     if (status != napi_ok) {
         ThrowErr(env, PARAMETER_ERROR, "napi_create_reference fail");
@@ -346,6 +355,21 @@ static bool GetInterval(napi_env env, napi_value value, int64_t &interval)
     return true;
 }
 
+static bool GetBatchSize(napi_env env, napi_value value, uint32_t &batchSize)
+{
+    napi_value napiBatchSize = GetNamedProperty(env, value, "batchSize");
+    if (!IsMatchType(env, napiBatchSize, napi_number)) {
+        return true;
+    }
+    int32_t number = 0;
+    if (!GetNativeInt32(env, napiBatchSize, number) || number < 0) {
+        SEN_HILOGE("Invalid batchSize");
+        return false;
+    }
+    batchSize = std::min(static_cast<uint32_t>(number), MAX_BATCH_SIZE);
+    return true;
+}
+
 static napi_value On(napi_env env, napi_callback_info info)
 {
     CALL_LOG_ENTER;
@@ -367,10 +391,14 @@ static napi_value On(napi_env env, napi_callback_info info)
         return nullptr;
     }
     int64_t interval = REPORTING_INTERVAL;
+    uint32_t batchSize = 0;
     if (argc >= 3 && IsMatchType(env, args[2], napi_object)) {
         if (!GetInterval(env, args[2], interval)) {
             SEN_HILOGW("Get interval failed");
         }
+        if (!GetBatchSize(env, args[2], batchSize)) {
+            SEN_HILOGW("Get batchSize failed");
+        }
     }
     SEN_HILOGD("Interval is %{public}" PRId64, interval);
     int32_t ret = SubscribeSensor(sensorTypeId, interval, DataCallbackImpl);
@@ -378,7 +406,7 @@ static napi_value On(napi_env env, napi_callback_info info)
         ThrowErr(env, ret, "SubscribeSensor fail");
         return nullptr;
     }
-    UpdateCallbackInfos(env, sensorTypeId, args[1]);
+    UpdateCallbackInfos(env, sensorTypeId, args[1], batchSize);
     return nullptr;
 }
 
@@ -15,6 +15,7 @@
 
 #include "sensor_napi_utils.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "bundle_mgr_proxy.h"
 #include "ipc_skeleton.h"
 #include "iservice_registry.h"
+#include "securec.h"
 #include "system_ability_definition.h"
 
 #include "sensor_napi_error.h"
@@ -349,6 +351,48 @@ bool ConvertToSensorData(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallb
     return true;
 }
 
+bool ConvertToSensorBatch(const napi_env &env, const vector<CallbackSensorData> &samples, napi_value result[2])
+{
+    CHKNCF(env, !samples.empty(), "Empty sensor batch");
+    int32_t sensorTypeId = samples.back().sensorTypeId;
+    CHKNCF(env, (g_sensorAttributeList.find(sensorTypeId) != g_sensorAttributeList.end()), "Invalid sensor type");
+    size_t dimension = g_sensorAttributeList[sensorTypeId].size();
+    size_t sampleNum = samples.size();
+    void *buffer = nullptr;
+    napi_value arrayBuffer = nullptr;
+    CHKNRF(env, napi_create_arraybuffer(env, sampleNum * dimension * sizeof(float), &buffer, &arrayBuffer),
+        "napi_create_arraybuffer");
+    CHKPF(buffer);
+    napi_value timestamps = nullptr;
+    CHKNRF(env, napi_create_array_with_length(env, sampleNum, &timestamps), "napi_create_array_with_length");
+    // Samples are laid out one after another, dimension values each, in the order of g_sensorAttributeList
+    auto values = static_cast<float *>(buffer);
+    for (size_t i = 0; i < sampleNum; ++i) {
+        CHKNCF(env, (samples[i].dataLength / sizeof(float) >= dimension), "Data length mismatch");
+        if (memcpy_s(values + i * dimension, (sampleNum - i) * dimension * sizeof(float),
+            samples[i].data, dimension * sizeof(float)) != EOK) {
+            SEN_HILOGE("Copy batch data failed");
+            return false;
+        }
+        napi_value timestamp = nullptr;
+        CHKNRF(env, napi_create_int64(env, samples[i].timestamp, &timestamp), "napi_create_int64");
+        CHKNRF(env, napi_set_element(env, timestamps, i, timestamp), "napi_set_element");
+    }
+    napi_value data = nullptr;
+    CHKNRF(env, napi_create_typedarray(env, napi_float32_array, sampleNum * dimension, arrayBuffer, 0, &data),
+        "napi_create_typedarray");
+    CHKNRF(env, napi_create_object(env, &result[1]), "napi_create_object");
+    CHKNRF(env, napi_set_named_property(env, result[1], "data", data), "napi_set_named_property");
+    CHKNRF(env, napi_set_named_property(env, result[1], "timestamps", timestamps), "napi_set_named_property");
+    napi_value message = nullptr;
+    CHKNRF(env, napi_create_uint32(env, dimension, &message), "napi_create_uint32");
+    CHKNRF(env, napi_set_named_property(env, result[1], "dimension", message), "napi_set_named_property");
+    message = nullptr;
+    CHKNRF(env, napi_create_int32(env, samples.back().sensorAccuracy, &message), "napi_create_int32");
+    CHKNRF(env, napi_set_named_property(env, result[1], "accuracy", message), "napi_set_named_property");
+    return true;
+}
+
 bool ConvertToGeomagneticData(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallbackInfo, napi_value result[2])
 {
     CALL_LOG_ENTER;
@@ -504,19 +548,98 @@ void DeleteWork(uv_work_t *work)
     work = nullptr;
 }
 
-void EmitUvEventLoop(sptr<AsyncCallbackInfo> asyncCallbackInfo)
+static bool IsMailboxCallback(sptr<AsyncCallbackInfo> asyncCallbackInfo)
+{
+    return (asyncCallbackInfo->type == ON_CALLBACK) || (asyncCallbackInfo->type == SUBSCRIBE_CALLBACK);
+}
+
+// ConvertMailboxData clears isPosted when it takes the mailbox. A work ending on an error before that
+// clears it here instead, so that it does not block the later samples.
+class PostedGuard {
+public:
+    explicit PostedGuard(sptr<AsyncCallbackInfo> asyncCallbackInfo) : asyncCallbackInfo_(asyncCallbackInfo) {}
+    ~PostedGuard()
+    {
+        if (isMailboxTaken_) {
+            return;
+        }
+        std::lock_guard<std::mutex> mailboxLock(asyncCallbackInfo_->mailboxMutex);
+        asyncCallbackInfo_->isPosted = false;
+    }
+    void SetMailboxTaken()
+    {
+        isMailboxTaken_ = true;
+    }
+
+private:
+    sptr<AsyncCallbackInfo> asyncCallbackInfo_;
+    bool isMailboxTaken_ = false;
+};
+
+static bool ConvertMailboxData(const napi_env &env, sptr<AsyncCallbackInfo> asyncCallbackInfo, napi_value result[2])
+{
+    vector<CallbackSensorData> samples;
+    {
+        std::lock_guard<std::mutex> mailboxLock(asyncCallbackInfo->mailboxMutex);
+        asyncCallbackInfo->isPosted = false;
+        if (asyncCallbackInfo->mailbox.empty()) {
+            return false;
+        }
+        if (asyncCallbackInfo->batchSize == 0) {
+            // Only the JS thread touches data of a mailbox callback, no race with the sensor thread
+            asyncCallbackInfo->data.sensorData = asyncCallbackInfo->mailbox.back();
+            asyncCallbackInfo->mailbox.clear();
+        } else {
+            samples.swap(asyncCallbackInfo->mailbox);
+        }
+    }
+    if (samples.empty()) {
+        return ConvertToSensorData(env, asyncCallbackInfo, result);
+    }
+    return ConvertToSensorBatch(env, samples, result);
+}
+
+void PostSensorData(sptr<AsyncCallbackInfo> asyncCallbackInfo, const CallbackSensorData &sensorData)
 {
     CHKPV(asyncCallbackInfo);
+    {
+        std::lock_guard<std::mutex> mailboxLock(asyncCallbackInfo->mailboxMutex);
+        auto &mailbox = asyncCallbackInfo->mailbox;
+        size_t capacity = std::max(asyncCallbackInfo->batchSize, 1U);
+        if (asyncCallbackInfo->batchSize == 0 && !mailbox.empty()) {
+            // A JS thread falling behind gets the latest sample instead of a backlog of stale ones
+            mailbox.back() = sensorData;
+        } else {
+            if (mailbox.size() >= capacity) {
+                mailbox.erase(mailbox.begin());
+            }
+            mailbox.push_back(sensorData);
+        }
+        if (asyncCallbackInfo->isPosted || mailbox.size() < capacity) {
+            return;
+        }
+        asyncCallbackInfo->isPosted = true;
+    }
+    if (!EmitUvEventLoop(asyncCallbackInfo)) {
+        std::lock_guard<std::mutex> mailboxLock(asyncCallbackInfo->mailboxMutex);
+        asyncCallbackInfo->isPosted = false;
+    }
+}
+
+bool EmitUvEventLoop(sptr<AsyncCallbackInfo> asyncCallbackInfo)
+{
+    CHKPF(asyncCallbackInfo);
     uv_loop_s *loop(nullptr);
-    CHKCV((napi_get_uv_event_loop(asyncCallbackInfo->env, &loop) == napi_ok), "napi_get_uv_event_loop fail");
-    CHKPV(loop);
+    CHKCF((napi_get_uv_event_loop(asyncCallbackInfo->env, &loop) == napi_ok), "napi_get_uv_event_loop fail");
+    CHKPF(loop);
     uv_work_t *work = new(std::nothrow) uv_work_t;
-    CHKPV(work);
+    CHKPF(work);
     asyncCallbackInfo->IncStrongRef(nullptr);
     work->data = asyncCallbackInfo.GetRefPtr();
     int32_t ret = uv_queue_work_with_qos(loop, work, [] (uv_work_t *work) { }, [] (uv_work_t *work, int status) {
         CHKPV(work);
         sptr<AsyncCallbackInfo> asyncCallbackInfo(static_cast<AsyncCallbackInfo *>(work->data));
+        PostedGuard postedGuard(asyncCallbackInfo);
         DeleteWork(work);
         /**
          * After the asynchronous task is created, the asyncCallbackInfo reference count is reduced
@@ -544,14 +667,24 @@ void EmitUvEventLoop(sptr<AsyncCallbackInfo> asyncCallbackInfo)
         }
         napi_value callResult = nullptr;
         napi_value result[2] = {0};
-        if (!(g_convertfuncList.find(asyncCallbackInfo->type) != g_convertfuncList.end())) {
-            SEN_HILOGE("asyncCallbackInfo type is invalid");
-            napi_throw_error(env, nullptr, "asyncCallbackInfo type is invalid");
-            ReleaseCallback(asyncCallbackInfo);
-            napi_close_handle_scope(asyncCallbackInfo->env, scope);
-            return;
+        if (IsMailboxCallback(asyncCallbackInfo)) {
+            bool isConverted = ConvertMailboxData(env, asyncCallbackInfo, result);
+            postedGuard.SetMailboxTaken();
+            if (!isConverted) {
+                SEN_HILOGD("No sensor data in mailbox");
+                napi_close_handle_scope(asyncCallbackInfo->env, scope);
+                return;
+            }
+        } else {
+            if (!(g_convertfuncList.find(asyncCallbackInfo->type) != g_convertfuncList.end())) {
+                SEN_HILOGE("asyncCallbackInfo type is invalid");
+                napi_throw_error(env, nullptr, "asyncCallbackInfo type is invalid");
+                ReleaseCallback(asyncCallbackInfo);
+                napi_close_handle_scope(asyncCallbackInfo->env, scope);
+                return;
+            }
+            g_convertfuncList[asyncCallbackInfo->type](env, asyncCallbackInfo, result);
         }
-        g_convertfuncList[asyncCallbackInfo->type](env, asyncCallbackInfo, result);
         if (napi_call_function(env, nullptr, callback, 1, &result[1], &callResult) != napi_ok) {
             SEN_HILOGE("napi_call_function callback fail");
             napi_throw_error(env, nullptr, "napi_call_function callback fail");
@@ -566,7 +699,9 @@ void EmitUvEventLoop(sptr<AsyncCallbackInfo> asyncCallbackInfo)
         SEN_HILOGE("uv_queue_work_with_qos fail");
         asyncCallbackInfo->DecStrongRef(nullptr);
         DeleteWork(work);
+        return false;
     }
+    return true;
 }
 
 void EmitPromiseWork(sptr<AsyncCallbackInfo> asyncCallbackInfo)
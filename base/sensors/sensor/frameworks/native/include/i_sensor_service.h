@@ -25,6 +25,7 @@
 #include "i_sensor_client.h"
 #include "sensor_basic_data_channel.h"
 #include "sensor.h"
+#include "sensor_data_event.h"
 #include "sensors_ipc_interface_code.h"
 
 namespace OHOS {
@@ -49,6 +50,7 @@ public:
     virtual ErrCode EnableActiveInfoCB() = 0;
     virtual ErrCode DisableActiveInfoCB() = 0;
     virtual ErrCode ResetSensors() = 0;
+    virtual ErrCode GetLatestData(int32_t sensorId, SensorData &data) = 0;
 };
 }  // namespace Sensors
 }  // namespace OHOS
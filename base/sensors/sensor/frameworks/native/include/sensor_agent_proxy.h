@@ -18,8 +18,11 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
 #include <set>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 #include "refbase.h"
 #include "singleton.h"
 
@@ -31,6 +34,12 @@ namespace Sensors {
 struct SensorNativeData;
 struct SensorIdList;
 typedef int32_t (*SensorDataCallback)(struct SensorNativeData *events, uint32_t num);
+struct SubscriberSnapshot {
+    std::vector<RecordSensorCallback> callbacks;
+    std::vector<RecordSensorBatchCallback> batchCallbacks;
+};
+// sensorId -> callbacks of the active subscribers
+using SubscriberSnapshotMap = std::unordered_map<int32_t, SubscriberSnapshot>;
 
 class SensorAgentProxy {
     DECLARE_DELAYED_SINGLETON(SensorAgentProxy);
@@ -41,6 +50,7 @@ public:
     int32_t SubscribeSensor(int32_t sensorId, const SensorUser *user);
     int32_t UnsubscribeSensor(int32_t sensorId, const SensorUser *user);
     int32_t SetMode(int32_t sensorId, const SensorUser *user, int32_t mode);
+    int32_t SetBatchCallback(int32_t sensorId, const SensorUser *user, RecordSensorBatchCallback batchCallback);
     int32_t SetOption(int32_t sensorId, const SensorUser *user, int32_t option);
     void SetIsChannelCreated(bool isChannelCreated);
     int32_t GetAllSensors(SensorInfo **sensorInfo, int32_t *count) const;
@@ -51,13 +61,15 @@ public:
     int32_t Unregister(SensorActiveInfoCB callback);
     void HandleSensorData(SensorEvent *events, int32_t num, void *data);
     int32_t ResetSensors() const;
+    int32_t GetLatestData(int32_t sensorId, SensorEvent *event) const;
 
 private:
     int32_t CreateSensorDataChannel();
     int32_t DestroySensorDataChannel();
     int32_t ConvertSensorInfos() const;
     void ClearSensorInfos() const;
-    std::set<RecordSensorCallback> GetSubscribeUserCallback(int32_t sensorId);
+    void UpdateSubscriberSnapshot();
+    void EraseBatchCallback(int32_t sensorId, const SensorUser *user);
     static std::recursive_mutex subscribeMutex_;
     static std::mutex chanelMutex_;
     OHOS::sptr<OHOS::Sensors::SensorDataChannel> dataChannel_ = nullptr;
@@ -66,6 +78,9 @@ private:
     int64_t reportInterval_ = -1;
     std::map<int32_t, std::set<const SensorUser *>> subscribeMap_;
     std::map<int32_t, std::set<const SensorUser *>> unsubscribeMap_;
+    std::map<int32_t, std::map<const SensorUser *, RecordSensorBatchCallback>> batchCallbackMap_;
+    // Rebuilt under subscribeMutex_ whenever subscribeMap_ changes, read lock-free when dispatching events
+    std::shared_ptr<const SubscriberSnapshotMap> subscriberSnapshot_ = std::make_shared<const SubscriberSnapshotMap>();
 };
 
 #define SENSOR_AGENT_IMPL OHOS::DelayedSingleton<SensorAgentProxy>::GetInstance()
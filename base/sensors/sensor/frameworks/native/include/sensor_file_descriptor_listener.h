@@ -17,6 +17,7 @@
 #define SENSOR_FILE_DESCRIPTOR_LISTENER_H
 
 #include <cstdint>
+#include <memory>
 
 #include "file_descriptor_listener.h"
 #include "sensor_data_channel.h"
@@ -33,8 +34,12 @@ public:
     void SetChannel(SensorDataChannel *channel);
 
 private:
+    void ReadSharedRing(int32_t fileDescriptor, const std::shared_ptr<SensorSharedRing> &sharedRing);
+    void DispatchEvents(const SensorData *data, int32_t num);
+    void ReleaseBuff();
     SensorDataChannel *channel_ = nullptr;
     SensorData *receiveDataBuff_ = nullptr;
+    SensorEvent *eventBuff_ = nullptr;
 };
 }  // namespace Sensors
 }  // namespace OHOS
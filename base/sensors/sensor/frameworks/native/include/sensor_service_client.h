@@ -51,6 +51,7 @@ public:
     int32_t Register(SensorActiveInfoCB callback, sptr<SensorDataChannel> sensorDataChannel);
     int32_t Unregister(SensorActiveInfoCB callback);
     int32_t ResetSensors();
+    int32_t GetLatestData(int32_t sensorId, SensorData &data);
     void ReceiveMessage(const char *buf, size_t size);
     void Disconnect();
     void HandleNetPacke(NetPacket &pkt);
@@ -43,6 +43,7 @@ public:
     ErrCode EnableActiveInfoCB() override;
     ErrCode DisableActiveInfoCB() override;
     ErrCode ResetSensors() override;
+    ErrCode GetLatestData(int32_t sensorId, SensorData &data) override;
 
 private:
     DISALLOW_COPY_AND_MOVE(SensorServiceProxy);
@@ -33,6 +33,7 @@ enum class SensorInterfaceCode {
     ENABLE_ACTIVE_INFO_CB,
     DISABLE_ACTIVE_INFO_CB,
     RESET_SENSORS,
+    GET_LATEST_DATA,
 };
 }  // namespace Sensors
 }  // namespace OHOS
@@ -109,6 +109,16 @@ int32_t SetMode(int32_t sensorId, const SensorUser *user, int32_t mode)
     return SENSOR_AGENT_IMPL->SetMode(sensorId, user, mode);
 }
 
+int32_t SetBatchCallback(int32_t sensorId, const SensorUser *user, RecordSensorBatchCallback batchCallback)
+{
+    int32_t ret = SENSOR_AGENT_IMPL->SetBatchCallback(sensorId, user, batchCallback);
+    if (ret != OHOS::ERR_OK) {
+        SEN_HILOGE("SetBatchCallback failed");
+        return NormalizeErrCode(ret);
+    }
+    return ret;
+}
+
 int32_t SuspendSensors(int32_t pid)
 {
     int32_t ret = SENSOR_AGENT_IMPL->SuspendSensors(pid);
@@ -169,4 +179,14 @@ int32_t ResetSensors()
         return NormalizeErrCode(ret);
     }
     return ret;
+}
+
+int32_t GetLatestSensorData(int32_t sensorId, SensorEvent *event)
+{
+    int32_t ret = SENSOR_AGENT_IMPL->GetLatestData(sensorId, event);
+    if (ret != OHOS::ERR_OK) {
+        SEN_HILOGE("Get latest sensor data failed, ret:%{public}d", ret);
+        return NormalizeErrCode(ret);
+    }
+    return ret;
 }
\ No newline at end of file
@@ -49,22 +49,28 @@ SensorAgentProxy::~SensorAgentProxy()
     ClearSensorInfos();
 }
 
-std::set<RecordSensorCallback> SensorAgentProxy::GetSubscribeUserCallback(int32_t sensorId)
+void SensorAgentProxy::UpdateSubscriberSnapshot()
 {
-    std::lock_guard<std::recursive_mutex> subscribeLock(subscribeMutex_);
-    auto iter = subscribeMap_.find(sensorId);
-    if (iter == subscribeMap_.end()) {
-        SEN_HILOGE("Sensor is not subscribed");
-        return {};
-    }
-    std::set<RecordSensorCallback> callback;
-    for (const auto &it : iter->second) {
-        auto ret = callback.insert(it->callback);
-        if (!ret.second) {
-            SEN_HILOGE("callback insert fail");
+    auto snapshot = std::make_shared<SubscriberSnapshotMap>();
+    for (const auto &subscribeIt : subscribeMap_) {
+        std::set<RecordSensorCallback> callbacks;
+        std::set<RecordSensorBatchCallback> batchCallbacks;
+        auto batchIt = batchCallbackMap_.find(subscribeIt.first);
+        for (const auto &user : subscribeIt.second) {
+            if (batchIt != batchCallbackMap_.end()) {
+                auto userIt = batchIt->second.find(user);
+                if (userIt != batchIt->second.end()) {
+                    batchCallbacks.insert(userIt->second);
+                    continue;
+                }
+            }
+            callbacks.insert(user->callback);
         }
+        auto &subscriber = (*snapshot)[subscribeIt.first];
+        subscriber.callbacks.assign(callbacks.begin(), callbacks.end());
+        subscriber.batchCallbacks.assign(batchCallbacks.begin(), batchCallbacks.end());
     }
-    return callback;
+    std::atomic_store(&subscriberSnapshot_, std::shared_ptr<const SubscriberSnapshotMap>(std::move(snapshot)));
 }
 
 void SensorAgentProxy::HandleSensorData(SensorEvent *events,
@@ -75,15 +81,32 @@ void SensorAgentProxy::HandleSensorData(SensorEvent *events,
         SEN_HILOGE("events is null or num is invalid");
         return;
     }
-    SensorEvent eventStream;
-    for (int32_t i = 0; i < num; ++i) {
-        eventStream = events[i];
-        auto callbacks = GetSubscribeUserCallback(eventStream.sensorTypeId);
-        for (const auto &callback : callbacks) {
-            CHKPV(callback);
-            callback(&eventStream);
-            PrintSensorData::GetInstance().ControlSensorClientPrint(callback, eventStream);
+    auto snapshot = std::atomic_load(&subscriberSnapshot_);
+    int32_t begin = 0;
+    while (begin < num) {
+        int32_t sensorId = events[begin].sensorTypeId;
+        int32_t end = begin + 1;
+        while ((end < num) && (events[end].sensorTypeId == sensorId)) {
+            ++end;
+        }
+        auto iter = snapshot->find(sensorId);
+        if (iter == snapshot->end()) {
+            SEN_HILOGE("Sensor is not subscribed");
+            begin = end;
+            continue;
+        }
+        for (const auto &batchCallback : iter->second.batchCallbacks) {
+            batchCallback(events + begin, end - begin);
         }
+        SensorEvent eventStream;
+        for (int32_t i = begin; i < end; ++i) {
+            for (const auto &callback : iter->second.callbacks) {
+                eventStream = events[i];
+                callback(&eventStream);
+                PrintSensorData::GetInstance().ControlSensorClientPrint(callback, eventStream);
+            }
+        }
+        begin = end;
     }
 }
 
@@ -103,6 +126,9 @@ int32_t SensorAgentProxy::CreateSensorDataChannel()
         return ERR_OK;
     }
     CHKPR(dataChannel_, INVALID_POINTER);
+#ifdef OHOS_BUILD_ENABLE_SHARED_MEM_CHANNEL
+    dataChannel_->SetChannelType(SHARED_MEM_CHANNEL);
+#endif // OHOS_BUILD_ENABLE_SHARED_MEM_CHANNEL
     auto ret = dataChannel_->CreateSensorDataChannel([this] (SensorEvent *events, int32_t num, void *data) {
         this->HandleSensorData(events, num, data);
     }, nullptr);
@@ -174,6 +200,8 @@ int32_t SensorAgentProxy::ActivateSensor(int32_t sensorId, const SensorUser *use
         if (subscribeSet.empty()) {
             subscribeMap_.erase(sensorId);
         }
+        EraseBatchCallback(sensorId, user);
+        UpdateSubscriberSnapshot();
         return ret;
     }
     return ret;
@@ -202,8 +230,12 @@ int32_t SensorAgentProxy::DeactivateSensor(int32_t sensorId, const SensorUser *u
         SEN_HILOGD("User has been unsubscribed");
     }
     subscribeSet.erase(user);
-    if (subscribeSet.empty()) {
+    bool isLastUser = subscribeSet.empty();
+    if (isLastUser) {
         subscribeMap_.erase(sensorId);
+    }
+    UpdateSubscriberSnapshot();
+    if (isLastUser) {
         int32_t ret = SEN_CLIENT.DisableSensor(sensorId);
         if (ret != 0) {
             SEN_HILOGE("DisableSensor failed, ret:%{public}d", ret);
@@ -259,6 +291,7 @@ int32_t SensorAgentProxy::SubscribeSensor(int32_t sensorId, const SensorUser *us
     if (!status.second) {
         SEN_HILOGD("User has been subscribed");
     }
+    UpdateSubscriberSnapshot();
     if (PrintSensorData::GetInstance().IsContinuousType(sensorId)) {
         PrintSensorData::GetInstance().SavePrintUserInfo(user->callback);
     }
@@ -295,6 +328,7 @@ int32_t SensorAgentProxy::UnsubscribeSensor(int32_t sensorId, const SensorUser *
     if (unsubscribeSet.empty()) {
         unsubscribeMap_.erase(sensorId);
     }
+    EraseBatchCallback(sensorId, user);
     if (PrintSensorData::GetInstance().IsContinuousType(sensorId)) {
         PrintSensorData::GetInstance().RemovePrintUserInfo(user->callback);
     }
@@ -322,6 +356,41 @@ int32_t SensorAgentProxy::SetMode(int32_t sensorId, const SensorUser *user, int3
     return OHOS::Sensors::SUCCESS;
 }
 
+int32_t SensorAgentProxy::SetBatchCallback(int32_t sensorId, const SensorUser *user,
+                                           RecordSensorBatchCallback batchCallback)
+{
+    CHKPR(user, OHOS::Sensors::ERROR);
+    if (!SEN_CLIENT.IsValid(sensorId)) {
+        SEN_HILOGE("sensorId is invalid, %{public}d", sensorId);
+        return PARAMETER_ERROR;
+    }
+    std::lock_guard<std::recursive_mutex> subscribeLock(subscribeMutex_);
+    auto subscribeIt = subscribeMap_.find(sensorId);
+    if ((subscribeIt == subscribeMap_.end()) || (subscribeIt->second.find(user) == subscribeIt->second.end())) {
+        SEN_HILOGE("Subscribe user first");
+        return OHOS::Sensors::ERROR;
+    }
+    if (batchCallback == nullptr) {
+        EraseBatchCallback(sensorId, user);
+    } else {
+        batchCallbackMap_[sensorId][user] = batchCallback;
+    }
+    UpdateSubscriberSnapshot();
+    return OHOS::Sensors::SUCCESS;
+}
+
+void SensorAgentProxy::EraseBatchCallback(int32_t sensorId, const SensorUser *user)
+{
+    auto batchIt = batchCallbackMap_.find(sensorId);
+    if (batchIt == batchCallbackMap_.end()) {
+        return;
+    }
+    batchIt->second.erase(user);
+    if (batchIt->second.empty()) {
+        batchCallbackMap_.erase(batchIt);
+    }
+}
+
 void SensorAgentProxy::ClearSensorInfos() const
 {
     if (sensorActiveInfos_ != nullptr) {
@@ -496,5 +565,33 @@ int32_t SensorAgentProxy::ResetSensors() const
     }
     return ret;
 }
+
+int32_t SensorAgentProxy::GetLatestData(int32_t sensorId, SensorEvent *event) const
+{
+    CHKPR(event, PARAMETER_ERROR);
+    CHKPR(event->data, PARAMETER_ERROR);
+    SensorData data;
+    int32_t ret = SEN_CLIENT.GetLatestData(sensorId, data);
+    if (ret != ERR_OK) {
+        SEN_HILOGE("Get latest data failed, sensorId:%{public}d, ret:%{public}d", sensorId, ret);
+        return ret;
+    }
+    if (event->dataLen < data.dataLen) {
+        SEN_HILOGE("Buffer is too small, dataLen:%{public}u, need:%{public}u", event->dataLen, data.dataLen);
+        return PARAMETER_ERROR;
+    }
+    errno_t retCpy = memcpy_s(event->data, event->dataLen, data.data, data.dataLen);
+    if (retCpy != EOK) {
+        SEN_HILOGE("Copy sensor data failed, retCpy:%{public}d", retCpy);
+        return ERROR;
+    }
+    event->sensorTypeId = data.sensorTypeId;
+    event->version = data.version;
+    event->timestamp = data.timestamp;
+    event->option = data.option;
+    event->mode = data.mode;
+    event->dataLen = data.dataLen;
+    return ERR_OK;
+}
 }  // namespace Sensors
 }  // namespace OHOS
\ No newline at end of file
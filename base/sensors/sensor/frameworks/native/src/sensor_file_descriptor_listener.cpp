@@ -14,6 +14,10 @@
  */
 
 #include "sensor_file_descriptor_listener.h"
+
+#include <algorithm>
+#include <sys/eventfd.h>
+
 #include "sensor_agent_type.h"
 #include "sensor_basic_data_channel.h"
 #include "sensor_errors.h"
@@ -35,15 +39,42 @@ SensorFileDescriptorListener::SensorFileDescriptorListener()
 {
     receiveDataBuff_ = new (std::nothrow) SensorData[RECEIVE_DATA_SIZE];
     CHKPL(receiveDataBuff_);
+    eventBuff_ = new (std::nothrow) SensorEvent[RECEIVE_DATA_SIZE];
+    CHKPL(eventBuff_);
 }
 
 SensorFileDescriptorListener::~SensorFileDescriptorListener()
 {
     CALL_LOG_ENTER;
+    ReleaseBuff();
+}
+
+void SensorFileDescriptorListener::ReleaseBuff()
+{
     if (receiveDataBuff_ != nullptr) {
         delete[] receiveDataBuff_;
         receiveDataBuff_ = nullptr;
     }
+    if (eventBuff_ != nullptr) {
+        delete[] eventBuff_;
+        eventBuff_ = nullptr;
+    }
+}
+
+void SensorFileDescriptorListener::DispatchEvents(const SensorData *data, int32_t num)
+{
+    for (int32_t i = 0; i < num; i++) {
+        eventBuff_[i] = {
+            .sensorTypeId = data[i].sensorTypeId,
+            .version = data[i].version,
+            .timestamp = data[i].timestamp,
+            .option = data[i].option,
+            .mode = data[i].mode,
+            .data = const_cast<uint8_t *>(data[i].data),
+            .dataLen = data[i].dataLen
+        };
+    }
+    channel_->dataCB_(eventBuff_, num, channel_->privateData_);
 }
 
 void SensorFileDescriptorListener::OnReadable(int32_t fileDescriptor)
@@ -53,31 +84,45 @@ void SensorFileDescriptorListener::OnReadable(int32_t fileDescriptor)
         return;
     }
     CHKPV(channel_);
-    if (receiveDataBuff_ == nullptr) {
+    if ((receiveDataBuff_ == nullptr) || (eventBuff_ == nullptr)) {
         SEN_HILOGE("Receive data buff_ is null");
         return;
     }
+    std::shared_ptr<SensorSharedRing> sharedRing = channel_->GetSharedRing();
+    if (sharedRing != nullptr) {
+        ReadSharedRing(fileDescriptor, sharedRing);
+        return;
+    }
     int32_t len =
         recv(fileDescriptor, receiveDataBuff_, sizeof(SensorData) * RECEIVE_DATA_SIZE, 0);
     int32_t eventSize = static_cast<int32_t>(sizeof(SensorData));
     while (len > 0) {
         int32_t num = len / eventSize;
-        for (int i = 0; i < num; i++) {
-            SensorEvent event = {
-                .sensorTypeId = receiveDataBuff_[i].sensorTypeId,
-                .version = receiveDataBuff_[i].version,
-                .timestamp = receiveDataBuff_[i].timestamp,
-                .option = receiveDataBuff_[i].option,
-                .mode = receiveDataBuff_[i].mode,
-                .data = receiveDataBuff_[i].data,
-                .dataLen = receiveDataBuff_[i].dataLen
-            };
-            channel_->dataCB_(&event, 1, channel_->privateData_);
+        if (num > 0) {
+            DispatchEvents(receiveDataBuff_, num);
         }
         len = recv(fileDescriptor, receiveDataBuff_, sizeof(SensorData) * RECEIVE_DATA_SIZE, 0);
     }
 }
 
+void SensorFileDescriptorListener::ReadSharedRing(int32_t fileDescriptor,
+    const std::shared_ptr<SensorSharedRing> &sharedRing)
+{
+    eventfd_t doorbell = 0;
+    (void)eventfd_read(fileDescriptor, &doorbell);
+    do {
+        const SensorData *events = nullptr;
+        size_t num = sharedRing->GetReadableData(&events);
+        while (num > 0) {
+            num = std::min(num, static_cast<size_t>(RECEIVE_DATA_SIZE));
+            // Records are handed out in place and released only after the callback returns
+            DispatchEvents(events, static_cast<int32_t>(num));
+            sharedRing->ConsumeData(num);
+            num = sharedRing->GetReadableData(&events);
+        }
+    } while (!sharedRing->PrepareWait());
+}
+
 void SensorFileDescriptorListener::SetChannel(SensorDataChannel *channel)
 {
     channel_ = channel;
@@ -88,10 +133,7 @@ void SensorFileDescriptorListener::OnShutdown(int32_t fileDescriptor)
     if (fileDescriptor < 0) {
         SEN_HILOGE("Invalid fd:%{public}d", fileDescriptor);
     }
-    if (receiveDataBuff_ != nullptr) {
-        delete[] receiveDataBuff_;
-        receiveDataBuff_ = nullptr;
-    }
+    ReleaseBuff();
     CHKPV(channel_);
     channel_->DestroySensorDataChannel();
 }
@@ -101,10 +143,7 @@ void SensorFileDescriptorListener::OnException(int32_t fileDescriptor)
     if (fileDescriptor < 0) {
         SEN_HILOGE("Invalid fd:%{public}d", fileDescriptor);
     }
-    if (receiveDataBuff_ != nullptr) {
-        delete[] receiveDataBuff_;
-        receiveDataBuff_ = nullptr;
-    }
+    ReleaseBuff();
     CHKPV(channel_);
     channel_->DestroySensorDataChannel();
 }
@@ -424,6 +424,21 @@ int32_t SensorServiceClient::ResetSensors()
     return ret;
 }
 
+int32_t SensorServiceClient::GetLatestData(int32_t sensorId, SensorData &data)
+{
+    int32_t ret = InitServiceClient();
+    if (ret != ERR_OK) {
+        SEN_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
+        return ret;
+    }
+    std::lock_guard<std::mutex> clientLock(clientMutex_);
+    CHKPR(sensorServer_, ERROR);
+    StartTrace(HITRACE_TAG_SENSORS, "GetLatestData");
+    ret = sensorServer_->GetLatestData(sensorId, data);
+    FinishTrace(HITRACE_TAG_SENSORS);
+    return ret;
+}
+
 void SensorServiceClient::ReceiveMessage(const char *buf, size_t size)
 {
     CHKPV(buf);
@@ -19,6 +19,7 @@
 
 #include "hisysevent.h"
 #include "message_parcel.h"
+#include "securec.h"
 #include "sensor_client_proxy.h"
 #include "sensor_errors.h"
 #include "sensor_parcel.h"
@@ -357,5 +358,45 @@ ErrCode SensorServiceProxy::ResetSensors()
     }
     return static_cast<ErrCode>(ret);
 }
+
+ErrCode SensorServiceProxy::GetLatestData(int32_t sensorId, SensorData &sensorData)
+{
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(SensorServiceProxy::GetDescriptor())) {
+        SEN_HILOGE("Parcel write descriptor failed");
+        return WRITE_PARCEL_ERR;
+    }
+    WRITEINT32(data, sensorId, WRITE_PARCEL_ERR);
+    sptr<IRemoteObject> remote = Remote();
+    CHKPR(remote, ERROR);
+    MessageParcel reply;
+    MessageOption option;
+    int32_t ret = remote->SendRequest(static_cast<uint32_t>(SensorInterfaceCode::GET_LATEST_DATA),
+        data, reply, option);
+    if (ret != NO_ERROR) {
+        HiSysEventWrite(HiSysEvent::Domain::SENSOR, "SERVICE_IPC_EXCEPTION",
+            HiSysEvent::EventType::FAULT, "PKG_NAME", "GetLatestData", "ERROR_CODE", ret);
+        SEN_HILOGE("Failed, ret:%{public}d", ret);
+        return static_cast<ErrCode>(ret);
+    }
+    READINT32(reply, sensorData.sensorTypeId, READ_PARCEL_ERR);
+    READINT32(reply, sensorData.version, READ_PARCEL_ERR);
+    READINT64(reply, sensorData.timestamp, READ_PARCEL_ERR);
+    READINT32(reply, sensorData.option, READ_PARCEL_ERR);
+    READINT32(reply, sensorData.mode, READ_PARCEL_ERR);
+    READUINT32(reply, sensorData.dataLen, READ_PARCEL_ERR);
+    if (sensorData.dataLen > SENSOR_MAX_LENGTH) {
+        SEN_HILOGE("Invalid data length:%{public}u", sensorData.dataLen);
+        return READ_PARCEL_ERR;
+    }
+    const uint8_t *buffer = reply.ReadBuffer(sensorData.dataLen);
+    CHKPR(buffer, READ_PARCEL_ERR);
+    errno_t retCpy = memcpy_s(sensorData.data, sizeof(sensorData.data), buffer, sensorData.dataLen);
+    if (retCpy != EOK) {
+        SEN_HILOGE("Copy sensor data failed, retCpy:%{public}d", retCpy);
+        return COPY_ERR;
+    }
+    return NO_ERROR;
+}
 }  // namespace Sensors
 }  // namespace OHOS
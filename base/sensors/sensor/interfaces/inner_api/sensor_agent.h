@@ -128,6 +128,20 @@ int32_t DeactivateSensor(int32_t sensorTypeId, const SensorUser *user);
  */
 int32_t SetMode(int32_t sensorTypeId, const SensorUser *user, int32_t mode);
 
+/**
+ * @brief Sets the batch callback for a subscriber. Once set, the subscriber receives all events read in one
+ * round through the batch callback instead of one by one through the callback in {@link SensorUser}.
+ *
+ * @param sensorTypeId Indicates the ID of a sensor type. For details, see {@link SensorTypeId}.
+ * @param user Indicates the pointer to the sensor subscriber that requests sensor data.
+ * For details, see {@link SensorUser}. A subscriber can obtain data from only one sensor.
+ * @param batchCallback Indicates the batch callback. Passing <b>nullptr</b> restores per-event reporting.
+ * @return Returns <b>0</b> if the batch callback is successfully set; returns a non-zero value otherwise.
+ *
+ * @since 12
+ */
+int32_t SetBatchCallback(int32_t sensorTypeId, const SensorUser *user, RecordSensorBatchCallback batchCallback);
+
 /**
  * @brief Suspends all sensors subscribed by a process.
  *
@@ -189,6 +203,20 @@ int32_t Unregister(SensorActiveInfoCB callback);
  */
 int32_t ResetSensors();
 
+/**
+ * @brief Obtains the latest data of a sensor without subscribing to it.
+ *
+ * The data is the last event cached by the sensor service, so the sensor must be enabled by some subscriber.
+ *
+ * @param sensorId Indicates the ID of the sensor.
+ * @param event Indicates the pointer to the event to fill. Its <b>data</b> must point to a buffer of
+ * <b>dataLen</b> bytes, on success <b>dataLen</b> is set to the length of the data obtained.
+ * @return Returns <b>0</b> if the data is obtained; returns a non-zero value otherwise.
+ *
+ * @since 12
+ */
+int32_t GetLatestSensorData(int32_t sensorId, SensorEvent *event);
+
 #ifdef __cplusplus
 #if __cplusplus
 }
@@ -166,6 +166,14 @@ typedef struct SensorEvent {
  */
 typedef void (*RecordSensorCallback)(SensorEvent *event);
 
+/**
+ * @brief Defines the callback for batched data reporting by the sensor agent. All events passed in one call
+ * belong to the same sensor, are in reporting order and must not be modified by the callback.
+ *
+ * @since 12
+ */
+typedef void (*RecordSensorBatchCallback)(SensorEvent *events, int32_t num);
+
 /**
  * @brief Defines a reserved field for the sensor data subscriber.
  *
@@ -46,6 +46,10 @@ private:
     void RegisterHdiDeathRecipient();
     void UnregisterHdiDeathRecipient();
     void Reconnect();
+    int32_t RegisterEventCallback();
+    int32_t CreateEventQueue();
+    void ReleaseEventQueue();
+    void ReadEventQueue();
     void UpdateSensorBasicInfo(int32_t sensorId, int64_t samplingPeriodNs, int64_t maxReportDelayNs);
     void SetSensorBasicInfoState(int32_t sensorId, bool state);
     void DeleteSensorBasicInfoState(int32_t sensorId);
@@ -18,18 +18,43 @@
 
 #include "v2_0/isensor_callback.h"
 #include "v2_0/sensor_types.h"
+#include "v2_1/sensor_types.h"
 
 #include "sensor_data_event.h"
 
 using OHOS::HDI::Sensor::V2_0::HdfSensorEvents;
 using OHOS::HDI::Sensor::V2_0::ISensorCallback;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_EVENT_RECORD_DATA_SIZE;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_EVENT_RECORD_SIZE;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_MODE_FIFO_BATCH;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_BATCH_HEADER_SIZE;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_BATCH_MAX_SAMPLE_NUM;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_BATCH_MAX_SAMPLE_SIZE;
 
 namespace OHOS {
 namespace Sensors {
+struct SensorEventRecord {
+    int32_t sensorId;
+    int32_t version;
+    int64_t timestamp;
+    uint32_t option;
+    int32_t mode;
+    uint32_t dataLen;
+    uint32_t reserved;
+    uint8_t data[HDF_SENSOR_EVENT_RECORD_DATA_SIZE];
+};
+static_assert(sizeof(SensorEventRecord) == HDF_SENSOR_EVENT_RECORD_SIZE, "record layout mismatch");
+
 class SensorEventCallback : public ISensorCallback {
 public:
     virtual ~SensorEventCallback() {}
     int32_t OnDataEvent(const HdfSensorEvents &event) override;
+    int32_t OnDataRecord(const SensorEventRecord &record);
+
+private:
+    int32_t ReportEvent(SensorData &sensorData, const uint8_t *data, int32_t dataSize);
+    int32_t ReportBatch(const SensorData &sensorData, const uint8_t *data, size_t dataSize);
+    void FillSensorData(SensorData &sensorData, const uint8_t *data, int32_t dataSize);
 };
 }  // namespace Sensors
 }  // namespace OHOS
@@ -135,9 +135,7 @@ void CompatibleConnection::ReportSensorDataCallback(SensorEvent *event)
     }
     CHKPV(reportDataCallback_);
     CHKPV(reportDataCb_);
-    std::unique_lock<std::mutex> lk(ISensorHdiConnection::dataMutex_);
     (void)(reportDataCallback_->*reportDataCb_)(&sensorData, reportDataCallback_);
-    ISensorHdiConnection::dataCondition_.notify_one();
 }
 
 int32_t CompatibleConnection::RegisterDataReport(ReportDataCb cb, sptr<ReportDataCallback> reportDataCallback)
@@ -14,13 +14,17 @@
  */
 #include "hdi_connection.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <mutex>
+#include <sys/prctl.h>
 #include <thread>
 
 #include "hisysevent.h"
 #include "iproxy_broker.h"
 #include "v2_0/isensor_interface.h"
+#include "v2_1/isensor_interface.h"
 
 #include "sensor_agent_type.h"
 #include "sensor_errors.h"
@@ -35,6 +39,8 @@ using namespace OHOS::HiviewDFX;
 using OHOS::HDI::Sensor::V2_0::ISensorInterface;
 using OHOS::HDI::Sensor::V2_0::ISensorCallback;
 using OHOS::HDI::Sensor::V2_0::HdfSensorInformation;
+using OHOS::HDI::Base::SharedMemQueue;
+using OHOS::HDI::Base::SmqType;
 namespace {
 sptr<ISensorInterface> g_sensorInterface = nullptr;
 sptr<ISensorCallback> g_eventCallback  = nullptr;
@@ -43,6 +49,14 @@ std::mutex g_sensorBasicInfoMutex;
 constexpr int32_t GET_HDI_SERVICE_COUNT = 25;
 constexpr uint32_t WAIT_MS = 200;
 constexpr int32_t HEADPOSTURE_FIFO_COUNT = 5;
+constexpr uint32_t EVENT_QUEUE_RECORD_NUM = 512;
+constexpr uint32_t EVENT_QUEUE_READ_NUM = 32;
+constexpr int64_t EVENT_QUEUE_STOP_WAIT_NS = 100000000;
+constexpr int32_t EVENT_QUEUE_STOP_SENSOR_ID = -1;
+const std::string SENSOR_EVENT_QUEUE_THREAD_NAME = "OS_SenEvtQueue";
+std::shared_ptr<SharedMemQueue<uint8_t>> g_eventQueue = nullptr;
+std::thread g_eventQueueThread;
+std::atomic_bool g_eventQueueStop = false;
 }  // namespace
 
 ReportDataCb HdiConnection::reportDataCb_ = nullptr;
@@ -170,7 +184,7 @@ int32_t HdiConnection::RegisterDataReport(ReportDataCb cb, sptr<ReportDataCallba
     CALL_LOG_ENTER;
     CHKPR(reportDataCallback, ERR_NO_INIT);
     CHKPR(g_sensorInterface, ERR_NO_INIT);
-    int32_t ret = g_sensorInterface->Register(0, g_eventCallback);
+    int32_t ret = RegisterEventCallback();
     if (ret != 0) {
         HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SENSOR, "HDF_SERVICE_EXCEPTION",
             HiSysEvent::EventType::FAULT, "PKG_NAME", "RegisterDataReport", "ERROR_CODE", ret);
@@ -193,6 +207,7 @@ int32_t HdiConnection::DestroyHdiConnection()
         SEN_HILOGE("Unregister is failed");
         return ret;
     }
+    ReleaseEventQueue();
     g_eventCallback  = nullptr;
     UnregisterHdiDeathRecipient();
     return ERR_OK;
@@ -214,6 +229,93 @@ sptr<ReportDataCallback> HdiConnection::GetReportDataCallback()
     return reportDataCallback_;
 }
 
+int32_t HdiConnection::RegisterEventCallback()
+{
+    CHKPR(g_sensorInterface, ERR_NO_INIT);
+    ReleaseEventQueue();
+    if (CreateEventQueue() == ERR_OK) {
+        return ERR_OK;
+    }
+    SEN_HILOGW("Event queue is unavailable, events are reported by callback");
+    return g_sensorInterface->Register(0, g_eventCallback);
+}
+
+int32_t HdiConnection::CreateEventQueue()
+{
+    CALL_LOG_ENTER;
+    // Only a driver of version 2.1 or later takes the queue
+    sptr<OHOS::HDI::Sensor::V2_1::ISensorInterface> sensorInterface =
+        OHOS::HDI::Sensor::V2_1::ISensorInterface::CastFrom(g_sensorInterface);
+    if (sensorInterface == nullptr) {
+        SEN_HILOGW("Hdi does not support the event queue");
+        return ERROR;
+    }
+    // A synced queue keeps one element free, so leave room for exactly EVENT_QUEUE_RECORD_NUM records
+    auto eventQueue = std::make_shared<SharedMemQueue<uint8_t>>(
+        EVENT_QUEUE_RECORD_NUM * HDF_SENSOR_EVENT_RECORD_SIZE + 1, SmqType::SYNCED_SMQ);
+    if (!eventQueue->IsGood()) {
+        SEN_HILOGE("Create event queue failed");
+        return ERROR;
+    }
+    int32_t ret = sensorInterface->RegisterEventQueue(0, g_eventCallback, eventQueue);
+    if (ret != 0) {
+        SEN_HILOGE("RegisterEventQueue failed, ret:%{public}d", ret);
+        return ret;
+    }
+    g_eventQueue = eventQueue;
+    g_eventQueueStop = false;
+    g_eventQueueThread = std::thread([this] { this->ReadEventQueue(); });
+    return ERR_OK;
+}
+
+void HdiConnection::ReleaseEventQueue()
+{
+    if (g_eventQueue == nullptr) {
+        return;
+    }
+    g_eventQueueStop = true;
+    // The reader blocks on the queue, a stop record wakes it up once the driver has stopped writing
+    SensorEventRecord stopRecord = {};
+    stopRecord.sensorId = EVENT_QUEUE_STOP_SENSOR_ID;
+    int32_t ret = g_eventQueue->Write(reinterpret_cast<const uint8_t *>(&stopRecord), HDF_SENSOR_EVENT_RECORD_SIZE,
+        EVENT_QUEUE_STOP_WAIT_NS);
+    if (ret != 0) {
+        SEN_HILOGW("Write stop record failed, ret:%{public}d", ret);
+    }
+    if (g_eventQueueThread.joinable()) {
+        g_eventQueueThread.join();
+    }
+    g_eventQueue = nullptr;
+}
+
+void HdiConnection::ReadEventQueue()
+{
+    prctl(PR_SET_NAME, SENSOR_EVENT_QUEUE_THREAD_NAME.c_str());
+    std::shared_ptr<SharedMemQueue<uint8_t>> eventQueue = g_eventQueue;
+    CHKPV(eventQueue);
+    sptr<SensorEventCallback> eventCallback = new (std::nothrow) SensorEventCallback();
+    CHKPV(eventCallback);
+    std::vector<SensorEventRecord> records(EVENT_QUEUE_READ_NUM);
+    while (!g_eventQueueStop) {
+        if (eventQueue->Read(reinterpret_cast<uint8_t *>(records.data()), HDF_SENSOR_EVENT_RECORD_SIZE, 0) != 0) {
+            continue;
+        }
+        size_t recordNum = 1;
+        size_t readableNum = eventQueue->GetAvalidReadSize() / HDF_SENSOR_EVENT_RECORD_SIZE;
+        readableNum = std::min(readableNum, static_cast<size_t>(EVENT_QUEUE_READ_NUM - 1));
+        if (readableNum > 0 && eventQueue->ReadNonBlocking(reinterpret_cast<uint8_t *>(records.data() + 1),
+            readableNum * HDF_SENSOR_EVENT_RECORD_SIZE) == 0) {
+            recordNum += readableNum;
+        }
+        for (size_t i = 0; i < recordNum; ++i) {
+            if (records[i].sensorId == EVENT_QUEUE_STOP_SENSOR_ID) {
+                continue;
+            }
+            eventCallback->OnDataRecord(records[i]);
+        }
+    }
+}
+
 void HdiConnection::UpdateSensorBasicInfo(int32_t sensorId, int64_t samplingPeriodNs, int64_t maxReportDelayNs)
 {
     std::lock_guard<std::mutex> sensorInfoLock(g_sensorBasicInfoMutex);
@@ -287,7 +389,7 @@ void HdiConnection::Reconnect()
         SEN_HILOGE("Failed to get an instance of hdi service");
         return;
     }
-    ret = g_sensorInterface->Register(0, g_eventCallback);
+    ret = RegisterEventCallback();
     if (ret != 0) {
         SEN_HILOGE("Register callback fail");
         return;
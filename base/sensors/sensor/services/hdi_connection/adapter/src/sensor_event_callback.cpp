@@ -14,7 +14,11 @@
  */
 #include "sensor_event_callback.h"
 
+#include <algorithm>
 #include <set>
+#include <vector>
+
+#include <securec.h>
 
 #include "hdi_connection.h"
 #include "print_sensor_data.h"
@@ -30,6 +34,8 @@ using namespace OHOS::HiviewDFX;
 namespace {
 std::unique_ptr<HdiConnection> HdiConnection_ = std::make_unique<HdiConnection>();
 constexpr int32_t HEADPOSTURE_DATA_SIZE = 20;
+constexpr size_t BATCH_SAMPLE_NUM_INDEX = 0;
+constexpr size_t BATCH_SAMPLE_SIZE_INDEX = 1;
 const std::set<int32_t> g_sensorTypeTrigger = {
     SENSOR_TYPE_ID_PROXIMITY,
     SENSOR_TYPE_ID_DROP_DETECTION,
@@ -41,15 +47,6 @@ const std::set<int32_t> g_sensorTypeTrigger = {
 
 int32_t SensorEventCallback::OnDataEvent(const HdfSensorEvents &event)
 {
-    ReportDataCb reportDataCb_ = HdiConnection_->GetReportDataCb();
-    sptr<ReportDataCallback> reportDataCallback_ = HdiConnection_->GetReportDataCallback();
-    CHKPR(reportDataCb_, ERR_NO_INIT);
-    CHKPR(reportDataCallback_, ERR_NO_INIT);
-    int32_t dataSize = static_cast<int32_t>(event.data.size());
-    if (dataSize == 0) {
-        SEN_HILOGI("Data is empty");
-        return ERR_INVALID_VALUE;
-    }
     SensorData sensorData = {
         .sensorTypeId = event.sensorId,
         .version = event.version,
@@ -58,13 +55,100 @@ int32_t SensorEventCallback::OnDataEvent(const HdfSensorEvents &event)
         .mode = event.mode,
         .dataLen = event.dataLen
     };
+    if (event.mode == HDF_SENSOR_MODE_FIFO_BATCH) {
+        return ReportBatch(sensorData, event.data.data(), event.data.size());
+    }
+    return ReportEvent(sensorData, event.data.data(), static_cast<int32_t>(event.data.size()));
+}
+
+int32_t SensorEventCallback::OnDataRecord(const SensorEventRecord &record)
+{
+    if (record.dataLen > HDF_SENSOR_EVENT_RECORD_DATA_SIZE) {
+        SEN_HILOGE("Record dataLen:%{public}u is invalid", record.dataLen);
+        return ERR_INVALID_VALUE;
+    }
+    SensorData sensorData = {
+        .sensorTypeId = record.sensorId,
+        .version = record.version,
+        .timestamp = record.timestamp,
+        .option = record.option,
+        .mode = record.mode,
+        .dataLen = record.dataLen
+    };
+    if (record.mode == HDF_SENSOR_MODE_FIFO_BATCH) {
+        return ReportBatch(sensorData, record.data, record.dataLen);
+    }
+    return ReportEvent(sensorData, record.data, static_cast<int32_t>(record.dataLen));
+}
+
+int32_t SensorEventCallback::ReportEvent(SensorData &sensorData, const uint8_t *data, int32_t dataSize)
+{
+    ReportDataCb reportDataCb_ = HdiConnection_->GetReportDataCb();
+    sptr<ReportDataCallback> reportDataCallback_ = HdiConnection_->GetReportDataCallback();
+    CHKPR(reportDataCb_, ERR_NO_INIT);
+    CHKPR(reportDataCallback_, ERR_NO_INIT);
+    if (dataSize == 0) {
+        SEN_HILOGI("Data is empty");
+        return ERR_INVALID_VALUE;
+    }
     if (g_sensorTypeTrigger.find(sensorData.sensorTypeId) != g_sensorTypeTrigger.end()) {
         sensorData.mode = SENSOR_ON_CHANGE;
     }
-    CHKPR(sensorData.data, ERR_NO_INIT);
+    FillSensorData(sensorData, data, dataSize);
+    PrintSensorData::GetInstance().ControlSensorHdiPrint(sensorData);
+    (void)(reportDataCallback_->*(reportDataCb_))(&sensorData, reportDataCallback_);
+    return ERR_OK;
+}
+
+int32_t SensorEventCallback::ReportBatch(const SensorData &sensorData, const uint8_t *data, size_t dataSize)
+{
+    sptr<ReportDataCallback> reportDataCallback_ = HdiConnection_->GetReportDataCallback();
+    CHKPR(reportDataCallback_, ERR_NO_INIT);
+    uint32_t header[HDF_SENSOR_BATCH_HEADER_SIZE / sizeof(uint32_t)] = {0};
+    if (dataSize < sizeof(header) || memcpy_s(header, sizeof(header), data, sizeof(header)) != EOK) {
+        SEN_HILOGE("Batch of sensor:%{public}d is too short, dataSize:%{public}zu", sensorData.sensorTypeId,
+            dataSize);
+        return ERR_INVALID_VALUE;
+    }
+    uint32_t sampleNum = header[BATCH_SAMPLE_NUM_INDEX];
+    uint32_t sampleSize = header[BATCH_SAMPLE_SIZE_INDEX];
+    size_t samplesOffset = sizeof(header) + static_cast<size_t>(sampleNum) * sizeof(uint32_t);
+    if (sampleNum == 0 || sampleNum > HDF_SENSOR_BATCH_MAX_SAMPLE_NUM || sampleSize == 0 ||
+        sampleSize > HDF_SENSOR_BATCH_MAX_SAMPLE_SIZE || sampleSize > SENSOR_MAX_LENGTH ||
+        dataSize < samplesOffset + static_cast<size_t>(sampleNum) * sampleSize) {
+        SEN_HILOGE("Batch of sensor:%{public}d is malformed, sampleNum:%{public}u, sampleSize:%{public}u",
+            sensorData.sensorTypeId, sampleNum, sampleSize);
+        return ERR_INVALID_VALUE;
+    }
+    // Reused by every batch on the report thread so the samples vector keeps its capacity
+    static thread_local std::vector<SensorData> samples;
+    samples.resize(sampleNum);
+    int64_t timestamp = sensorData.timestamp;
+    for (uint32_t i = 0; i < sampleNum; ++i) {
+        uint32_t delta = 0;
+        (void)memcpy_s(&delta, sizeof(delta), data + sizeof(header) + i * sizeof(delta), sizeof(delta));
+        timestamp += delta;
+        SensorData &sample = samples[i];
+        sample.sensorTypeId = sensorData.sensorTypeId;
+        sample.version = sensorData.version;
+        sample.timestamp = timestamp;
+        sample.option = sensorData.option;
+        sample.mode = SENSOR_FIFO_MODE;
+        sample.flags = SENSOR_DATA_FLAG_HW_BATCH;
+        sample.dataLen = sampleSize;
+        FillSensorData(sample, data + samplesOffset + static_cast<size_t>(i) * sampleSize,
+            static_cast<int32_t>(sampleSize));
+    }
+    PrintSensorData::GetInstance().ControlSensorHdiPrint(samples.back());
+    // The whole burst goes through the ring in one write, so the data thread wakes up once for it
+    return reportDataCallback_->ReportEventsCallback(samples.data(), samples.size(), reportDataCallback_);
+}
+
+void SensorEventCallback::FillSensorData(SensorData &sensorData, const uint8_t *data, int32_t dataSize)
+{
     if (sensorData.sensorTypeId == SENSOR_TYPE_ID_HEADPOSTURE) {
         sensorData.dataLen = HEADPOSTURE_DATA_SIZE;
-        const float *inputFloatPtr = reinterpret_cast<const float *>(event.data.data());
+        const float *inputFloatPtr = reinterpret_cast<const float *>(data);
         float *outputFloatPtr = reinterpret_cast<float *>(sensorData.data);
         int32_t *outputIntPtr = reinterpret_cast<int32_t *>(sensorData.data);
         outputIntPtr[0] = static_cast<int32_t>(*(inputFloatPtr + 1));
@@ -76,15 +160,11 @@ int32_t SensorEventCallback::OnDataEvent(const HdfSensorEvents &event)
         outputFloatPtr[3] = *(inputFloatPtr + 5);
         outputFloatPtr[4] = *(inputFloatPtr + 6);
     } else {
+        dataSize = std::min(dataSize, SENSOR_MAX_LENGTH);
         for (int32_t i = 0; i < dataSize; i++) {
-            sensorData.data[i] = event.data[i];
+            sensorData.data[i] = data[i];
         }
     }
-    PrintSensorData::GetInstance().ControlSensorHdiPrint(sensorData);
-    std::unique_lock<std::mutex> lk(ISensorHdiConnection::dataMutex_);
-    (void)(reportDataCallback_->*(reportDataCb_))(&sensorData, reportDataCallback_);
-    ISensorHdiConnection::dataCondition_.notify_one();
-    return ERR_OK;
 }
 } // namespace Sensors
 } // namespace OHOS
\ No newline at end of file
@@ -17,17 +17,25 @@
 #define HDI_SERVICE_IMPL_H
 
 #include <atomic>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 #include "sensor_agent_type.h"
 #include "singleton.h"
 
 namespace OHOS {
 namespace Sensors {
+struct MockBatchInfo {
+    int64_t samplingInterval;
+    int64_t reportInterval;
+    int64_t setTimeNs;
+};
+
 class HdiServiceImpl : public Singleton<HdiServiceImpl> {
 public:
     HdiServiceImpl() = default;
-    virtual ~HdiServiceImpl() {}
+    virtual ~HdiServiceImpl();
     int32_t GetSensorList(std::vector<SensorInfo> &sensorList);
     int32_t EnableSensor(int32_t sensorId);
     int32_t DisableSensor(int32_t sensorId);
@@ -35,6 +43,7 @@ public:
     int32_t SetMode(int32_t sensorId, int32_t mode);
     int32_t Register(RecordSensorCallback cb);
     int32_t Unregister();
+    int64_t CountBatchWakeups(int64_t durationNs);
 
 private:
     DISALLOW_COPY_AND_MOVE(HdiServiceImpl);
@@ -51,6 +60,9 @@ private:
     static int64_t samplingInterval_;
     static int64_t reportInterval_;
     static std::atomic_bool isStop_;
+    // Every SetBatch restarts the FIFO of the sensor, so its flushes are counted from that moment
+    std::mutex batchMutex_;
+    std::unordered_map<int32_t, MockBatchInfo> batchInfos_;
 };
 } // namespace Sensors
 } // namespace OHOS
@@ -14,6 +14,8 @@
  */
 #include "hdi_service_impl.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <random>
 #include <sys/prctl.h>
@@ -33,6 +35,8 @@ namespace {
 constexpr int64_t SAMPLING_INTERVAL_NS = 200000000;
 constexpr float TARGET_SUM = 9.8F * 9.8F;
 constexpr float MAX_RANGE = 9999.0F;
+// Flushes closer than this are served by the same wakeup
+constexpr int64_t WAKEUP_MERGE_NS = 1000000;
 const std::string SENSOR_PRODUCE_THREAD_NAME = "OS_SenMock";
 std::vector<SensorInfo> g_sensorInfos = {
     {"sensor_test", "default", "1.0.0", "1.0.0", 1, 1, 9999.0, 0.000001, 23.0, 100000000, 1000000000},
@@ -81,24 +85,39 @@ int64_t HdiServiceImpl::samplingInterval_ = -1;
 int64_t HdiServiceImpl::reportInterval_ = -1;
 std::atomic_bool HdiServiceImpl::isStop_ = false;
 
+HdiServiceImpl::~HdiServiceImpl()
+{
+    isStop_ = true;
+    if (dataReportThread_.joinable()) {
+        dataReportThread_.join();
+    }
+}
+
 void HdiServiceImpl::GenerateEvent()
 {
+    int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
     for (const auto &sensorId : enableSensors_) {
         switch (sensorId) {
             case SENSOR_TYPE_ID_ACCELEROMETER:
                 GenerateAccelerometerEvent();
+                g_accEvent.timestamp = timestamp;
                 break;
             case SENSOR_TYPE_ID_COLOR:
                 GenerateColorEvent();
+                g_colorEvent.timestamp = timestamp;
                 break;
             case SENSOR_TYPE_ID_SAR:
                 GenerateSarEvent();
+                g_sarEvent.timestamp = timestamp;
                 break;
             case SENSOR_TYPE_ID_HEADPOSTURE:
                 GenerateHeadPostureEvent();
+                g_headPostureEvent.timestamp = timestamp;
                 break;
             case SENSOR_TYPE_ID_PROXIMITY1:
                 GenerateProximityEvent();
+                g_proximityEvent.timestamp = timestamp;
                 break;
             default:
                 SEN_HILOGW("Unknown sensorId:%{public}d", sensorId);
@@ -292,9 +311,45 @@ int32_t HdiServiceImpl::SetBatch(int32_t sensorId, int64_t samplingInterval, int
     }
     samplingInterval_ = samplingInterval;
     reportInterval_ = reportInterval;
+    int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    std::lock_guard<std::mutex> batchLock(batchMutex_);
+    batchInfos_[sensorId] = { samplingInterval, reportInterval, nowNs };
     return ERR_OK;
 }
 
+int64_t HdiServiceImpl::CountBatchWakeups(int64_t durationNs)
+{
+    int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    std::vector<int64_t> flushTimes;
+    {
+        std::lock_guard<std::mutex> batchLock(batchMutex_);
+        for (const auto &it : batchInfos_) {
+            const MockBatchInfo &info = it.second;
+            if (info.reportInterval <= 0 || info.reportInterval < info.samplingInterval) {
+                continue;
+            }
+            int64_t flushTime = info.setTimeNs + info.reportInterval;
+            for (; flushTime <= nowNs + durationNs; flushTime += info.reportInterval) {
+                if (flushTime > nowNs) {
+                    flushTimes.push_back(flushTime);
+                }
+            }
+        }
+    }
+    std::sort(flushTimes.begin(), flushTimes.end());
+    int64_t wakeups = 0;
+    int64_t lastWakeup = 0;
+    for (int64_t flushTime : flushTimes) {
+        if (wakeups == 0 || flushTime - lastWakeup > WAKEUP_MERGE_NS) {
+            ++wakeups;
+            lastWakeup = flushTime;
+        }
+    }
+    return wakeups;
+}
+
 int32_t HdiServiceImpl::SetMode(int32_t sensorId, int32_t mode)
 {
     return ERR_OK;
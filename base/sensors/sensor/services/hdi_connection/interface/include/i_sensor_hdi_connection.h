@@ -16,8 +16,8 @@
 #ifndef I_SENSOR_HDI_CONNECTION_H
 #define I_SENSOR_HDI_CONNECTION_H
 
-#include <condition_variable>
-#include <mutex>
+#include <vector>
+
 #include "report_data_callback.h"
 #include "sensor.h"
 
@@ -35,8 +35,6 @@ public:
     virtual int32_t SetMode(int32_t sensorId, int32_t mode) = 0;
     virtual int32_t RegisterDataReport(ReportDataCb cb, sptr<ReportDataCallback> reportDataCallback) = 0;
     virtual int32_t DestroyHdiConnection() = 0;
-    static std::mutex dataMutex_;
-    static std::condition_variable dataCondition_;
 
 private:
     DISALLOW_COPY_AND_MOVE(ISensorHdiConnection);
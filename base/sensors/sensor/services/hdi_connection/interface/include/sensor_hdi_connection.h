@@ -17,7 +17,8 @@
 #define SENSOR_HDI_CONNECTION_H
 
 #include <atomic>
-#include<unordered_set>
+#include <mutex>
+#include <unordered_set>
 
 #include "i_sensor_hdi_connection.h"
 #include "singleton.h"
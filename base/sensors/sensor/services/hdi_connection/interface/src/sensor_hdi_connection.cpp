@@ -24,8 +24,6 @@
 
 #undef LOG_TAG
 #define LOG_TAG "SensorHdiConnection"
-std::mutex OHOS::Sensors::ISensorHdiConnection::dataMutex_;
-std::condition_variable OHOS::Sensors::ISensorHdiConnection::dataCondition_;
 
 namespace OHOS {
 namespace Sensors {
@@ -16,8 +16,9 @@
 #ifndef CLIENT_INFO_H
 #define CLIENT_INFO_H
 
+#include <atomic>
 #include <map>
-#include <queue>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -31,14 +32,36 @@
 #include "nocopyable.h"
 
 #include "app_thread_info.h"
+#include "sensor.h"
 #include "sensor_basic_data_channel.h"
 #include "sensor_basic_info.h"
 #include "sensor_channel_info.h"
 #include "sensor_data_event.h"
+#include "sensor_dump_ring.h"
 
 namespace OHOS {
 namespace Sensors {
 using Security::AccessToken::AccessTokenID;
+struct SubscribePlan {
+    // Sampling period asked for by the client, samples are delivered on its own time grid
+    int64_t samplingPeriodNs { 0 };
+    // Used instead of the period when the samples carry no timestamp
+    uint64_t periodCount { 0 };
+    uint64_t fifoCount { 0 };
+};
+// sensorId -> pid -> plan
+using SubscribePlanMap = std::unordered_map<int32_t, std::unordered_map<int32_t, SubscribePlan>>;
+// Last event of one sensor, guarded by a seqlock: odd sequence means a write is in progress
+struct StoredEventSlot {
+    std::atomic<uint32_t> sequence { 0 };
+    bool stored { false };
+    SensorData data;
+};
+// sensorId -> slot, built from the sensor list and never modified afterwards
+using StoredEventTable = std::unordered_map<int32_t, std::unique_ptr<StoredEventSlot>>;
+// sensorId -> dump history, rebuilt with the sensor list, rings of remaining sensors are kept
+using DumpRingTable = std::unordered_map<int32_t, std::shared_ptr<SensorDumpRing>>;
+
 class ClientInfo : public Singleton<ClientInfo> {
 public:
     ClientInfo() = default;
@@ -58,21 +81,24 @@ public:
     bool DestroySensorChannel(int32_t pid);
     void DestroyAppThreadInfo(int32_t pid);
     SensorBasicInfo GetCurPidSensorInfo(int32_t sensorId, int32_t pid);
-    uint64_t ComputeBestPeriodCount(int32_t sensorId, sptr<SensorBasicDataChannel> &channel);
-    uint64_t ComputeBestFifoCount(int32_t sensorId, sptr<SensorBasicDataChannel> &channel);
+    bool GetSubscribePlan(int32_t sensorId, const sptr<SensorBasicDataChannel> &channel, SubscribePlan &plan);
     int32_t GetStoreEvent(int32_t sensorId, SensorData &data);
     void StoreEvent(const SensorData &data);
     void ClearEvent();
+    void UpdateStoredEventTable(const std::vector<Sensor> &sensors);
     AppThreadInfo GetAppInfoByChannel(const sptr<SensorBasicDataChannel> &channel);
     bool SaveClientPid(const sptr<IRemoteObject> &sensorClient, int32_t pid);
     int32_t FindClientPid(const sptr<IRemoteObject> &sensorClient);
     void DestroyClientPid(const sptr<IRemoteObject> &sensorClient);
     std::vector<int32_t> GetSensorIdByPid(int32_t pid);
     void GetSensorChannelInfo(std::vector<SensorChannelInfo> &channelInfo);
+    void GetDataChannelStats(std::vector<SensorChannelStats> &channelStats);
     void UpdateCmd(int32_t sensorId, int32_t uid, int32_t cmdType);
     void DestroyCmd(int32_t uid);
-    void UpdateDataQueue(int32_t sensorId, SensorData &data);
-    std::unordered_map<int32_t, std::queue<SensorData>> GetDumpQueue();
+    void UpdateDumpRingTable(const std::vector<Sensor> &sensors);
+    void UpdateDataQueue(int32_t sensorId, const SensorData &data);
+    std::unordered_map<int32_t, std::vector<SensorData>> GetDumpQueue(int64_t beginNs = 0,
+        int64_t endNs = LLONG_MAX);
     void ClearDataQueue(int32_t sensorId);
     int32_t GetUidByPid(int32_t pid);
     AccessTokenID GetTokenIdByPid(int32_t pid);
@@ -87,20 +113,26 @@ public:
 private:
     DISALLOW_COPY_AND_MOVE(ClientInfo);
     std::vector<int32_t> GetCmdList(int32_t sensorId, int32_t uid);
+    void UpdateSubscribePlan();
+    void WriteStoredEvent(StoredEventSlot &slot, const SensorData *data);
+    bool ReadStoredEvent(const StoredEventSlot &slot, SensorData &data);
     std::mutex clientMutex_;
     std::mutex channelMutex_;
-    std::mutex eventMutex_;
     std::mutex uidMutex_;
     std::mutex clientPidMutex_;
     std::mutex cmdMutex_;
-    std::mutex dataQueueMutex_;
+    // Serializes the rebuilds of the tables keyed by sensor
+    std::mutex sensorTableMutex_;
     std::unordered_map<int32_t, std::unordered_map<int32_t, SensorBasicInfo>> clientMap_;
+    // Rebuilt under clientMutex_ whenever clientMap_ changes, read lock-free on the data path
+    std::shared_ptr<const SubscribePlanMap> subscribePlan_ = std::make_shared<const SubscribePlanMap>();
     std::unordered_map<int32_t, sptr<SensorBasicDataChannel>> channelMap_;
-    std::unordered_map<int32_t, SensorData> storedEvent_;
+    // Swapped as a whole when the sensor list changes, slots are written and read lock-free
+    std::shared_ptr<const StoredEventTable> storedEvent_ = std::make_shared<const StoredEventTable>();
     std::unordered_map<int32_t, AppThreadInfo> appThreadInfoMap_;
     std::map<sptr<IRemoteObject>, int32_t> clientPidMap_;
     std::unordered_map<int32_t, std::unordered_map<int32_t, std::vector<int32_t>>> cmdMap_;
-    std::unordered_map<int32_t, std::queue<SensorData>> dumpQueue_;
+    std::shared_ptr<const DumpRingTable> dumpRing_ = std::make_shared<const DumpRingTable>();
     std::mutex activeInfoCBPidMutex_;
     std::unordered_set<int32_t> activeInfoCBPidSet_;
     static std::unordered_map<std::string, std::set<int32_t>> userGrantPermMap_;
@@ -16,7 +16,8 @@
 #ifndef FIFO_CACHE_DATA_H
 #define FIFO_CACHE_DATA_H
 
-#include <vector>
+#include <array>
+#include <memory>
 
 #include "nocopyable.h"
 #include "refbase.h"
@@ -25,24 +26,41 @@
 
 namespace OHOS {
 namespace Sensors {
+// Upper bound of records cached for one channel before they are sent, regardless of the report delay
+constexpr size_t MAX_FIFO_CACHE_NUM = 1000;
+
 class FifoCacheData : public RefBase {
 public:
     FifoCacheData();
     virtual ~FifoCacheData();
-    void SetPeriodCount(uint64_t periodCount);
-    uint64_t GetPeriodCount() const;
-    void SetFifoCacheData(const std::vector<SensorData> &fifoCacheData);
-    std::vector<SensorData> GetFifoCacheData() const;
+    // Returns whether data is the sample closest to the next point of the client's period, if average is set it
+    // receives data with the values averaged over the samples skipped since the last delivered one
+    bool SelectSample(const SensorData &data, int64_t periodNs, uint64_t periodCount, SensorData *average);
+    bool ResizeFifoCache(size_t capacity);
+    size_t GetFifoCapacity() const;
+    bool PushFifoCacheData(const SensorData &data);
+    const SensorData *GetFifoCacheData() const;
+    size_t GetFifoCacheSize() const;
     void SetChannel(const sptr<SensorBasicDataChannel> &channel);
     sptr<SensorBasicDataChannel> GetChannel() const;
     void InitFifoCache();
 
 private:
     DISALLOW_COPY_AND_MOVE(FifoCacheData);
+    void AccumulateSample(const SensorData &data);
+    void AverageSample(const SensorData &data, SensorData &average);
+    // Only used for streams without timestamps
     uint64_t periodCount_;
+    // Target time of the next sample to deliver, 0 before the first one
+    int64_t nextDeliverNs_ = 0;
+    int64_t lastTimestampNs_ = 0;
+    std::array<double, SENSOR_MAX_LENGTH / sizeof(float)> sampleSum_ {};
+    uint32_t sampleNum_ = 0;
     wptr<SensorBasicDataChannel> channel_;
-    std::vector<SensorData> fifoCacheData_;
+    std::unique_ptr<SensorData[]> fifoCacheData_;
+    size_t fifoCapacity_;
+    size_t fifoSize_;
 };
 } // namespace Sensors
 } // namespace OHOS
-#endif // FIFO_CACHE_DATA_H
\ No newline at end of file
+#endif // FIFO_CACHE_DATA_H
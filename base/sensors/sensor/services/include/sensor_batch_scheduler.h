@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SENSOR_BATCH_SCHEDULER_H
+#define SENSOR_BATCH_SCHEDULER_H
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "nocopyable.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace Sensors {
+struct SensorBatchPlan {
+    int32_t sensorId = -1;
+    int64_t samplingPeriodNs = 0;
+    int64_t requestDelayNs = 0;
+    int64_t alignedDelayNs = 0;
+};
+
+/*
+ * Aligns the report delays of all batched sensors so that their FIFOs are flushed on a common tick.
+ * The shortest requested delay is the tick, every other delay is rounded down to a multiple of it,
+ * so no client ever gets its data later than it asked for. Sensors whose rounded delay would no longer
+ * hold a single sample keep their own delay.
+ */
+class SensorBatchScheduler : public Singleton<SensorBatchScheduler> {
+public:
+    SensorBatchScheduler() = default;
+    virtual ~SensorBatchScheduler() = default;
+    std::vector<SensorBatchPlan> UpdateSensor(int32_t sensorId, int64_t samplingPeriodNs, int64_t maxReportDelayNs);
+    std::vector<SensorBatchPlan> RemoveSensor(int32_t sensorId);
+    std::vector<SensorBatchPlan> GetBatchPlans();
+    double GetWakeupRate(bool isAligned);
+
+private:
+    DISALLOW_COPY_AND_MOVE(SensorBatchScheduler);
+    bool IsBatched(const SensorBatchPlan &plan) const;
+    void AlignPlans();
+    std::vector<SensorBatchPlan> GetBatchedPlans() const;
+    double ComputeWakeupRate(bool isAligned) const;
+    std::mutex planMutex_;
+    std::unordered_map<int32_t, SensorBatchPlan> plans_;
+    int64_t tickNs_ = 0;
+};
+} // namespace Sensors
+} // namespace OHOS
+#endif // SENSOR_BATCH_SCHEDULER_H
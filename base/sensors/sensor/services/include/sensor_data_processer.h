@@ -16,6 +16,10 @@
 #ifndef SENSORS_DATA_PROCESSER_H
 #define SENSORS_DATA_PROCESSER_H
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -33,34 +37,80 @@
 
 namespace OHOS {
 namespace Sensors {
+#ifndef SENSOR_DISPATCH_THREAD_NUM
+#define SENSOR_DISPATCH_THREAD_NUM 2
+#endif // SENSOR_DISPATCH_THREAD_NUM
+// With a single shard the events are dispatched on the data thread itself
+constexpr size_t DEFAULT_DISPATCH_SHARD_NUM = SENSOR_DISPATCH_THREAD_NUM;
+constexpr size_t MAX_DISPATCH_SHARD_NUM = 8;
+
 class SensorDataProcesser : public RefBase {
 public:
-    explicit SensorDataProcesser(const std::unordered_map<int32_t, Sensor> &sensorMap);
+    explicit SensorDataProcesser(const std::unordered_map<int32_t, Sensor> &sensorMap,
+                                 size_t shardNum = DEFAULT_DISPATCH_SHARD_NUM);
     virtual ~SensorDataProcesser();
     int32_t ProcessEvents(sptr<ReportDataCallback> dataCallback);
-    int32_t SendEvents(sptr<SensorBasicDataChannel> &channel, SensorData &data);
     static int DataThread(sptr<SensorDataProcesser> dataProcesser, sptr<ReportDataCallback> dataCallback);
-    int32_t CacheSensorEvent(const SensorData &data, sptr<SensorBasicDataChannel> &channel);
 
 private:
     DISALLOW_COPY_AND_MOVE(SensorDataProcesser);
-    void ReportData(sptr<SensorBasicDataChannel> &channel, SensorData &data);
-    bool ReportNotContinuousData(std::unordered_map<int32_t, SensorData> &cacheBuf,
-                                 sptr<SensorBasicDataChannel> &channel, SensorData &data);
-    void SendNoneFifoCacheData(std::unordered_map<int32_t, SensorData> &cacheBuf,
-                               sptr<SensorBasicDataChannel> &channel, SensorData &data, uint64_t periodCount);
-    void SendFifoCacheData(std::unordered_map<int32_t, SensorData> &cacheBuf,
-                           sptr<SensorBasicDataChannel> &channel, SensorData &data, uint64_t periodCount,
-                           uint64_t fifoCount);
-    void SendRawData(std::unordered_map<int32_t, SensorData> &cacheBuf, sptr<SensorBasicDataChannel> channel,
-                     std::vector<SensorData> events);
-    void EventFilter(CircularEventBuf &eventsBuf);
+    struct ChannelBatch {
+        sptr<SensorBasicDataChannel> channel;
+        std::vector<SensorData> events;
+    };
+    /*
+     * Events of a sensor are always dispatched by the same shard, in the order they were reported,
+     * so everything below except the pending queue is only touched by the thread of that shard.
+     */
+    struct DispatchShard {
+        std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        std::vector<SensorData> pendingEvents;
+        uint64_t dropCount = 0;
+        bool stop = false;
+        std::vector<SensorData> dispatchEvents;
+        std::unordered_map<int32_t, std::vector<sptr<FifoCacheData>>> dataCountMap;
+        std::unordered_map<int32_t, std::vector<sptr<SensorBasicDataChannel>>> cycleChannels;
+        std::unordered_map<SensorBasicDataChannel *, ChannelBatch> channelBatches;
+        std::thread worker;
+    };
+    void DispatchThread(DispatchShard &shard);
+    void PostEvents(const SensorData *events, size_t num);
+    void DispatchEvents(DispatchShard &shard, SensorData *events, size_t num);
+    int32_t SendEvents(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel, SensorData &data);
+    void ReportData(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel, SensorData &data);
+    bool ReportNotContinuousData(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel, SensorData &data);
+    sptr<FifoCacheData> GetFifoCacheData(DispatchShard &shard, const sptr<SensorBasicDataChannel> &channel,
+                                         int32_t sensorId);
+    const SensorData *SelectSample(const sptr<FifoCacheData> &fifoData, const SensorData &data,
+                                   const SubscribePlan &plan, SensorData &average);
+    void SendNoneFifoCacheData(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel, SensorData &data,
+                               const SubscribePlan &plan);
+    void SendFifoCacheData(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel, SensorData &data,
+                           const SubscribePlan &plan);
+    void SendRawData(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel, const SensorData *events,
+                     size_t num);
+    void FlushChannelBatches(DispatchShard &shard);
+    void EventFilter(DispatchShard &shard, SensorData &event);
+    void CheckEventOverflow(sptr<ReportDataCallback> dataCallback);
+    void InitFlushThread();
+    void ReleaseFlushThread();
+    void RequestFlush(const sptr<SensorBasicDataChannel> &channel);
+    void SweepFlushChannels();
+    void FlushThread();
     ClientInfo &clientInfo_ = ClientInfo::GetInstance();
     FlushInfoRecord &flushInfo_ = FlushInfoRecord::GetInstance();
-    std::mutex dataCountMutex_;
-    std::unordered_map<int32_t, std::vector<sptr<FifoCacheData>>> dataCountMap_;
     std::mutex sensorMutex_;
     std::unordered_map<int32_t, Sensor> sensorMap_;
+    std::vector<SensorData> drainEvents_;
+    std::vector<std::unique_ptr<DispatchShard>> shards_;
+    // Congested channels waiting for EPOLLOUT, keyed by their send fd
+    int32_t flushEpollFd_ = -1;
+    int32_t flushStopFd_ = -1;
+    std::thread flushThread_;
+    std::mutex flushMutex_;
+    std::unordered_map<int32_t, sptr<SensorBasicDataChannel>> flushChannels_;
+    uint64_t lastOverflowCount_ = 0;
 };
 } // namespace Sensors
 } // namespace OHOS
@@ -39,6 +39,7 @@ public:
     bool DumpSensorChannel(int32_t fd, ClientInfo &clientInfo);
     bool DumpOpeningSensor(int32_t fd, const std::vector<Sensor> &sensors, ClientInfo &clientInfo);
     bool DumpSensorData(int32_t fd, ClientInfo &clientInfo);
+    bool ExportSensorData(int32_t fd, ClientInfo &clientInfo, int64_t windowS);
 
 private:
     DISALLOW_COPY_AND_MOVE(SensorDump);
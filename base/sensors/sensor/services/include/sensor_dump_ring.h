@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SENSOR_DUMP_RING_H
+#define SENSOR_DUMP_RING_H
+
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <vector>
+
+#include "nocopyable.h"
+
+#include "sensor_data_event.h"
+
+namespace OHOS {
+namespace Sensors {
+// Records kept per sensor for dump and export
+constexpr size_t DUMP_RING_CAPACITY = 128;
+
+// History of the last events of one sensor. Push is called by a single writer, the dispatch shard owning the
+// sensor, and never blocks; readers copy out the records that were not overwritten while being read.
+class SensorDumpRing {
+public:
+    explicit SensorDumpRing(size_t capacity = DUMP_RING_CAPACITY);
+    ~SensorDumpRing() = default;
+    void Push(const SensorData &data);
+    // Appends the records with beginNs <= timestamp <= endNs to events, oldest first
+    size_t Snapshot(std::vector<SensorData> &events, int64_t beginNs = 0, int64_t endNs = LLONG_MAX) const;
+    void Clear();
+
+private:
+    DISALLOW_COPY_AND_MOVE(SensorDumpRing);
+    static constexpr size_t RECORD_WORD_NUM = (sizeof(SensorData) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    struct Record {
+        // 2 * n + 1 while the n-th event is written into the record, 2 * n + 2 once it is complete
+        std::atomic<uint64_t> sequence { 0 };
+        // The event copied word by word with relaxed atomics, so a concurrent reader never races with the writer
+        std::atomic<uint64_t> words[RECORD_WORD_NUM];
+    };
+    size_t capacity_;
+    std::unique_ptr<Record[]> records_;
+    std::atomic<uint64_t> writeCount_ { 0 };
+    // Records written before it are hidden from readers
+    std::atomic<uint64_t> clearCount_ { 0 };
+};
+} // namespace Sensors
+} // namespace OHOS
+#endif // SENSOR_DUMP_RING_H
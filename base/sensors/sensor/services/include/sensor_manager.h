@@ -23,6 +23,7 @@
 #include "client_info.h"
 #include "flush_info_record.h"
 #ifdef HDF_DRIVERS_INTERFACE_SENSOR
+#include "sensor_batch_scheduler.h"
 #include "sensor_data_processer.h"
 #include "sensor_hdi_connection.h"
 #else
@@ -51,7 +52,9 @@ public:
 
 private:
 #ifdef HDF_DRIVERS_INTERFACE_SENSOR
+    bool ApplyBatchPlans(int32_t sensorId, const std::vector<SensorBatchPlan> &plans);
     SensorHdiConnection &sensorHdiConnection_ = SensorHdiConnection::GetInstance();
+    SensorBatchScheduler &batchScheduler_ = SensorBatchScheduler::GetInstance();
     std::thread dataThread_;
     sptr<SensorDataProcesser> sensorDataProcesser_ = nullptr;
     sptr<ReportDataCallback> reportDataCallback_ = nullptr;
@@ -46,6 +46,7 @@ private:
     ErrCode EnableActiveInfoCBInner(MessageParcel &data, MessageParcel &reply);
     ErrCode DisableActiveInfoCBInner(MessageParcel &data, MessageParcel &reply);
     ErrCode ResetSensorsInner(MessageParcel &data, MessageParcel &reply);
+    ErrCode GetLatestDataInner(MessageParcel &data, MessageParcel &reply);
     bool IsSystemServiceCalling();
     int32_t ProcessRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option);
     bool IsSystemCalling();
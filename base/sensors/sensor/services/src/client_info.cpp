@@ -15,15 +15,13 @@
 
 #include "client_info.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include "permission_util.h"
 #include "securec.h"
 #include "sensor_errors.h"
 #include "sensor_manager.h"
-#ifdef HDF_DRIVERS_INTERFACE_SENSOR
-#include "sensor_hdi_connection.h"
-#endif // HDF_DRIVERS_INTERFACE_SENSOR
 
 #undef LOG_TAG
 #define LOG_TAG "ClientInfo"
@@ -39,7 +37,24 @@ constexpr int32_t INVALID_UID = -1;
 constexpr int32_t MIN_MAP_SIZE = 0;
 constexpr uint32_t NO_STORE_EVENT = -2;
 constexpr uint32_t MAX_SUPPORT_CHANNEL = 200;
-constexpr uint32_t MAX_DUMP_DATA_SIZE = 10;
+
+// Whether table is keyed by exactly the sensors of the list, excludedId left aside
+template<typename Table>
+bool HasSameSensors(const Table &table, const std::vector<Sensor> &sensors, int32_t excludedId)
+{
+    std::unordered_set<int32_t> sensorIds;
+    for (const auto &sensor : sensors) {
+        int32_t sensorId = sensor.GetSensorId();
+        if (sensorId == excludedId) {
+            continue;
+        }
+        if (table.find(sensorId) == table.end()) {
+            return false;
+        }
+        sensorIds.insert(sensorId);
+    }
+    return sensorIds.size() == table.size();
+}
 } // namespace
 
 std::unordered_map<std::string, std::set<int32_t>> ClientInfo::userGrantPermMap_ = {
@@ -237,20 +252,18 @@ bool ClientInfo::UpdateSensorInfo(int32_t sensorId, int32_t pid, const SensorBas
         return false;
     }
     std::lock_guard<std::mutex> clientLock(clientMutex_);
+    bool ret = true;
     auto it = clientMap_.find(sensorId);
     if (it == clientMap_.end()) {
         std::unordered_map<int32_t, SensorBasicInfo> pidMap;
         auto pidRet = pidMap.insert(std::make_pair(pid, sensorInfo));
         auto clientRet = clientMap_.insert(std::make_pair(sensorId, pidMap));
-        return pidRet.second && clientRet.second;
-    }
-    auto pidIt = it->second.find(pid);
-    if (pidIt == it->second.end()) {
-        auto ret = it->second.insert(std::make_pair(pid, sensorInfo));
-        return ret.second;
+        ret = pidRet.second && clientRet.second;
+    } else {
+        it->second[pid] = sensorInfo;
     }
-    it->second[pid] = sensorInfo;
-    return true;
+    UpdateSubscribePlan();
+    return ret;
 }
 
 void ClientInfo::RemoveSubscriber(int32_t sensorId, uint32_t pid)
@@ -264,6 +277,7 @@ void ClientInfo::RemoveSubscriber(int32_t sensorId, uint32_t pid)
     auto pidIt = it->second.find(pid);
     if (pidIt != it->second.end()) {
         it->second.erase(pidIt);
+        UpdateSubscribePlan();
     }
 }
 
@@ -284,9 +298,13 @@ bool ClientInfo::UpdateSensorChannel(int32_t pid, const sptr<SensorBasicDataChan
         }
         auto ret = channelMap_.insert(std::make_pair(pid, channel));
         SEN_HILOGD("ret.second:%{public}d", ret.second);
+        if (ret.second) {
+            channel->SetPid(pid);
+        }
         return ret.second;
     }
     channelMap_[pid] = channel;
+    channel->SetPid(pid);
     return true;
 }
 
@@ -304,6 +322,7 @@ void ClientInfo::ClearSensorInfo(int32_t sensorId)
         return;
     }
     clientMap_.erase(it);
+    UpdateSubscribePlan();
 }
 
 void ClientInfo::ClearCurPidSensorInfo(int32_t sensorId, int32_t pid)
@@ -328,6 +347,7 @@ void ClientInfo::ClearCurPidSensorInfo(int32_t sensorId, int32_t pid)
     if (it->second.size() == MIN_MAP_SIZE) {
         it = clientMap_.erase(it);
     }
+    UpdateSubscribePlan();
 }
 
 bool ClientInfo::DestroySensorChannel(int32_t pid)
@@ -351,6 +371,7 @@ bool ClientInfo::DestroySensorChannel(int32_t pid)
         }
         it = clientMap_.erase(it);
     }
+    UpdateSubscribePlan();
     DestroyAppThreadInfo(pid);
     std::lock_guard<std::mutex> channelLock(channelMutex_);
     auto it = channelMap_.find(pid);
@@ -389,66 +410,97 @@ SensorBasicInfo ClientInfo::GetCurPidSensorInfo(int32_t sensorId, int32_t pid)
     return sensorInfo;
 }
 
-uint64_t ClientInfo::ComputeBestPeriodCount(int32_t sensorId, sptr<SensorBasicDataChannel> &channel)
+void ClientInfo::UpdateSubscribePlan()
 {
-    if (sensorId == INVALID_SENSOR_ID || channel == nullptr) {
-        SEN_HILOGE("sensorId is invalid or channel cannot be null");
-        return 0UL;
-    }
-    int32_t pid = INVALID_PID;
-    {
-        std::lock_guard<std::mutex> channelLock(channelMutex_);
-        for (const auto &channelIt : channelMap_) {
-            if (channelIt.second == channel) {
-                pid = channelIt.first;
+    auto planMap = std::make_shared<SubscribePlanMap>();
+    for (const auto &sensorIt : clientMap_) {
+        int64_t bestSamplingPeriodNs = LLONG_MAX;
+        for (const auto &pidIt : sensorIt.second) {
+            bestSamplingPeriodNs = std::min(bestSamplingPeriodNs, pidIt.second.GetSamplingPeriodNs());
+        }
+        auto &pidPlanMap = (*planMap)[sensorIt.first];
+        for (const auto &pidIt : sensorIt.second) {
+            int64_t curSamplingPeriodNs = pidIt.second.GetSamplingPeriodNs();
+            int64_t curReportDelayNs = pidIt.second.GetMaxReportDelayNs();
+            SubscribePlan plan;
+            plan.samplingPeriodNs = curSamplingPeriodNs;
+            if (bestSamplingPeriodNs != 0L) {
+                int64_t periodCount = curSamplingPeriodNs / bestSamplingPeriodNs;
+                plan.periodCount = (periodCount <= 0L) ? 0UL : static_cast<uint64_t>(periodCount);
+            }
+            if (curSamplingPeriodNs != 0L) {
+                int64_t fifoCount = curReportDelayNs / curSamplingPeriodNs;
+                plan.fifoCount = (fifoCount <= 0L) ? 0UL : static_cast<uint64_t>(fifoCount);
             }
+            pidPlanMap[pidIt.first] = plan;
         }
     }
-    int64_t bestSamplingPeriod = GetBestSensorInfo(sensorId).GetSamplingPeriodNs();
-    int64_t curSamplingPeriod = GetCurPidSensorInfo(sensorId, pid).GetSamplingPeriodNs();
-    if (bestSamplingPeriod == 0L) {
-        SEN_HILOGE("Best sensor sampling period is 0");
-        return 0UL;
-    }
-    int64_t ret = curSamplingPeriod / bestSamplingPeriod;
-    return (ret <= 0L) ? 0UL : ret;
+    std::atomic_store(&subscribePlan_, std::shared_ptr<const SubscribePlanMap>(std::move(planMap)));
 }
 
-uint64_t ClientInfo::ComputeBestFifoCount(int32_t sensorId, sptr<SensorBasicDataChannel> &channel)
+bool ClientInfo::GetSubscribePlan(int32_t sensorId, const sptr<SensorBasicDataChannel> &channel, SubscribePlan &plan)
 {
-    if (channel == nullptr || sensorId == INVALID_SENSOR_ID) {
+    if (sensorId == INVALID_SENSOR_ID || channel == nullptr) {
         SEN_HILOGE("sensorId is invalid or channel cannot be null");
-        return 0UL;
+        return false;
     }
-    int32_t pid = INVALID_PID;
-    {
-        std::lock_guard<std::mutex> channelLock(channelMutex_);
-        for (const auto &channelIt : channelMap_) {
-            if (channelIt.second == channel) {
-                pid = channelIt.first;
-            }
-        }
+    int32_t pid = channel->GetPid();
+    auto planMap = std::atomic_load(&subscribePlan_);
+    auto sensorIt = planMap->find(sensorId);
+    if (sensorIt == planMap->end()) {
+        SEN_HILOGD("Subscribe plan not exist, sensorId:%{public}d", sensorId);
+        return false;
     }
-    int64_t curReportDelay = GetCurPidSensorInfo(sensorId, pid).GetMaxReportDelayNs();
-    int64_t curSamplingPeriod = GetCurPidSensorInfo(sensorId, pid).GetSamplingPeriodNs();
-    if (curSamplingPeriod == 0L) {
-        SEN_HILOGE("Best sensor fifo count is 0");
-        return 0UL;
+    auto pidIt = sensorIt->second.find(pid);
+    if (pidIt == sensorIt->second.end()) {
+        SEN_HILOGD("Subscribe plan not exist, sensorId:%{public}d", sensorId);
+        return false;
     }
-    int64_t ret = curReportDelay / curSamplingPeriod;
-    return (ret <= 0L) ? 0UL : ret;
+    plan = pidIt->second;
+    return true;
 }
 
-int32_t ClientInfo::GetStoreEvent(int32_t sensorId, SensorData &data)
+void ClientInfo::WriteStoredEvent(StoredEventSlot &slot, const SensorData *data)
+{
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    while ((sequence & 1U) != 0 ||
+        !slot.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire,
+            std::memory_order_relaxed)) {
+        sequence = slot.sequence.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    if (data != nullptr) {
+        slot.data = *data;
+        slot.stored = true;
+    } else {
+        slot.stored = false;
+    }
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool ClientInfo::ReadStoredEvent(const StoredEventSlot &slot, SensorData &data)
 {
-    std::lock_guard<std::mutex> lock(eventMutex_);
-    auto storedEvent = storedEvent_.find(sensorId);
-    if (storedEvent != storedEvent_.end()) {
-        errno_t ret = memcpy_s(&data, sizeof(data), &storedEvent->second, sizeof(storedEvent->second));
-        if (ret != EOK) {
-            SEN_HILOGE("memcpy_s failed, sensorId:%{public}d", sensorId);
-            return ret;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    bool stored = false;
+    do {
+        begin = slot.sequence.load(std::memory_order_acquire);
+        if ((begin & 1U) != 0) {
+            continue;
         }
+        stored = slot.stored;
+        data = slot.data;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        end = slot.sequence.load(std::memory_order_relaxed);
+    } while ((begin & 1U) != 0 || begin != end);
+    return stored;
+}
+
+int32_t ClientInfo::GetStoreEvent(int32_t sensorId, SensorData &data)
+{
+    auto storedEvent = std::atomic_load(&storedEvent_);
+    auto slotIt = storedEvent->find(sensorId);
+    if (slotIt != storedEvent->end() && ReadStoredEvent(*slotIt->second, data)) {
         return ERR_OK;
     }
 
@@ -458,37 +510,38 @@ int32_t ClientInfo::GetStoreEvent(int32_t sensorId, SensorData &data)
 
 void ClientInfo::StoreEvent(const SensorData &data)
 {
-    bool foundSensor = false;
-    SensorData storedEvent;
-    std::vector<Sensor> sensors;
-#ifdef HDF_DRIVERS_INTERFACE_SENSOR
-    auto sensorHdiConnection = &SensorHdiConnection::GetInstance();
-    if (sensorHdiConnection == nullptr) {
-        SEN_HILOGE("sensorHdiConnection cannot be null");
-        return;
-    }
-    int32_t ret = sensorHdiConnection->GetSensorList(sensors);
-    if (ret != 0) {
-        SEN_HILOGE("GetSensorList is failed");
+    auto storedEvent = std::atomic_load(&storedEvent_);
+    auto slotIt = storedEvent->find(data.sensorTypeId);
+    if (slotIt == storedEvent->end()) {
         return;
     }
-#endif // HDF_DRIVERS_INTERFACE_SENSOR
-    errno_t retVal = memcpy_s(&storedEvent, sizeof(storedEvent), &data, sizeof(data));
-    if (retVal != EOK) {
-        SEN_HILOGE("memcpy_s is failed");
+    WriteStoredEvent(*slotIt->second, &data);
+}
+
+void ClientInfo::UpdateStoredEventTable(const std::vector<Sensor> &sensors)
+{
+    std::lock_guard<std::mutex> sensorTableLock(sensorTableMutex_);
+    auto oldTable = std::atomic_load(&storedEvent_);
+    if (HasSameSensors(*oldTable, sensors, INVALID_SENSOR_ID)) {
         return;
     }
-    for (size_t i = 0; i < sensors.size(); i++) {
-        if (sensors[i].GetSensorId() == storedEvent.sensorTypeId) {
-            foundSensor = true;
-            break;
+    auto newTable = std::make_shared<StoredEventTable>();
+    for (const auto &sensor : sensors) {
+        int32_t sensorId = sensor.GetSensorId();
+        if (newTable->find(sensorId) != newTable->end()) {
+            continue;
         }
+        auto slot = std::make_unique<StoredEventSlot>();
+        auto oldIt = oldTable->find(sensorId);
+        if (oldIt != oldTable->end()) {
+            SensorData storedData;
+            if (ReadStoredEvent(*oldIt->second, storedData)) {
+                WriteStoredEvent(*slot, &storedData);
+            }
+        }
+        newTable->emplace(sensorId, std::move(slot));
     }
-
-    if (foundSensor) {
-        std::lock_guard<std::mutex> lock(eventMutex_);
-        storedEvent_[storedEvent.sensorTypeId] = storedEvent;
-    }
+    std::atomic_store(&storedEvent_, std::shared_ptr<const StoredEventTable>(std::move(newTable)));
 }
 
 bool ClientInfo::SaveClientPid(const sptr<IRemoteObject> &sensorClient, int32_t pid)
@@ -533,8 +586,10 @@ void ClientInfo::DestroyClientPid(const sptr<IRemoteObject> &sensorClient)
 
 void ClientInfo::ClearEvent()
 {
-    std::lock_guard<std::mutex> lock(eventMutex_);
-    storedEvent_.clear();
+    auto storedEvent = std::atomic_load(&storedEvent_);
+    for (const auto &slotIt : *storedEvent) {
+        WriteStoredEvent(*slotIt.second, nullptr);
+    }
 }
 
 std::vector<int32_t> ClientInfo::GetSensorIdByPid(int32_t pid)
@@ -559,13 +614,9 @@ AppThreadInfo ClientInfo::GetAppInfoByChannel(const sptr<SensorBasicDataChannel>
         SEN_HILOGE("channel is nullptr");
         return appThreadInfo;
     }
-    {
-        std::lock_guard<std::mutex> channelLock(channelMutex_);
-        for (auto channelIt = channelMap_.begin(); channelIt != channelMap_.end(); channelIt++) {
-            if (channelIt->second == channel) {
-                appThreadInfo.pid = channelIt->first;
-            }
-        }
+    int32_t pid = channel->GetPid();
+    if (pid > INVALID_PID) {
+        appThreadInfo.pid = pid;
     }
     {
         std::lock_guard<std::mutex> uidLock(uidMutex_);
@@ -607,6 +658,22 @@ void ClientInfo::GetSensorChannelInfo(std::vector<SensorChannelInfo> &channelInf
     }
 }
 
+void ClientInfo::GetDataChannelStats(std::vector<SensorChannelStats> &channelStats)
+{
+    std::vector<sptr<SensorBasicDataChannel>> channels;
+    {
+        std::lock_guard<std::mutex> channelLock(channelMutex_);
+        for (const auto &channelIt : channelMap_) {
+            channels.push_back(channelIt.second);
+        }
+    }
+    for (const auto &channel : channels) {
+        if (channel != nullptr) {
+            channelStats.push_back(channel->GetChannelStats());
+        }
+    }
+}
+
 int32_t ClientInfo::GetUidByPid(int32_t pid)
 {
     std::lock_guard<std::mutex> uidLock(uidMutex_);
@@ -671,36 +738,59 @@ std::vector<int32_t> ClientInfo::GetCmdList(int32_t sensorId, int32_t uid)
     return uidIt->second;
 }
 
-void ClientInfo::UpdateDataQueue(int32_t sensorId, SensorData &data)
+void ClientInfo::UpdateDumpRingTable(const std::vector<Sensor> &sensors)
 {
-    if (sensorId == SENSOR_TYPE_ID_HEART_RATE) {
+    std::lock_guard<std::mutex> sensorTableLock(sensorTableMutex_);
+    auto oldTable = std::atomic_load(&dumpRing_);
+    // Heart rate data is never kept for dump
+    if (HasSameSensors(*oldTable, sensors, SENSOR_TYPE_ID_HEART_RATE)) {
         return;
     }
-    std::lock_guard<std::mutex> queueLock(dataQueueMutex_);
-    auto it = dumpQueue_.find(sensorId);
-    if (it == dumpQueue_.end()) {
-        std::queue<SensorData> q;
-        q.push(data);
-        dumpQueue_.insert(std::make_pair(sensorId, q));
-        return;
+    auto newTable = std::make_shared<DumpRingTable>();
+    for (const auto &sensor : sensors) {
+        int32_t sensorId = sensor.GetSensorId();
+        if (sensorId == SENSOR_TYPE_ID_HEART_RATE || newTable->find(sensorId) != newTable->end()) {
+            continue;
+        }
+        auto oldIt = oldTable->find(sensorId);
+        if (oldIt != oldTable->end()) {
+            newTable->emplace(sensorId, oldIt->second);
+            continue;
+        }
+        newTable->emplace(sensorId, std::make_shared<SensorDumpRing>());
     }
-    it->second.push(data);
-    if (it->second.size() > MAX_DUMP_DATA_SIZE) {
-        it->second.pop();
+    std::atomic_store(&dumpRing_, std::shared_ptr<const DumpRingTable>(std::move(newTable)));
+}
+
+void ClientInfo::UpdateDataQueue(int32_t sensorId, const SensorData &data)
+{
+    auto dumpRing = std::atomic_load(&dumpRing_);
+    auto it = dumpRing->find(sensorId);
+    if (it == dumpRing->end()) {
+        return;
     }
+    it->second->Push(data);
 }
 
-std::unordered_map<int32_t, std::queue<SensorData>> ClientInfo::GetDumpQueue()
+std::unordered_map<int32_t, std::vector<SensorData>> ClientInfo::GetDumpQueue(int64_t beginNs, int64_t endNs)
 {
-    return dumpQueue_;
+    std::unordered_map<int32_t, std::vector<SensorData>> dumpQueue;
+    auto dumpRing = std::atomic_load(&dumpRing_);
+    for (const auto &it : *dumpRing) {
+        std::vector<SensorData> events;
+        if (it.second->Snapshot(events, beginNs, endNs) != 0) {
+            dumpQueue.emplace(it.first, std::move(events));
+        }
+    }
+    return dumpQueue;
 }
 
 void ClientInfo::ClearDataQueue(int32_t sensorId)
 {
-    std::lock_guard<std::mutex> queueLock(dataQueueMutex_);
-    auto it = dumpQueue_.find(sensorId);
-    if (it != dumpQueue_.end()) {
-        dumpQueue_.erase(it);
+    auto dumpRing = std::atomic_load(&dumpRing_);
+    auto it = dumpRing->find(sensorId);
+    if (it != dumpRing->end()) {
+        it->second->Clear();
     }
 }
 
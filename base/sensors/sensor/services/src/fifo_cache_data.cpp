@@ -14,41 +14,123 @@
  */
 
 #include "fifo_cache_data.h"
+
+#include <algorithm>
+#include <new>
+
 namespace OHOS {
 namespace Sensors {
 
-FifoCacheData::FifoCacheData() : periodCount_(0), channel_(nullptr)
+FifoCacheData::FifoCacheData() : periodCount_(0), channel_(nullptr), fifoCapacity_(0), fifoSize_(0)
 {}
 
 FifoCacheData::~FifoCacheData()
 {
-    fifoCacheData_.clear();
+    fifoCacheData_.reset();
 }
 
 void FifoCacheData::InitFifoCache()
 {
-    periodCount_ = 0;
-    fifoCacheData_.clear();
+    fifoSize_ = 0;
+}
+
+bool FifoCacheData::SelectSample(const SensorData &data, int64_t periodNs, uint64_t periodCount,
+    SensorData *average)
+{
+    if (average != nullptr) {
+        AccumulateSample(data);
+    }
+    int64_t timestamp = data.timestamp;
+    if (timestamp <= 0 || timestamp < lastTimestampNs_) {
+        // Without usable timestamps fall back to counting samples
+        periodCount_++;
+        if (periodCount > 1 && periodCount_ % periodCount != 0) {
+            return false;
+        }
+        periodCount_ = 0;
+    } else if (periodNs > 0) {
+        int64_t intervalNs = (lastTimestampNs_ == 0) ? 0 : timestamp - lastTimestampNs_;
+        lastTimestampNs_ = timestamp;
+        // The next sample is expected one interval later, deliver this one only if it is the closer of the two
+        if (nextDeliverNs_ != 0 && timestamp + intervalNs / 2 < nextDeliverNs_) {
+            return false;
+        }
+        // Stay on the grid started by the first sample so the rate does not drift, unless the stream stalled
+        if (nextDeliverNs_ == 0 || timestamp - nextDeliverNs_ >= periodNs) {
+            nextDeliverNs_ = timestamp + periodNs;
+        } else {
+            nextDeliverNs_ += periodNs;
+        }
+    }
+    if (average != nullptr) {
+        AverageSample(data, *average);
+    }
+    return true;
+}
+
+void FifoCacheData::AccumulateSample(const SensorData &data)
+{
+    size_t num = std::min(static_cast<size_t>(data.dataLen) / sizeof(float), sampleSum_.size());
+    const float *values = reinterpret_cast<const float *>(data.data);
+    for (size_t i = 0; i < num; ++i) {
+        sampleSum_[i] += values[i];
+    }
+    sampleNum_++;
+}
+
+void FifoCacheData::AverageSample(const SensorData &data, SensorData &average)
+{
+    average = data;
+    if (sampleNum_ > 1) {
+        size_t num = std::min(static_cast<size_t>(data.dataLen) / sizeof(float), sampleSum_.size());
+        float *values = reinterpret_cast<float *>(average.data);
+        for (size_t i = 0; i < num; ++i) {
+            values[i] = static_cast<float>(sampleSum_[i] / sampleNum_);
+        }
+    }
+    sampleSum_.fill(0.0);
+    sampleNum_ = 0;
+}
+
+bool FifoCacheData::ResizeFifoCache(size_t capacity)
+{
+    if (capacity > MAX_FIFO_CACHE_NUM) {
+        capacity = MAX_FIFO_CACHE_NUM;
+    }
+    if (capacity == fifoCapacity_) {
+        return true;
+    }
+    std::unique_ptr<SensorData[]> fifoCacheData(new (std::nothrow) SensorData[capacity]);
+    if (fifoCacheData == nullptr) {
+        return false;
+    }
+    fifoCacheData_ = std::move(fifoCacheData);
+    fifoCapacity_ = capacity;
+    fifoSize_ = 0;
+    return true;
 }
 
-void FifoCacheData::SetPeriodCount(uint64_t periodCount)
+size_t FifoCacheData::GetFifoCapacity() const
 {
-    periodCount_ = periodCount;
+    return fifoCapacity_;
 }
 
-uint64_t FifoCacheData::GetPeriodCount() const
+bool FifoCacheData::PushFifoCacheData(const SensorData &data)
 {
-    return periodCount_;
+    if (fifoSize_ < fifoCapacity_) {
+        fifoCacheData_[fifoSize_++] = data;
+    }
+    return fifoSize_ >= fifoCapacity_;
 }
 
-void FifoCacheData::SetFifoCacheData(const std::vector<SensorData> &fifoCacheData)
+const SensorData *FifoCacheData::GetFifoCacheData() const
 {
-    fifoCacheData_ = fifoCacheData;
+    return fifoCacheData_.get();
 }
 
-std::vector<SensorData> FifoCacheData::GetFifoCacheData() const
+size_t FifoCacheData::GetFifoCacheSize() const
 {
-    return fifoCacheData_;
+    return fifoSize_;
 }
 
 void FifoCacheData::SetChannel(const sptr<SensorBasicDataChannel> &channel)
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sensor_batch_scheduler.h"
+
+#include <cinttypes>
+
+#include "sensor_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "SensorBatchScheduler"
+
+namespace OHOS {
+namespace Sensors {
+using namespace OHOS::HiviewDFX;
+namespace {
+constexpr double NS_PER_SECOND = 1000000000.0;
+} // namespace
+
+std::vector<SensorBatchPlan> SensorBatchScheduler::UpdateSensor(int32_t sensorId, int64_t samplingPeriodNs,
+    int64_t maxReportDelayNs)
+{
+    std::lock_guard<std::mutex> planLock(planMutex_);
+    SensorBatchPlan &plan = plans_[sensorId];
+    plan.sensorId = sensorId;
+    plan.samplingPeriodNs = samplingPeriodNs;
+    plan.requestDelayNs = maxReportDelayNs;
+    plan.alignedDelayNs = maxReportDelayNs;
+    bool isBatched = IsBatched(plan);
+    AlignPlans();
+    if (!isBatched) {
+        return { plans_[sensorId] };
+    }
+    // Every batched sensor is set again in one pass, so that their FIFOs restart on the same tick
+    return GetBatchedPlans();
+}
+
+std::vector<SensorBatchPlan> SensorBatchScheduler::RemoveSensor(int32_t sensorId)
+{
+    std::lock_guard<std::mutex> planLock(planMutex_);
+    auto it = plans_.find(sensorId);
+    if (it == plans_.end()) {
+        return {};
+    }
+    bool isBatched = IsBatched(it->second);
+    plans_.erase(it);
+    int64_t lastTickNs = tickNs_;
+    AlignPlans();
+    if (!isBatched || tickNs_ == lastTickNs) {
+        return {};
+    }
+    // The tick grew, the remaining sensors may now wait longer
+    return GetBatchedPlans();
+}
+
+std::vector<SensorBatchPlan> SensorBatchScheduler::GetBatchPlans()
+{
+    std::lock_guard<std::mutex> planLock(planMutex_);
+    return GetBatchedPlans();
+}
+
+double SensorBatchScheduler::GetWakeupRate(bool isAligned)
+{
+    std::lock_guard<std::mutex> planLock(planMutex_);
+    return ComputeWakeupRate(isAligned);
+}
+
+bool SensorBatchScheduler::IsBatched(const SensorBatchPlan &plan) const
+{
+    return plan.samplingPeriodNs > 0 && plan.requestDelayNs >= plan.samplingPeriodNs;
+}
+
+void SensorBatchScheduler::AlignPlans()
+{
+    tickNs_ = 0;
+    for (const auto &it : plans_) {
+        if (IsBatched(it.second) && (tickNs_ == 0 || it.second.requestDelayNs < tickNs_)) {
+            tickNs_ = it.second.requestDelayNs;
+        }
+    }
+    for (auto &it : plans_) {
+        SensorBatchPlan &plan = it.second;
+        plan.alignedDelayNs = plan.requestDelayNs;
+        if (tickNs_ == 0 || !IsBatched(plan)) {
+            continue;
+        }
+        int64_t alignedDelayNs = plan.requestDelayNs / tickNs_ * tickNs_;
+        if (alignedDelayNs >= plan.samplingPeriodNs) {
+            plan.alignedDelayNs = alignedDelayNs;
+        }
+    }
+    SEN_HILOGD("tickNs:%{public}" PRId64 ", plan size:%{public}zu", tickNs_, plans_.size());
+}
+
+std::vector<SensorBatchPlan> SensorBatchScheduler::GetBatchedPlans() const
+{
+    std::vector<SensorBatchPlan> batchedPlans;
+    for (const auto &it : plans_) {
+        if (IsBatched(it.second)) {
+            batchedPlans.push_back(it.second);
+        }
+    }
+    return batchedPlans;
+}
+
+double SensorBatchScheduler::ComputeWakeupRate(bool isAligned) const
+{
+    double wakeupRate = 0.0;
+    bool hasTick = false;
+    for (const auto &it : plans_) {
+        const SensorBatchPlan &plan = it.second;
+        if (!IsBatched(plan)) {
+            continue;
+        }
+        // Aligned flushes coincide with the tick, only the sensors left out wake up on their own
+        if (isAligned && tickNs_ != 0 && plan.alignedDelayNs % tickNs_ == 0) {
+            hasTick = true;
+            continue;
+        }
+        int64_t delayNs = isAligned ? plan.alignedDelayNs : plan.requestDelayNs;
+        wakeupRate += NS_PER_SECOND / static_cast<double>(delayNs);
+    }
+    if (hasTick) {
+        wakeupRate += NS_PER_SECOND / static_cast<double>(tickNs_);
+    }
+    return wakeupRate;
+}
+} // namespace Sensors
+} // namespace OHOS
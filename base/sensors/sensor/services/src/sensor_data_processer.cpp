@@ -15,10 +15,15 @@
 
 #include "sensor_data_processer.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/prctl.h>
 #include <sys/socket.h>
 #include <thread>
+#include <unistd.h>
+#include <unordered_set>
 
 #include "hisysevent.h"
 #include "permission_util.h"
@@ -36,150 +41,203 @@ using namespace OHOS::HiviewDFX;
 
 namespace {
 const std::string SENSOR_REPORT_THREAD_NAME = "OS_SenProducer";
+const std::string SENSOR_DISPATCH_THREAD_NAME = "OS_SenDispatch";
+const std::string SENSOR_FLUSH_THREAD_NAME = "OS_SenFlush";
+constexpr int32_t MAX_FLUSH_EVENT_NUM = 16;
+constexpr int32_t FLUSH_SWEEP_INTERVAL_MS = 1000;
+// Events queued for one dispatch thread, newer events are dropped beyond it
+constexpr size_t MAX_PENDING_EVENT_NUM = CIRCULAR_BUF_LEN * 4;
+#ifdef OHOS_BUILD_ENABLE_DECIMATION_FILTER
+// Continuous vector sensors whose samples are averaged between two delivered ones to avoid aliasing
+const std::unordered_set<int32_t> AVERAGE_SENSOR_IDS = {
+    SENSOR_TYPE_ID_ACCELEROMETER, SENSOR_TYPE_ID_GYROSCOPE, SENSOR_TYPE_ID_MAGNETIC_FIELD, SENSOR_TYPE_ID_GRAVITY,
+    SENSOR_TYPE_ID_LINEAR_ACCELERATION, SENSOR_TYPE_ID_ACCELEROMETER_UNCALIBRATED,
+    SENSOR_TYPE_ID_GYROSCOPE_UNCALIBRATED, SENSOR_TYPE_ID_MAGNETIC_FIELD_UNCALIBRATED
+};
+
+bool IsAverageSensor(int32_t sensorId)
+{
+    return AVERAGE_SENSOR_IDS.find(sensorId) != AVERAGE_SENSOR_IDS.end();
+}
+#endif // OHOS_BUILD_ENABLE_DECIMATION_FILTER
 } // namespace
 
-SensorDataProcesser::SensorDataProcesser(const std::unordered_map<int32_t, Sensor> &sensorMap)
+SensorDataProcesser::SensorDataProcesser(const std::unordered_map<int32_t, Sensor> &sensorMap, size_t shardNum)
 {
     sensorMap_.insert(sensorMap.begin(), sensorMap.end());
-    SEN_HILOGD("sensorMap_.size:%{public}d", int32_t { sensorMap_.size() });
+    drainEvents_.resize(CIRCULAR_BUF_LEN);
+    shardNum = std::clamp(shardNum, static_cast<size_t>(1), MAX_DISPATCH_SHARD_NUM);
+    for (size_t i = 0; i < shardNum; ++i) {
+        auto shard = std::make_unique<DispatchShard>();
+        shard->pendingEvents.reserve(CIRCULAR_BUF_LEN);
+        shard->dispatchEvents.reserve(CIRCULAR_BUF_LEN);
+        shards_.push_back(std::move(shard));
+    }
+    if (shardNum > 1) {
+        for (auto &shard : shards_) {
+            shard->worker = std::thread(&SensorDataProcesser::DispatchThread, this, std::ref(*shard));
+        }
+    }
+    InitFlushThread();
+    SEN_HILOGD("sensorMap_.size:%{public}d, shardNum:%{public}zu", int32_t { sensorMap_.size() }, shardNum);
+}
+
+void SensorDataProcesser::InitFlushThread()
+{
+    flushEpollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    flushStopFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((flushEpollFd_ < 0) || (flushStopFd_ < 0)) {
+        SEN_HILOGE("Create flush fd failed, errno:%{public}d", errno);
+        ReleaseFlushThread();
+        return;
+    }
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = flushStopFd_;
+    if (epoll_ctl(flushEpollFd_, EPOLL_CTL_ADD, flushStopFd_, &event) != 0) {
+        SEN_HILOGE("Watch stop fd failed, errno:%{public}d", errno);
+        ReleaseFlushThread();
+        return;
+    }
+    flushThread_ = std::thread(&SensorDataProcesser::FlushThread, this);
+}
+
+void SensorDataProcesser::ReleaseFlushThread()
+{
+    if (flushThread_.joinable()) {
+        eventfd_write(flushStopFd_, 1);
+        flushThread_.join();
+    }
+    if (flushEpollFd_ >= 0) {
+        close(flushEpollFd_);
+        flushEpollFd_ = -1;
+    }
+    if (flushStopFd_ >= 0) {
+        close(flushStopFd_);
+        flushStopFd_ = -1;
+    }
+    std::lock_guard<std::mutex> flushLock(flushMutex_);
+    flushChannels_.clear();
 }
 
 SensorDataProcesser::~SensorDataProcesser()
 {
-    dataCountMap_.clear();
+    for (auto &shard : shards_) {
+        {
+            std::lock_guard<std::mutex> queueLock(shard->queueMutex);
+            shard->stop = true;
+        }
+        shard->queueCondition.notify_one();
+    }
+    for (auto &shard : shards_) {
+        if (shard->worker.joinable()) {
+            shard->worker.join();
+        }
+    }
+    shards_.clear();
+    ReleaseFlushThread();
     sensorMap_.clear();
 }
 
-void SensorDataProcesser::SendNoneFifoCacheData(std::unordered_map<int32_t, SensorData> &cacheBuf,
-                                                sptr<SensorBasicDataChannel> &channel, SensorData &data,
-                                                uint64_t periodCount)
+sptr<FifoCacheData> SensorDataProcesser::GetFifoCacheData(DispatchShard &shard,
+                                                         const sptr<SensorBasicDataChannel> &channel, int32_t sensorId)
 {
-    std::vector<SensorData> sendEvents;
-    std::lock_guard<std::mutex> dataCountLock(dataCountMutex_);
-    sendEvents.push_back(data);
-    auto dataCountIt = dataCountMap_.find(data.sensorTypeId);
-    if (dataCountIt == dataCountMap_.end()) {
-        std::vector<sptr<FifoCacheData>> channelFifoList;
-        sptr<FifoCacheData> fifoCacheData = new (std::nothrow) FifoCacheData();
-        CHKPV(fifoCacheData);
-        fifoCacheData->SetChannel(channel);
-        channelFifoList.push_back(fifoCacheData);
-        dataCountMap_.insert(std::make_pair(data.sensorTypeId, channelFifoList));
-        SendRawData(cacheBuf, channel, sendEvents);
-        return;
-    }
-    bool channelExist = false;
-    for (auto fifoIt = dataCountIt->second.begin(); fifoIt != dataCountIt->second.end();) {
-        auto fifoCacheData = *fifoIt;
-        CHKPC(fifoCacheData);
-        auto fifoChannel = fifoCacheData->GetChannel();
+    auto &channelFifoList = shard.dataCountMap[sensorId];
+    for (auto fifoIt = channelFifoList.begin(); fifoIt != channelFifoList.end();) {
+        auto fifoChannel = (*fifoIt == nullptr) ? nullptr : (*fifoIt)->GetChannel();
         if (fifoChannel == nullptr) {
-            fifoIt = dataCountIt->second.erase(fifoIt);
-            continue;
-        }
-        ++fifoIt;
-        if (fifoChannel != channel) {
+            fifoIt = channelFifoList.erase(fifoIt);
             continue;
         }
-        channelExist = true;
-        uint64_t curCount = fifoCacheData->GetPeriodCount();
-        curCount++;
-        fifoCacheData->SetPeriodCount(curCount);
-        if (periodCount != 0 && fifoCacheData->GetPeriodCount() % periodCount != 0UL) {
-            continue;
+        if (fifoChannel == channel) {
+            return *fifoIt;
         }
-        SendRawData(cacheBuf, channel, sendEvents);
-        fifoCacheData->SetPeriodCount(0);
-        return;
+        ++fifoIt;
     }
-    if (!channelExist) {
-        sptr<FifoCacheData> fifoCacheData = new (std::nothrow) FifoCacheData();
-        CHKPV(fifoCacheData);
-        fifoCacheData->SetChannel(channel);
-        dataCountIt->second.push_back(fifoCacheData);
-        SendRawData(cacheBuf, channel, sendEvents);
+    sptr<FifoCacheData> fifoCacheData = new (std::nothrow) FifoCacheData();
+    CHKPP(fifoCacheData);
+    fifoCacheData->SetChannel(channel);
+    channelFifoList.push_back(fifoCacheData);
+    return fifoCacheData;
+}
+
+const SensorData *SensorDataProcesser::SelectSample(const sptr<FifoCacheData> &fifoData, const SensorData &data,
+                                                    const SubscribePlan &plan, SensorData &average)
+{
+    SensorData *averagePtr = nullptr;
+#ifdef OHOS_BUILD_ENABLE_DECIMATION_FILTER
+    if (IsAverageSensor(data.sensorTypeId)) {
+        averagePtr = &average;
+    }
+#endif // OHOS_BUILD_ENABLE_DECIMATION_FILTER
+    if (!fifoData->SelectSample(data, plan.samplingPeriodNs, plan.periodCount, averagePtr)) {
+        return nullptr;
+    }
+    return (averagePtr == nullptr) ? &data : averagePtr;
+}
+
+void SensorDataProcesser::SendNoneFifoCacheData(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel,
+                                                SensorData &data, const SubscribePlan &plan)
+{
+    auto fifoData = GetFifoCacheData(shard, channel, data.sensorTypeId);
+    CHKPV(fifoData);
+    SensorData average;
+    const SensorData *sample = SelectSample(fifoData, data, plan, average);
+    if (sample != nullptr) {
+        SendRawData(shard, channel, sample, 1);
     }
 }
 
-void SensorDataProcesser::SendFifoCacheData(std::unordered_map<int32_t, SensorData> &cacheBuf,
-                                            sptr<SensorBasicDataChannel> &channel, SensorData &data,
-                                            uint64_t periodCount, uint64_t fifoCount)
+void SensorDataProcesser::SendFifoCacheData(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel,
+                                            SensorData &data, const SubscribePlan &plan)
 {
-    std::lock_guard<std::mutex> dataCountLock(dataCountMutex_);
-    auto dataCountIt = dataCountMap_.find(data.sensorTypeId);
-    // there is no channelFifoList
-    if (dataCountIt == dataCountMap_.end()) {
-        std::vector<sptr<FifoCacheData>> channelFifoList;
-        sptr<FifoCacheData> fifoCacheData = new (std::nothrow) FifoCacheData();
-        CHKPV(fifoCacheData);
-        fifoCacheData->SetChannel(channel);
-        channelFifoList.push_back(fifoCacheData);
-        dataCountMap_.insert(std::make_pair(data.sensorTypeId, channelFifoList));
+    auto fifoData = GetFifoCacheData(shard, channel, data.sensorTypeId);
+    CHKPV(fifoData);
+    SensorData average;
+    const SensorData *sample = SelectSample(fifoData, data, plan, average);
+    if (sample == nullptr) {
         return;
     }
-    // find channel in channelFifoList
-    bool channelExist = false;
-    for (auto fifoIt = dataCountIt->second.begin(); fifoIt != dataCountIt->second.end();) {
-        auto fifoData = *fifoIt;
-        CHKPC(fifoData);
-        auto fifoChannel = fifoData->GetChannel();
-        if (fifoChannel == nullptr) {
-            fifoIt = dataCountIt->second.erase(fifoIt);
-            continue;
+    uint64_t fifoCount = plan.fifoCount;
+    if (fifoData->GetFifoCapacity() != std::min(fifoCount, static_cast<uint64_t>(MAX_FIFO_CACHE_NUM))) {
+        // Batch parameters changed, deliver what was cached for the old ones first
+        if (fifoData->GetFifoCacheSize() != 0) {
+            SendRawData(shard, channel, fifoData->GetFifoCacheData(), fifoData->GetFifoCacheSize());
         }
-        ++fifoIt;
-        if (fifoChannel != channel) {
-            continue;
+        if (!fifoData->ResizeFifoCache(fifoCount)) {
+            SEN_HILOGE("Resize fifo cache failed, fifoCount:%{public}" PRIu64, fifoCount);
+            SendRawData(shard, channel, sample, 1);
+            return;
         }
-        channelExist = true;
-        uint64_t curCount = fifoData->GetPeriodCount();
-        curCount++;
-        fifoData->SetPeriodCount(curCount);
-        if (fifoData->GetPeriodCount() % periodCount != 0UL) {
-            continue;
-        }
-        fifoData->SetPeriodCount(0);
-        std::vector<SensorData> fifoDataList = fifoData->GetFifoCacheData();
-        fifoDataList.push_back(data);
-        fifoData->SetFifoCacheData(fifoDataList);
-        if ((fifoData->GetFifoCacheData()).size() != fifoCount) {
-            continue;
-        }
-        SendRawData(cacheBuf, channel, fifoData->GetFifoCacheData());
-        fifoData->InitFifoCache();
-        return;
     }
-    // cannot find channel in channelFifoList
-    if (!channelExist) {
-        sptr<FifoCacheData> fifoCacheData = new (std::nothrow) FifoCacheData();
-        CHKPV(fifoCacheData);
-        fifoCacheData->SetChannel(channel);
-        dataCountIt->second.push_back(fifoCacheData);
+    if (!fifoData->PushFifoCacheData(*sample)) {
+        return;
     }
+    SendRawData(shard, channel, fifoData->GetFifoCacheData(), fifoData->GetFifoCacheSize());
+    fifoData->InitFifoCache();
 }
 
-void SensorDataProcesser::ReportData(sptr<SensorBasicDataChannel> &channel, SensorData &data)
+void SensorDataProcesser::ReportData(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel, SensorData &data)
 {
     CHKPV(channel);
     int32_t sensorId = data.sensorTypeId;
-    auto &cacheBuf = const_cast<std::unordered_map<int32_t, SensorData> &>(channel->GetDataCacheBuf());
-    if (ReportNotContinuousData(cacheBuf, channel, data)) {
+    if (ReportNotContinuousData(shard, channel, data)) {
         return;
     }
-    uint64_t periodCount = clientInfo_.ComputeBestPeriodCount(sensorId, channel);
-    if (periodCount == 0UL) {
+    SubscribePlan plan;
+    if (!clientInfo_.GetSubscribePlan(sensorId, channel, plan) || plan.periodCount == 0UL) {
         return;
     }
-    auto fifoCount = clientInfo_.ComputeBestFifoCount(sensorId, channel);
-    if (fifoCount <= 1) {
-        SendNoneFifoCacheData(cacheBuf, channel, data, periodCount);
+    // Samples of a hardware FIFO batch already waited in the chip for the report latency, do not hold them again
+    if (plan.fifoCount <= 1 || (data.flags & SENSOR_DATA_FLAG_HW_BATCH) != 0) {
+        SendNoneFifoCacheData(shard, channel, data, plan);
         return;
     }
-    SendFifoCacheData(cacheBuf, channel, data, periodCount, fifoCount);
+    SendFifoCacheData(shard, channel, data, plan);
 }
 
-bool SensorDataProcesser::ReportNotContinuousData(std::unordered_map<int32_t, SensorData> &cacheBuf,
-                                                  sptr<SensorBasicDataChannel> &channel, SensorData &data)
+bool SensorDataProcesser::ReportNotContinuousData(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel,
+                                                  SensorData &data)
 {
     int32_t sensorId = data.sensorTypeId;
     std::lock_guard<std::mutex> sensorLock(sensorMutex_);
@@ -191,109 +249,245 @@ bool SensorDataProcesser::ReportNotContinuousData(std::unordered_map<int32_t, Se
     sensor->second.SetFlags(data.mode);
     if (((SENSOR_ON_CHANGE & sensor->second.GetFlags()) == SENSOR_ON_CHANGE) ||
         ((SENSOR_ONE_SHOT & sensor->second.GetFlags()) == SENSOR_ONE_SHOT)) {
-        std::vector<SensorData> sendEvents;
-        sendEvents.push_back(data);
-        SendRawData(cacheBuf, channel, sendEvents);
+        SendRawData(shard, channel, &data, 1);
         return true;
     }
     return false;
 }
 
-void SensorDataProcesser::SendRawData(std::unordered_map<int32_t, SensorData> &cacheBuf,
-                                      sptr<SensorBasicDataChannel> channel, std::vector<SensorData> events)
+void SensorDataProcesser::SendRawData(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel,
+                                      const SensorData *events, size_t num)
 {
     CHKPV(channel);
-    if (events.empty()) {
+    CHKPV(events);
+    if (num == 0) {
         return;
     }
-    size_t eventSize = events.size();
-    auto ret = channel->SendData(events.data(), eventSize * sizeof(SensorData));
-    if (ret != ERR_OK) {
-        SEN_HILOGE("Send data failed, ret:%{public}d, sensorId:%{public}d, timestamp:%{public}" PRId64,
-            ret, events[eventSize - 1].sensorTypeId, events[eventSize - 1].timestamp);
-        int32_t sensorId = events[eventSize - 1].sensorTypeId;
-        cacheBuf[sensorId] = events[eventSize - 1];
+    auto &batch = shard.channelBatches[channel.GetRefPtr()];
+    if (batch.channel == nullptr) {
+        batch.channel = channel;
     }
+    batch.events.insert(batch.events.end(), events, events + num);
 }
 
-int32_t SensorDataProcesser::CacheSensorEvent(const SensorData &data, sptr<SensorBasicDataChannel> &channel)
+void SensorDataProcesser::FlushChannelBatches(DispatchShard &shard)
 {
-    CHKPR(channel, INVALID_POINTER);
-    int32_t ret = ERR_OK;
-    auto &cacheBuf = const_cast<std::unordered_map<int32_t, SensorData> &>(channel->GetDataCacheBuf());
-    int32_t sensorId = data.sensorTypeId;
-    auto cacheEvent = cacheBuf.find(sensorId);
-    if (cacheEvent != cacheBuf.end()) {
-        // Try to send the last failed value, if it still fails, replace the previous cache directly
-        const SensorData &cacheData = cacheEvent->second;
-        ret = channel->SendData(&cacheData, sizeof(SensorData));
-        if (ret != ERR_OK) {
-            SEN_HILOGE("retry send cache data failed, ret:%{public}d, sensorId:%{public}d, timestamp:%{public}" PRId64,
-                ret, cacheData.sensorTypeId, cacheData.timestamp);
+    for (auto it = shard.channelBatches.begin(); it != shard.channelBatches.end();) {
+        auto &batch = it->second;
+        if (batch.events.empty()) {
+            it = shard.channelBatches.erase(it);
+            continue;
         }
-        ret = channel->SendData(&data, sizeof(SensorData));
-        if (ret != ERR_OK) {
-            SEN_HILOGE("retry send data failed, ret:%{public}d, sensorId:%{public}d, timestamp:%{public}" PRId64,
-                ret, data.sensorTypeId, data.timestamp);
-            cacheBuf[sensorId] = data;
-        } else {
-            cacheBuf.erase(cacheEvent);
+        size_t eventSize = batch.events.size();
+        bool hasPending = false;
+        auto ret = batch.channel->SendOrQueueData(batch.events.data(), eventSize, hasPending);
+        if (hasPending) {
+            // The client is congested, the rest goes out in order once its socket becomes writable
+            RequestFlush(batch.channel);
+        } else if (ret != ERR_OK) {
+            SEN_HILOGE("Send data failed, ret:%{public}d, total:%{public}zu, sensorId:%{public}d, "
+                "timestamp:%{public}" PRId64, ret, eventSize, batch.events[eventSize - 1].sensorTypeId,
+                batch.events[eventSize - 1].timestamp);
         }
-    } else {
-        ret = channel->SendData(&data, sizeof(SensorData));
-        if (ret != ERR_OK) {
-            SEN_HILOGE("directly retry failed, ret:%{public}d, sensorId:%{public}d, timestamp:%{public}" PRId64,
-                ret, data.sensorTypeId, data.timestamp);
-            cacheBuf[sensorId] = data;
+        batch.events.clear();
+        ++it;
+    }
+}
+
+void SensorDataProcesser::RequestFlush(const sptr<SensorBasicDataChannel> &channel)
+{
+    CHKPV(channel);
+    int32_t sendFd = channel->GetSendDataFd();
+    if (sendFd < 0) {
+        channel->ClearPendingData();
+        return;
+    }
+    std::lock_guard<std::mutex> flushLock(flushMutex_);
+    auto flushIt = flushChannels_.find(sendFd);
+    if ((flushIt != flushChannels_.end()) && (flushIt->second == channel)) {
+        return;
+    }
+    if (flushEpollFd_ >= 0) {
+        struct epoll_event event = {};
+        event.events = EPOLLOUT | EPOLLONESHOT;
+        event.data.fd = sendFd;
+        if ((epoll_ctl(flushEpollFd_, EPOLL_CTL_ADD, sendFd, &event) == 0) ||
+            ((errno == EEXIST) && (epoll_ctl(flushEpollFd_, EPOLL_CTL_MOD, sendFd, &event) == 0))) {
+            flushChannels_[sendFd] = channel;
+            return;
+        }
+        SEN_HILOGE("Watch channel failed, errno:%{public}d", errno);
+    }
+    bool hasPending = false;
+    channel->FlushPendingData(hasPending);
+}
+
+void SensorDataProcesser::SweepFlushChannels()
+{
+    std::lock_guard<std::mutex> flushLock(flushMutex_);
+    for (auto it = flushChannels_.begin(); it != flushChannels_.end();) {
+        // The fd was closed with the channel, which also removed it from the epoll set
+        if (it->second->GetSendDataFd() != it->first) {
+            it->second->ClearPendingData();
+            it = flushChannels_.erase(it);
+            continue;
         }
+        ++it;
     }
-    return ret;
 }
 
-void SensorDataProcesser::EventFilter(CircularEventBuf &eventsBuf)
+void SensorDataProcesser::FlushThread()
 {
-    int32_t sensorId = eventsBuf.circularBuf[eventsBuf.readPos].sensorTypeId;
-    std::vector<sptr<SensorBasicDataChannel>> channelList = clientInfo_.GetSensorChannel(sensorId);
-    for (auto &channel : channelList) {
+    prctl(PR_SET_NAME, SENSOR_FLUSH_THREAD_NAME.c_str());
+    struct epoll_event events[MAX_FLUSH_EVENT_NUM];
+    while (true) {
+        int32_t eventNum = epoll_wait(flushEpollFd_, events, MAX_FLUSH_EVENT_NUM, FLUSH_SWEEP_INTERVAL_MS);
+        if ((eventNum < 0) && (errno != EINTR)) {
+            SEN_HILOGE("epoll_wait failed, errno:%{public}d", errno);
+            return;
+        }
+        if (eventNum <= 0) {
+            SweepFlushChannels();
+            continue;
+        }
+        for (int32_t i = 0; i < eventNum; ++i) {
+            if (events[i].data.fd == flushStopFd_) {
+                return;
+            }
+            sptr<SensorBasicDataChannel> channel = nullptr;
+            {
+                std::lock_guard<std::mutex> flushLock(flushMutex_);
+                auto flushIt = flushChannels_.find(events[i].data.fd);
+                if (flushIt == flushChannels_.end()) {
+                    continue;
+                }
+                channel = flushIt->second;
+                flushChannels_.erase(flushIt);
+            }
+            if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0) {
+                SEN_HILOGW("Client of pid:%{public}d is gone, drop pending data", channel->GetPid());
+                channel->ClearPendingData();
+                continue;
+            }
+            bool hasPending = false;
+            channel->FlushPendingData(hasPending);
+            if (hasPending) {
+                RequestFlush(channel);
+            }
+        }
+    }
+}
+
+void SensorDataProcesser::EventFilter(DispatchShard &shard, SensorData &event)
+{
+    auto channelIt = shard.cycleChannels.find(event.sensorTypeId);
+    if (channelIt == shard.cycleChannels.end()) {
+        channelIt = shard.cycleChannels.emplace(event.sensorTypeId,
+            clientInfo_.GetSensorChannel(event.sensorTypeId)).first;
+    }
+    for (auto &channel : channelIt->second) {
         if (channel->GetSensorStatus()) {
-            SendEvents(channel, eventsBuf.circularBuf[eventsBuf.readPos]);
+            SendEvents(shard, channel, event);
         }
     }
 }
 
+void SensorDataProcesser::DispatchEvents(DispatchShard &shard, SensorData *events, size_t num)
+{
+    for (size_t i = 0; i < num; i++) {
+        // Recorded once per event, the shard owning the sensor is the only writer of its dump ring
+        clientInfo_.UpdateDataQueue(events[i].sensorTypeId, events[i]);
+        EventFilter(shard, events[i]);
+    }
+    FlushChannelBatches(shard);
+    shard.cycleChannels.clear();
+}
+
+void SensorDataProcesser::PostEvents(const SensorData *events, size_t num)
+{
+    size_t shardNum = shards_.size();
+    for (size_t index = 0; index < shardNum; ++index) {
+        auto &shard = *shards_[index];
+        size_t postNum = 0;
+        uint64_t dropNum = 0;
+        {
+            std::lock_guard<std::mutex> queueLock(shard.queueMutex);
+            for (size_t i = 0; i < num; ++i) {
+                if (static_cast<uint32_t>(events[i].sensorTypeId) % shardNum != index) {
+                    continue;
+                }
+                if (shard.pendingEvents.size() >= MAX_PENDING_EVENT_NUM) {
+                    ++dropNum;
+                    continue;
+                }
+                shard.pendingEvents.push_back(events[i]);
+                ++postNum;
+            }
+            shard.dropCount += dropNum;
+        }
+        if (dropNum != 0) {
+            SEN_HILOGW("Dispatch shard:%{public}zu is busy, dropped:%{public}" PRIu64 ", total dropped:%{public}"
+                PRIu64, index, dropNum, shard.dropCount);
+        }
+        if (postNum != 0) {
+            shard.queueCondition.notify_one();
+        }
+    }
+}
+
+void SensorDataProcesser::DispatchThread(DispatchShard &shard)
+{
+    prctl(PR_SET_NAME, SENSOR_DISPATCH_THREAD_NAME.c_str());
+    while (true) {
+        {
+            std::unique_lock<std::mutex> queueLock(shard.queueMutex);
+            shard.queueCondition.wait(queueLock, [&shard] { return shard.stop || !shard.pendingEvents.empty(); });
+            if (shard.pendingEvents.empty()) {
+                break;
+            }
+            shard.dispatchEvents.swap(shard.pendingEvents);
+        }
+        DispatchEvents(shard, shard.dispatchEvents.data(), shard.dispatchEvents.size());
+        shard.dispatchEvents.clear();
+    }
+}
+
+void SensorDataProcesser::CheckEventOverflow(sptr<ReportDataCallback> dataCallback)
+{
+    uint64_t overflowCount = dataCallback->GetOverflowCount();
+    if (overflowCount != lastOverflowCount_) {
+        SEN_HILOGW("Event ring overflow, dropped:%{public}" PRIu64 ", total dropped:%{public}" PRIu64,
+            overflowCount - lastOverflowCount_, overflowCount);
+        lastOverflowCount_ = overflowCount;
+    }
+}
+
 int32_t SensorDataProcesser::ProcessEvents(sptr<ReportDataCallback> dataCallback)
 {
     CHKPR(dataCallback, INVALID_POINTER);
-    std::unique_lock<std::mutex> lk(ISensorHdiConnection::dataMutex_);
-    ISensorHdiConnection::dataCondition_.wait(lk);
-    auto &eventsBuf = dataCallback->GetEventData();
-    if (eventsBuf.eventNum <= 0) {
-        SEN_HILOGE("Data cannot be empty");
+    if (dataCallback->WaitEvents() != ERR_OK) {
+        SEN_HILOGE("Wait events failed");
+        return INVALID_POINTER;
+    }
+    size_t eventNum = dataCallback->PopEvents(drainEvents_.data(), drainEvents_.size());
+    CheckEventOverflow(dataCallback);
+    if (eventNum == 0) {
+        SEN_HILOGD("Data is empty");
         return NO_EVENT;
     }
-    int32_t eventNum = eventsBuf.eventNum;
-    for (int32_t i = 0; i < eventNum; i++) {
-        EventFilter(eventsBuf);
-
-        eventsBuf.readPos++;
-        if (eventsBuf.readPos == CIRCULAR_BUF_LEN) {
-            eventsBuf.readPos = 0;
-        }
-        eventsBuf.eventNum--;
+    if (shards_.size() == 1) {
+        DispatchEvents(*shards_[0], drainEvents_.data(), eventNum);
+    } else {
+        PostEvents(drainEvents_.data(), eventNum);
     }
     return SUCCESS;
 }
 
-int32_t SensorDataProcesser::SendEvents(sptr<SensorBasicDataChannel> &channel, SensorData &data)
+int32_t SensorDataProcesser::SendEvents(DispatchShard &shard, sptr<SensorBasicDataChannel> &channel,
+                                        SensorData &data)
 {
     CHKPR(channel, INVALID_POINTER);
-    clientInfo_.UpdateDataQueue(data.sensorTypeId, data);
-    auto &cacheBuf = channel->GetDataCacheBuf();
-    if (cacheBuf.empty()) {
-        ReportData(channel, data);
-    } else {
-        CacheSensorEvent(data, channel);
-    }
+    ReportData(shard, channel, data);
     clientInfo_.StoreEvent(data);
     return SUCCESS;
 }
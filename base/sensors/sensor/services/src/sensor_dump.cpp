@@ -17,13 +17,18 @@
 
 #include <getopt.h>
 
+#include <algorithm>
+#include <cerrno>
 #include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
-#include <queue>
+#include <sys/stat.h>
 
 #include "securec.h"
 #include "sensor_agent_type.h"
+#include "sensor_batch_scheduler.h"
 #include "sensor_errors.h"
 
 #undef LOG_TAG
@@ -36,6 +41,21 @@ namespace {
 constexpr int32_t MAX_DUMP_PARAMETERS = 32;
 #ifdef BUILD_VARIANT_ENG
 constexpr uint32_t MAX_DUMP_DATA_SIZE = 10;
+constexpr int64_t MAX_EXPORT_WINDOW_S = 60;
+constexpr int64_t SECOND_NS = 1000000000;
+constexpr uint32_t EXPORT_FILE_VERSION = 1;
+const char *EXPORT_FILE_DIR = "/data/log/sensor";
+const char *EXPORT_FILE_PATH = "/data/log/sensor/sensor_data_export.bin";
+
+// Header of the export file, followed by recordNum SensorData records in native layout, grouped by sensor
+struct ExportFileHeader {
+    char magic[4] { 'S', 'D', 'M', 'P' };
+    uint32_t version { EXPORT_FILE_VERSION };
+    uint32_t recordSize { sizeof(SensorData) };
+    uint32_t recordNum { 0 };
+    int64_t beginNs { 0 };
+    int64_t endNs { 0 };
+};
 #endif // BUILD_VARIANT_ENG
 constexpr uint32_t MS_NS = 1000000;
 
@@ -96,6 +116,7 @@ void SensorDump::RunSensorDump(int32_t fd, int32_t optionIndex, const std::vecto
         {"channel", no_argument, 0, 'c'},
 #ifdef BUILD_VARIANT_ENG
         {"data", no_argument, 0, 'd'},
+        {"export", required_argument, 0, 'e'},
 #endif // BUILD_VARIANT_ENG
         {"open", no_argument, 0, 'o'},
         {"help", no_argument, 0, 'h'},
@@ -104,7 +125,7 @@ void SensorDump::RunSensorDump(int32_t fd, int32_t optionIndex, const std::vecto
     };
     optind = 1;
     int32_t c;
-    while ((c = getopt_long(args.size(), argv, "cdohl", dumpOptions, &optionIndex)) != -1) {
+    while ((c = getopt_long(args.size(), argv, "cde:ohl", dumpOptions, &optionIndex)) != -1) {
         switch (c) {
             case 'c': {
                 DumpSensorChannel(fd, clientInfo_);
@@ -115,6 +136,10 @@ void SensorDump::RunSensorDump(int32_t fd, int32_t optionIndex, const std::vecto
                 DumpSensorData(fd, clientInfo_);
                 break;
             }
+            case 'e': {
+                ExportSensorData(fd, clientInfo_, std::strtoll(optarg, nullptr, 0));
+                break;
+            }
 #endif // BUILD_VARIANT_ENG
             case 'o': {
                 DumpOpeningSensor(fd, sensors_, clientInfo_);
@@ -194,6 +219,7 @@ void SensorDump::DumpHelp(int32_t fd)
     dprintf(fd, "      -o, --open: dump the opening sensors\n");
 #ifdef BUILD_VARIANT_ENG 
     dprintf(fd, "      -d, --data: dump the last 10 packages sensor data\n");
+    dprintf(fd, "      -e, --export <seconds>: export the sensor data of the last seconds to %s\n", EXPORT_FILE_PATH);
 #endif // BUILD_VARIANT_ENG
 }
 
@@ -233,6 +259,14 @@ bool SensorDump::DumpSensorChannel(int32_t fd, ClientInfo &clientInfo)
                 channel.GetUid(), channel.GetPackageName().c_str(), sensorId, sensorMap_[sensorId].c_str(),
                 channel.GetSamplingPeriodNs(), channel.GetFifoCount());
     }
+    std::vector<SensorChannelStats> channelStats;
+    clientInfo.GetDataChannelStats(channelStats);
+    dprintf(fd, "Sensor data channel stats:\n");
+    for (const auto &stats : channelStats) {
+        dprintf(fd, "pid:%d | uid:%d | overflowPolicy:%d | pendingNum:%zu | dropCount:%" PRIu64 " | "
+                "retryCount:%" PRIu64 "\n", stats.pid, clientInfo.GetUidByPid(stats.pid), stats.overflowPolicy,
+                stats.pendingNum, stats.dropCount, stats.retryCount);
+    }
     return true;
 }
 
@@ -250,6 +284,13 @@ bool SensorDump::DumpOpeningSensor(int32_t fd, const std::vector<Sensor> &sensor
                 sensorId, sensorMap_[sensorId].c_str(), clientInfo.GetSensorChannel(sensorId).size());
         }
     }
+    SensorBatchScheduler &batchScheduler = SensorBatchScheduler::GetInstance();
+    dprintf(fd, "Batched sensors, expected wakeups/sec before alignment:%.2f | after alignment:%.2f\n",
+        batchScheduler.GetWakeupRate(false), batchScheduler.GetWakeupRate(true));
+    for (const auto &plan : batchScheduler.GetBatchPlans()) {
+        dprintf(fd, "sensorId: %8u | samplingPeriodNs:%" PRId64 " | requestDelayNs:%" PRId64 " | alignedDelayNs:%"
+            PRId64 "\n", plan.sensorId, plan.samplingPeriodNs, plan.requestDelayNs, plan.alignedDelayNs);
+    }
     return true;
 }
 
@@ -265,9 +306,10 @@ bool SensorDump::DumpSensorData(int32_t fd, ClientInfo &clientInfo)
             continue;
         }
         dprintf(fd, "sensorId: %8u | sensorType: %s:\n", sensorId, sensorMap_[sensorId].c_str());
-        for (uint32_t i = 0; i < MAX_DUMP_DATA_SIZE && (!sensorData.second.empty()); i++) {
-            auto data = sensorData.second.front();
-            sensorData.second.pop();
+        auto &events = sensorData.second;
+        size_t begin = (events.size() > MAX_DUMP_DATA_SIZE) ? events.size() - MAX_DUMP_DATA_SIZE : 0;
+        for (size_t i = begin; i < events.size(); i++) {
+            auto &data = events[i];
             timespec time = { 0, 0 };
             clock_gettime(CLOCK_REALTIME, &time);
             struct tm *timeinfo = localtime(&(time.tv_sec));
@@ -279,6 +321,52 @@ bool SensorDump::DumpSensorData(int32_t fd, ClientInfo &clientInfo)
     }
     return true;
 }
+
+bool SensorDump::ExportSensorData(int32_t fd, ClientInfo &clientInfo, int64_t windowS)
+{
+    if (windowS <= 0 || windowS > MAX_EXPORT_WINDOW_S) {
+        dprintf(fd, "Export window should be 1 to %" PRId64 " seconds\n", MAX_EXPORT_WINDOW_S);
+        return false;
+    }
+    // The window ends at the newest recorded sample, so sensor timestamps need not follow any system clock
+    auto dataMap = clientInfo.GetDumpQueue();
+    ExportFileHeader header;
+    for (const auto &sensorData : dataMap) {
+        header.endNs = std::max(header.endNs, sensorData.second.back().timestamp);
+    }
+    header.beginNs = header.endNs - windowS * SECOND_NS;
+    for (auto &sensorData : dataMap) {
+        auto &events = sensorData.second;
+        events.erase(std::remove_if(events.begin(), events.end(),
+            [&header](const SensorData &data) { return data.timestamp < header.beginNs; }), events.end());
+        header.recordNum += static_cast<uint32_t>(events.size());
+    }
+    if (mkdir(EXPORT_FILE_DIR, S_IRWXU | S_IRGRP | S_IXGRP) != 0 && errno != EEXIST) {
+        dprintf(fd, "Create %s failed, errno:%d\n", EXPORT_FILE_DIR, errno);
+        return false;
+    }
+    FILE *file = fopen(EXPORT_FILE_PATH, "wb");
+    if (file == nullptr) {
+        dprintf(fd, "Open %s failed, errno:%d\n", EXPORT_FILE_PATH, errno);
+        return false;
+    }
+    bool result = (fwrite(&header, sizeof(header), 1, file) == 1);
+    for (const auto &sensorData : dataMap) {
+        const auto &events = sensorData.second;
+        if (result && !events.empty()) {
+            result = (fwrite(events.data(), sizeof(SensorData), events.size(), file) == events.size());
+        }
+    }
+    if (fclose(file) != 0) {
+        result = false;
+    }
+    if (!result) {
+        dprintf(fd, "Write %s failed\n", EXPORT_FILE_PATH);
+        return false;
+    }
+    dprintf(fd, "Exported %u records of %zu sensors to %s\n", header.recordNum, dataMap.size(), EXPORT_FILE_PATH);
+    return true;
+}
 #endif // BUILD_VARIANT_ENG
 
 void SensorDump::DumpCurrentTime(int32_t fd)
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sensor_dump_ring.h"
+
+#include <algorithm>
+
+#include "securec.h"
+
+namespace OHOS {
+namespace Sensors {
+SensorDumpRing::SensorDumpRing(size_t capacity)
+    : capacity_(std::max(capacity, static_cast<size_t>(1))), records_(std::make_unique<Record[]>(capacity_))
+{}
+
+void SensorDumpRing::Push(const SensorData &data)
+{
+    uint64_t count = writeCount_.load(std::memory_order_relaxed);
+    Record &record = records_[count % capacity_];
+    uint64_t words[RECORD_WORD_NUM] = {};
+    if (memcpy_s(words, sizeof(words), &data, sizeof(data)) != EOK) {
+        return;
+    }
+    record.sequence.store(count * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < RECORD_WORD_NUM; ++i) {
+        record.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    record.sequence.store(count * 2 + 2, std::memory_order_release);
+    writeCount_.store(count + 1, std::memory_order_release);
+}
+
+size_t SensorDumpRing::Snapshot(std::vector<SensorData> &events, int64_t beginNs, int64_t endNs) const
+{
+    uint64_t count = writeCount_.load(std::memory_order_acquire);
+    uint64_t first = (count > capacity_) ? count - capacity_ : 0;
+    first = std::max(first, clearCount_.load(std::memory_order_acquire));
+    size_t snapshotNum = 0;
+    uint64_t words[RECORD_WORD_NUM] = {};
+    SensorData data;
+    for (uint64_t i = first; i < count; ++i) {
+        const Record &record = records_[i % capacity_];
+        uint64_t sequence = record.sequence.load(std::memory_order_acquire);
+        if (sequence != i * 2 + 2) {
+            continue;
+        }
+        for (size_t j = 0; j < RECORD_WORD_NUM; ++j) {
+            words[j] = record.words[j].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (record.sequence.load(std::memory_order_relaxed) != sequence) {
+            // Overwritten by the writer while being copied
+            continue;
+        }
+        if (memcpy_s(&data, sizeof(data), words, sizeof(data)) != EOK) {
+            continue;
+        }
+        if (data.timestamp < beginNs || data.timestamp > endNs) {
+            continue;
+        }
+        events.push_back(data);
+        ++snapshotNum;
+    }
+    return snapshotNum;
+}
+
+void SensorDumpRing::Clear()
+{
+    clearCount_.store(writeCount_.load(std::memory_order_acquire), std::memory_order_release);
+}
+} // namespace Sensors
+} // namespace OHOS
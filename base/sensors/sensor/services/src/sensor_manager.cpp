@@ -65,12 +65,7 @@ bool SensorManager::SetBestSensorParams(int32_t sensorId, int64_t samplingPeriod
     bestSamplingPeriodNs = (samplingPeriodNs < bestSamplingPeriodNs) ? samplingPeriodNs : bestSamplingPeriodNs;
     bestReportDelayNs = (maxReportDelayNs < bestReportDelayNs) ? maxReportDelayNs : bestReportDelayNs;
     SEN_HILOGD("bestSamplingPeriodNs : %{public}" PRId64, bestSamplingPeriodNs);
-    auto ret = sensorHdiConnection_.SetBatch(sensorId, bestSamplingPeriodNs, bestReportDelayNs);
-    if (ret != ERR_OK) {
-        SEN_HILOGE("SetBatch is failed");
-        return false;
-    }
-    return true;
+    return ApplyBatchPlans(sensorId, batchScheduler_.UpdateSensor(sensorId, bestSamplingPeriodNs, bestReportDelayNs));
 }
 
 bool SensorManager::ResetBestSensorParams(int32_t sensorId)
@@ -81,13 +76,24 @@ bool SensorManager::ResetBestSensorParams(int32_t sensorId)
         return false;
     }
     SensorBasicInfo sensorInfo = clientInfo_.GetBestSensorInfo(sensorId);
-    auto ret = sensorHdiConnection_.SetBatch(sensorId,
-        sensorInfo.GetSamplingPeriodNs(), sensorInfo.GetMaxReportDelayNs());
-    if (ret != ERR_OK) {
-        SEN_HILOGE("SetBatch is failed");
-        return false;
+    return ApplyBatchPlans(sensorId, batchScheduler_.UpdateSensor(sensorId,
+        sensorInfo.GetSamplingPeriodNs(), sensorInfo.GetMaxReportDelayNs()));
+}
+
+bool SensorManager::ApplyBatchPlans(int32_t sensorId, const std::vector<SensorBatchPlan> &plans)
+{
+    bool result = true;
+    for (const auto &plan : plans) {
+        auto ret = sensorHdiConnection_.SetBatch(plan.sensorId, plan.samplingPeriodNs, plan.alignedDelayNs);
+        if (ret != ERR_OK) {
+            SEN_HILOGE("SetBatch is failed, sensorId:%{public}d", plan.sensorId);
+            // Only the sensor being configured fails the request, the others keep their previous batch
+            if (plan.sensorId == sensorId) {
+                result = false;
+            }
+        }
     }
-    return true;
+    return result;
 }
 
 void SensorManager::StartDataReportThread()
@@ -168,6 +174,9 @@ ErrCode SensorManager::AfterDisableSensor(int32_t sensorId)
 {
     CALL_LOG_ENTER;
     clientInfo_.ClearSensorInfo(sensorId);
+#ifdef HDF_DRIVERS_INTERFACE_SENSOR
+    ApplyBatchPlans(sensorId, batchScheduler_.RemoveSensor(sensorId));
+#endif // HDF_DRIVERS_INTERFACE_SENSOR
     if (sensorId == PROXIMITY_SENSOR_ID) {
         SensorData sensorData;
         auto ret = clientInfo_.GetStoreEvent(sensorId, sensorData);
@@ -37,6 +37,10 @@
 #undef LOG_TAG
 #define LOG_TAG "SensorService"
 
+#ifndef SENSOR_OVERFLOW_POLICY
+#define SENSOR_OVERFLOW_POLICY 0
+#endif // SENSOR_OVERFLOW_POLICY
+
 namespace OHOS {
 namespace Sensors {
 using namespace OHOS::HiviewDFX;
@@ -142,6 +146,8 @@ bool SensorService::InitSensorList()
         SEN_HILOGE("GetSensorList is failed");
         return false;
     }
+    clientInfo_.UpdateStoredEventTable(sensors_);
+    clientInfo_.UpdateDumpRingTable(sensors_);
     {
         std::lock_guard<std::mutex> sensorMapLock(sensorMapMutex_);
         for (const auto &it : sensors_) {
@@ -200,16 +206,19 @@ void SensorService::ReportSensorSysEvent(int32_t sensorId, bool enable, int32_t
 
 void SensorService::ReportOnChangeData(int32_t sensorId)
 {
-    std::lock_guard<std::mutex> sensorMapLock(sensorMapMutex_);
-    auto it = sensorMap_.find(sensorId);
-    if (it == sensorMap_.end()) {
-        SEN_HILOGE("sensorId is invalid");
-        return;
-    }
-    if ((SENSOR_ON_CHANGE & it->second.GetFlags()) != SENSOR_ON_CHANGE) {
-        SEN_HILOGW("The data has not changed , no need to report");
-        return;
+    {
+        std::lock_guard<std::mutex> sensorMapLock(sensorMapMutex_);
+        auto it = sensorMap_.find(sensorId);
+        if (it == sensorMap_.end()) {
+            SEN_HILOGE("sensorId is invalid");
+            return;
+        }
+        if ((SENSOR_ON_CHANGE & it->second.GetFlags()) != SENSOR_ON_CHANGE) {
+            SEN_HILOGW("The data has not changed , no need to report");
+            return;
+        }
     }
+    // The stored event is read lock-free, only the flags need the sensor map
     SensorData sensorData;
     auto ret = clientInfo_.GetStoreEvent(sensorId, sensorData);
     if (ret != ERR_OK) {
@@ -361,6 +370,8 @@ std::vector<Sensor> SensorService::GetSensorList()
         SEN_HILOGE("GetSensorList is failed");
         return sensors_;
     }
+    clientInfo_.UpdateStoredEventTable(sensors_);
+    clientInfo_.UpdateDumpRingTable(sensors_);
 #endif // HDF_DRIVERS_INTERFACE_SENSOR
     for (const auto &it : sensors_) {
         std::lock_guard<std::mutex> sensorMapLock(sensorMapMutex_);
@@ -384,6 +395,7 @@ ErrCode SensorService::TransferDataChannel(const sptr<SensorBasicDataChannel> &s
         SEN_HILOGE("UpdateSensorChannel is failed");
         return UPDATE_SENSOR_CHANNEL_ERR;
     }
+    sensorBasicDataChannel->SetOverflowPolicy(SENSOR_OVERFLOW_POLICY);
     sensorBasicDataChannel->SetSensorStatus(true);
     RegisterClientDeathRecipient(sensorClient, pid);
     return ERR_OK;
@@ -563,6 +575,27 @@ ErrCode SensorService::ResetSensors()
     return POWER_POLICY.ResetSensors();
 }
 
+ErrCode SensorService::GetLatestData(int32_t sensorId, SensorData &data)
+{
+    if (!CheckSensorId(sensorId)) {
+        return ERR_NO_INIT;
+    }
+    // The cached event is only kept up to date while someone has the sensor enabled
+    if (!clientInfo_.GetSensorState(sensorId)) {
+        SEN_HILOGD("Sensor is not enabled, sensorId:%{public}d", sensorId);
+        return NO_EVENT;
+    }
+    if (clientInfo_.GetStoreEvent(sensorId, data) != ERR_OK) {
+        SEN_HILOGD("There is no data of sensorId:%{public}d", sensorId);
+        return NO_EVENT;
+    }
+    if (data.dataLen > SENSOR_MAX_LENGTH) {
+        SEN_HILOGE("Invalid data length:%{public}u", data.dataLen);
+        return ERROR;
+    }
+    return ERR_OK;
+}
+
 void SensorService::ReportActiveInfo(int32_t sensorId, int32_t pid)
 {
     CALL_LOG_ENTER;
@@ -84,6 +84,9 @@ int32_t SensorServiceStub::ProcessRemoteRequest(uint32_t code, MessageParcel &da
         case static_cast<int32_t>(SensorInterfaceCode::RESET_SENSORS): {
             return ResetSensorsInner(data, reply);
         }
+        case static_cast<int32_t>(SensorInterfaceCode::GET_LATEST_DATA): {
+            return GetLatestDataInner(data, reply);
+        }
         default: {
             SEN_HILOGD("No member func supporting, applying default process");
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -350,5 +353,40 @@ ErrCode SensorServiceStub::ResetSensorsInner(MessageParcel &data, MessageParcel
     }
     return ResetSensors();
 }
+
+ErrCode SensorServiceStub::GetLatestDataInner(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t sensorId;
+    READINT32(data, sensorId, READ_PARCEL_ERR);
+    if ((sensorId == SENSOR_TYPE_ID_COLOR || sensorId == SENSOR_TYPE_ID_SAR) && !IsSystemCalling()) {
+        SEN_HILOGE("Permission check failed. A non-system application uses the system API");
+        return NON_SYSTEM_API;
+    }
+    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
+    int32_t ret = permissionUtil.CheckSensorPermission(GetCallingTokenID(), sensorId);
+    if (ret != PERMISSION_GRANTED) {
+        HiSysEventWrite(HiSysEvent::Domain::SENSOR, "VERIFY_ACCESS_TOKEN_FAIL",
+            HiSysEvent::EventType::SECURITY, "PKG_NAME", "GetLatestDataInner", "ERROR_CODE", ret);
+        SEN_HILOGE("sensorId:%{public}d grant failed, result:%{public}d", sensorId, ret);
+        return PERMISSION_DENIED;
+    }
+    SensorData sensorData;
+    ret = GetLatestData(sensorId, sensorData);
+    if (ret != ERR_OK) {
+        SEN_HILOGD("Get latest data failed, sensorId:%{public}d", sensorId);
+        return ret;
+    }
+    WRITEINT32(reply, sensorData.sensorTypeId, WRITE_PARCEL_ERR);
+    WRITEINT32(reply, sensorData.version, WRITE_PARCEL_ERR);
+    WRITEINT64(reply, sensorData.timestamp, WRITE_PARCEL_ERR);
+    WRITEINT32(reply, sensorData.option, WRITE_PARCEL_ERR);
+    WRITEINT32(reply, sensorData.mode, WRITE_PARCEL_ERR);
+    WRITEUINT32(reply, sensorData.dataLen, WRITE_PARCEL_ERR);
+    if (!reply.WriteBuffer(sensorData.data, sensorData.dataLen)) {
+        SEN_HILOGE("Parcel write sensor data failed");
+        return WRITE_PARCEL_ERR;
+    }
+    return ERR_OK;
+}
 } // namespace Sensors
 } // namespace OHOS
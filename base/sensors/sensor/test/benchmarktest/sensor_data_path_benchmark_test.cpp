@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "client_info.h"
+#include "report_data_callback.h"
+#include "sensor.h"
+#include "sensor_agent_type.h"
+#include "sensor_basic_data_channel.h"
+#include "sensor_basic_info.h"
+#include "sensor_data_processer.h"
+#include "sensor_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "SensorDataPathBenchmarkTest"
+
+namespace {
+std::atomic<uint64_t> g_allocCount = 0;
+std::atomic_bool g_countAlloc = false;
+thread_local bool g_isClientThread = false;
+
+inline bool IsAllocCounted()
+{
+    return g_countAlloc.load(std::memory_order_relaxed) && !g_isClientThread;
+}
+} // namespace
+
+// Counts heap allocations made by every service thread: the HDI callback, SensorDataProcesser and its dispatch threads
+void *operator new(size_t size)
+{
+    if (IsAllocCounted()) {
+        g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    void *ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    if (IsAllocCounted()) {
+        g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+namespace OHOS {
+namespace Sensors {
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr int32_t BASE_SENSOR_ID = 1;
+constexpr int32_t BASE_PID = 100000;
+constexpr int32_t NS_PER_SECOND = 1000000000;
+constexpr int32_t NS_PER_US = 1000;
+constexpr int32_t RUN_DURATION_MS = 2000;
+constexpr int32_t DRAIN_TIMEOUT_MS = 200;
+constexpr int32_t POLL_TIMEOUT_MS = 10;
+constexpr int32_t RECEIVE_DATA_SIZE = 100;
+constexpr int32_t PERCENT = 100;
+constexpr int32_t PER_MILLE = 1000;
+constexpr int32_t WAKEUP_SENSOR_ID = -1;
+constexpr float ACC_DEFAULT_VALUE = 9.8F;
+
+int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t CpuNs(clockid_t clockId)
+{
+    struct timespec ts = {};
+    clock_gettime(clockId, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * NS_PER_SECOND + ts.tv_nsec;
+}
+
+int64_t Percentile(std::vector<int64_t> &latencies, int32_t perMille)
+{
+    if (latencies.empty()) {
+        return 0;
+    }
+    size_t index = std::min(latencies.size() - 1, latencies.size() * perMille / PER_MILLE);
+    std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+    return latencies[index];
+}
+
+struct DataPathConfig {
+    int32_t sensorCount { 1 };
+    int32_t rateHz { 100 };
+    int32_t subscriberCount { 1 };
+    int32_t shardNum { 1 };
+};
+
+struct DataPathResult {
+    uint64_t produced { 0 };
+    uint64_t expected { 0 };
+    uint64_t received { 0 };
+    uint64_t ringOverflow { 0 };
+    uint64_t allocs { 0 };
+    int64_t durationNs { 0 };
+    int64_t serviceCpuNs { 0 };
+    int64_t processCpuNs { 0 };
+    std::vector<int64_t> latencies;
+};
+
+struct Subscriber {
+    int32_t pid { -1 };
+    sptr<SensorBasicDataChannel> channel;
+    std::vector<int64_t> latencies;
+    int64_t cpuNs { 0 };
+    std::thread thread;
+};
+
+// Plays the client side of one data channel, records HDI timestamp -> receive latency for every event
+void ReceiveEvents(Subscriber &subscriber, const std::atomic_bool &stop)
+{
+    g_isClientThread = true;
+    int64_t cpuBegin = CpuNs(CLOCK_THREAD_CPUTIME_ID);
+    std::vector<SensorData> buff(RECEIVE_DATA_SIZE);
+    int32_t fd = subscriber.channel->GetReceiveDataFd();
+    while (true) {
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        int32_t ret = poll(&pfd, 1, POLL_TIMEOUT_MS);
+        if (ret <= 0) {
+            if (stop.load(std::memory_order_acquire)) {
+                break;
+            }
+            continue;
+        }
+        ssize_t len = recv(fd, buff.data(), sizeof(SensorData) * RECEIVE_DATA_SIZE, MSG_DONTWAIT);
+        while (len > 0) {
+            int64_t now = NowNs();
+            size_t num = static_cast<size_t>(len) / sizeof(SensorData);
+            for (size_t i = 0; i < num; ++i) {
+                subscriber.latencies.push_back(now - buff[i].timestamp);
+            }
+            len = recv(fd, buff.data(), sizeof(SensorData) * RECEIVE_DATA_SIZE, MSG_DONTWAIT);
+        }
+    }
+    subscriber.cpuNs = CpuNs(CLOCK_THREAD_CPUTIME_ID) - cpuBegin;
+}
+
+// Plays the HDI callback thread, reports one accelerometer-like event per sensor per period
+uint64_t ProduceEvents(const DataPathConfig &config, sptr<ReportDataCallback> dataCallback, int64_t durationNs)
+{
+    SensorData event = {};
+    event.mode = SENSOR_REALTIME_MODE;
+    event.option = 3;
+    event.dataLen = sizeof(float) * 3;
+    float *values = reinterpret_cast<float *>(event.data);
+    values[0] = 0.0F;
+    values[1] = 0.0F;
+    values[2] = ACC_DEFAULT_VALUE;
+    uint64_t produced = 0;
+    auto period = std::chrono::nanoseconds(NS_PER_SECOND / config.rateHz);
+    auto begin = std::chrono::steady_clock::now();
+    auto next = begin;
+    while (std::chrono::steady_clock::now() - begin < std::chrono::nanoseconds(durationNs)) {
+        for (int32_t i = 0; i < config.sensorCount; ++i) {
+            event.sensorTypeId = BASE_SENSOR_ID + i;
+            event.timestamp = NowNs();
+            dataCallback->ReportEventCallback(&event, dataCallback);
+            ++produced;
+        }
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+    return produced;
+}
+
+DataPathResult RunDataPath(const DataPathConfig &config)
+{
+    DataPathResult result;
+    std::unordered_map<int32_t, Sensor> sensorMap;
+    std::vector<Sensor> sensors;
+    for (int32_t i = 0; i < config.sensorCount; ++i) {
+        Sensor sensor;
+        sensor.SetSensorId(BASE_SENSOR_ID + i);
+        sensor.SetSensorTypeId(BASE_SENSOR_ID + i);
+        sensor.SetFlags(SENSOR_REALTIME_MODE);
+        sensorMap.emplace(sensor.GetSensorId(), sensor);
+        sensors.push_back(sensor);
+    }
+    ClientInfo &clientInfo = ClientInfo::GetInstance();
+    clientInfo.UpdateStoredEventTable(sensors);
+    sptr<SensorDataProcesser> dataProcesser = new (std::nothrow) SensorDataProcesser(sensorMap,
+        static_cast<size_t>(config.shardNum));
+    sptr<ReportDataCallback> dataCallback = new (std::nothrow) ReportDataCallback();
+    if ((dataProcesser == nullptr) || (dataCallback == nullptr)) {
+        SEN_HILOGE("Create data processer failed");
+        return result;
+    }
+
+    std::atomic_bool clientStop = false;
+    std::vector<Subscriber> subscribers(config.subscriberCount);
+    uint64_t expectedPerSubscriber = static_cast<uint64_t>(config.sensorCount) * config.rateHz *
+        RUN_DURATION_MS / PER_MILLE;
+    for (int32_t i = 0; i < config.subscriberCount; ++i) {
+        Subscriber &subscriber = subscribers[i];
+        subscriber.pid = BASE_PID + i;
+        subscriber.channel = new (std::nothrow) SensorBasicDataChannel();
+        if ((subscriber.channel == nullptr) || (subscriber.channel->CreateSensorBasicChannel() != ERR_OK)) {
+            SEN_HILOGE("Create channel failed");
+            return result;
+        }
+        clientInfo.UpdateSensorChannel(subscriber.pid, subscriber.channel);
+        subscriber.channel->SetSensorStatus(true);
+        for (const auto &sensor : sensors) {
+            SensorBasicInfo sensorInfo;
+            sensorInfo.SetSamplingPeriodNs(NS_PER_SECOND / config.rateHz);
+            sensorInfo.SetMaxReportDelayNs(0);
+            sensorInfo.SetSensorState(true);
+            clientInfo.UpdateSensorInfo(sensor.GetSensorId(), subscriber.pid, sensorInfo);
+        }
+        subscriber.latencies.reserve(expectedPerSubscriber + expectedPerSubscriber / 2);
+        subscriber.thread = std::thread(ReceiveEvents, std::ref(subscriber), std::cref(clientStop));
+    }
+
+    std::atomic_bool serviceStop = false;
+    std::thread dataThread([&dataProcesser, &dataCallback, &serviceStop] {
+        while (!serviceStop.load(std::memory_order_acquire)) {
+            dataProcesser->ProcessEvents(dataCallback);
+        }
+    });
+
+    g_allocCount = 0;
+    g_countAlloc = true;
+    int64_t processCpuBegin = CpuNs(CLOCK_PROCESS_CPUTIME_ID);
+    int64_t begin = NowNs();
+    result.produced = ProduceEvents(config, dataCallback, static_cast<int64_t>(RUN_DURATION_MS) * NS_PER_SECOND /
+        PER_MILLE);
+    result.durationNs = NowNs() - begin;
+    std::this_thread::sleep_for(std::chrono::milliseconds(DRAIN_TIMEOUT_MS));
+    serviceStop = true;
+    SensorData wakeup = {};
+    wakeup.sensorTypeId = WAKEUP_SENSOR_ID;
+    dataCallback->ReportEventCallback(&wakeup, dataCallback);
+    dataThread.join();
+    g_countAlloc = false;
+    clientStop = true;
+    for (auto &subscriber : subscribers) {
+        subscriber.thread.join();
+    }
+    result.processCpuNs = CpuNs(CLOCK_PROCESS_CPUTIME_ID) - processCpuBegin;
+    // Everything but the subscriber threads runs service code, including the dispatch threads
+    result.serviceCpuNs = result.processCpuNs;
+    for (const auto &subscriber : subscribers) {
+        result.serviceCpuNs -= subscriber.cpuNs;
+    }
+    result.allocs = g_allocCount;
+    result.ringOverflow = dataCallback->GetOverflowCount();
+    result.expected = result.produced * config.subscriberCount;
+    for (auto &subscriber : subscribers) {
+        result.received += subscriber.latencies.size();
+        result.latencies.insert(result.latencies.end(), subscriber.latencies.begin(), subscriber.latencies.end());
+        clientInfo.DestroySensorChannel(subscriber.pid);
+        subscriber.channel->DestroySensorBasicChannel();
+    }
+    for (const auto &sensor : sensors) {
+        clientInfo.ClearSensorInfo(sensor.GetSensorId());
+    }
+    return result;
+}
+} // namespace
+
+class SensorDataPathBenchmarkTest : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State &state) override;
+    void TearDown(const ::benchmark::State &state) override;
+};
+
+void SensorDataPathBenchmarkTest::SetUp(const ::benchmark::State &state) {}
+
+void SensorDataPathBenchmarkTest::TearDown(const ::benchmark::State &state) {}
+
+/**
+ * @tc.name: SensorDataPath
+ * @tc.desc: Pushes synthetic HDI events through ReportDataCallback, SensorDataProcesser and the socket channels.
+ * Arguments are sensor count, report rate in Hz, subscriber count and dispatch thread count.
+ * @tc.type: PERF
+ */
+BENCHMARK_DEFINE_F(SensorDataPathBenchmarkTest, SensorDataPath)(benchmark::State &state)
+{
+    DataPathConfig config;
+    config.sensorCount = static_cast<int32_t>(state.range(0));
+    config.rateHz = static_cast<int32_t>(state.range(1));
+    config.subscriberCount = static_cast<int32_t>(state.range(2));
+    config.shardNum = static_cast<int32_t>(state.range(3));
+    DataPathResult result;
+    for (auto _ : state) {
+        result = RunDataPath(config);
+        state.SetIterationTime(static_cast<double>(result.durationNs) / NS_PER_SECOND);
+    }
+    if ((result.produced == 0) || (result.durationNs == 0)) {
+        state.SkipWithError("No event was produced");
+        return;
+    }
+    state.counters["events_per_sec"] = static_cast<double>(result.received) * NS_PER_SECOND / result.durationNs;
+    state.counters["p50_us"] = static_cast<double>(Percentile(result.latencies, 500)) / NS_PER_US;
+    state.counters["p90_us"] = static_cast<double>(Percentile(result.latencies, 900)) / NS_PER_US;
+    state.counters["p99_us"] = static_cast<double>(Percentile(result.latencies, 990)) / NS_PER_US;
+    state.counters["p999_us"] = static_cast<double>(Percentile(result.latencies, 999)) / NS_PER_US;
+    state.counters["drop_pct"] = (result.expected == 0) ? 0.0 :
+        static_cast<double>(result.expected - std::min(result.expected, result.received)) * PERCENT / result.expected;
+    state.counters["ring_overflow"] = static_cast<double>(result.ringOverflow);
+    state.counters["service_cpu_ns_per_event"] = static_cast<double>(result.serviceCpuNs) / result.produced;
+    state.counters["process_cpu_ns_per_event"] = static_cast<double>(result.processCpuNs) / result.produced;
+    state.counters["allocs_per_event"] = static_cast<double>(result.allocs) / result.produced;
+}
+
+BENCHMARK_REGISTER_F(SensorDataPathBenchmarkTest, SensorDataPath)
+    ->Args({1, 100, 1, 1})
+    ->Args({1, 1000, 1, 1})
+    ->Args({4, 500, 4, 1})
+    ->Args({4, 500, 4, 2})
+    ->Args({8, 1000, 8, 1})
+    ->Args({8, 1000, 8, 4})
+    ->Args({16, 400, 16, 1})
+    ->Args({16, 400, 16, 4})
+    ->Iterations(1)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+} // namespace Sensors
+} // namespace OHOS
+
+BENCHMARK_MAIN();
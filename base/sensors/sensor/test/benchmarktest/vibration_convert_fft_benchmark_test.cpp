@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "conversion_fft.h"
+#include "utils.h"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr double PI_VALUE = 3.14159265358979323846;
+constexpr double TONE_AMP = 0.3;
+constexpr double TONE_FREQS[] = { 440.0, 880.0, 1320.0 };
+constexpr double BURST_AMP = 0.5;
+constexpr int32_t BURSTS_PER_SECOND = 4;
+constexpr int32_t BURST_LEN = 2048;
+
+// Tones with a decaying noise burst on every beat, close to the spectra of a ringtone
+std::vector<double> MakeRingtone(int32_t seconds)
+{
+    std::default_random_engine eng(1);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    size_t sampleNum = static_cast<size_t>(seconds) * SAMPLE_RATE;
+    size_t burstPeriod = static_cast<size_t>(SAMPLE_RATE / BURSTS_PER_SECOND);
+    std::vector<double> samples(sampleNum, 0.0);
+    for (size_t i = 0; i < sampleNum; ++i) {
+        double time = static_cast<double>(i) / SAMPLE_RATE;
+        for (double freq : TONE_FREQS) {
+            samples[i] += TONE_AMP / std::size(TONE_FREQS) * std::sin(2.0 * PI_VALUE * freq * time);
+        }
+        size_t burstPos = i % burstPeriod;
+        if (burstPos < BURST_LEN) {
+            samples[i] += BURST_AMP * noise(eng) * (1.0 - static_cast<double>(burstPos) / BURST_LEN);
+        }
+    }
+    return samples;
+}
+
+bool InitConversionFft(ConversionFFT &conversionFft)
+{
+    FFTInputPara para;
+    para.sampleRate = SAMPLE_RATE;
+    para.fftSize = NFFT;
+    para.hopSize = ONSET_HOP_LEN;
+    para.windowSize = NFFT;
+    return conversionFft.Init(para) == 0;
+}
+} // namespace
+
+class VibrationConvertFftBenchmarkTest : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State &state) override;
+    void TearDown(const ::benchmark::State &state) override;
+
+protected:
+    std::vector<double> ringtone_;
+};
+
+void VibrationConvertFftBenchmarkTest::SetUp(const ::benchmark::State &state)
+{
+    ringtone_ = MakeRingtone(static_cast<int32_t>(state.range(0)));
+}
+
+void VibrationConvertFftBenchmarkTest::TearDown(const ::benchmark::State &state)
+{
+    std::vector<double>().swap(ringtone_);
+}
+
+/**
+ * @tc.name: StftByFft
+ * @tc.desc: Magnitude STFT of a ringtone through ConversionFFT::Process and the Fft class, sample by sample.
+ * The argument is the ringtone length in seconds.
+ * @tc.type: PERF
+ */
+BENCHMARK_DEFINE_F(VibrationConvertFftBenchmarkTest, StftByFft)(benchmark::State &state)
+{
+    ConversionFFT conversionFft;
+    if (!InitConversionFft(conversionFft)) {
+        state.SkipWithError("Init failed");
+        return;
+    }
+    int32_t frameCount = 0;
+    for (auto _ : state) {
+        std::vector<float> frameMagsArr;
+        conversionFft.Process(ringtone_, frameCount, frameMagsArr);
+        benchmark::DoNotOptimize(frameMagsArr.data());
+    }
+    state.counters["frames_per_sec"] = benchmark::Counter(static_cast<double>(frameCount) * state.iterations(),
+        benchmark::Counter::kIsRate);
+}
+
+/**
+ * @tc.name: StftByRealFft
+ * @tc.desc: Same STFT through ConversionFFT::ProcessFrames and RealFft, all frames in one pass.
+ * max_mag_error is the largest difference to the magnitudes of StftByFft.
+ * @tc.type: PERF
+ */
+BENCHMARK_DEFINE_F(VibrationConvertFftBenchmarkTest, StftByRealFft)(benchmark::State &state)
+{
+    ConversionFFT conversionFft;
+    if (!InitConversionFft(conversionFft)) {
+        state.SkipWithError("Init failed");
+        return;
+    }
+    int32_t frameCount = 0;
+    for (auto _ : state) {
+        std::vector<float> frameMagsArr;
+        conversionFft.ProcessFrames(ringtone_, frameCount, frameMagsArr);
+        benchmark::DoNotOptimize(frameMagsArr.data());
+    }
+    ConversionFFT referenceFft;
+    ConversionFFT checkFft;
+    if (!InitConversionFft(referenceFft) || !InitConversionFft(checkFft)) {
+        state.SkipWithError("Init failed");
+        return;
+    }
+    int32_t referenceCount = 0;
+    std::vector<float> referenceMags;
+    referenceFft.Process(ringtone_, referenceCount, referenceMags);
+    std::vector<float> frameMagsArr;
+    checkFft.ProcessFrames(ringtone_, frameCount, frameMagsArr);
+    if ((frameCount != referenceCount) || (frameMagsArr.size() != referenceMags.size())) {
+        state.SkipWithError("Frame count differs from Fft");
+        return;
+    }
+    float maxError = 0.0F;
+    for (size_t i = 0; i < frameMagsArr.size(); ++i) {
+        maxError = std::max(maxError, std::fabs(frameMagsArr[i] - referenceMags[i]));
+    }
+    state.counters["frames_per_sec"] = benchmark::Counter(static_cast<double>(frameCount) * state.iterations(),
+        benchmark::Counter::kIsRate);
+    state.counters["max_mag_error"] = maxError;
+}
+
+BENCHMARK_REGISTER_F(VibrationConvertFftBenchmarkTest, StftByFft)
+    ->Arg(5)
+    ->Arg(15)
+    ->Arg(30)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(VibrationConvertFftBenchmarkTest, StftByRealFft)
+    ->Arg(5)
+    ->Arg(15)
+    ->Arg(30)
+    ->Unit(benchmark::kMillisecond);
+} // namespace Sensors
+} // namespace OHOS
+
+BENCHMARK_MAIN();
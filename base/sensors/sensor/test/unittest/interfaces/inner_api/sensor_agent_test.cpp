@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <cinttypes>
 #include <gtest/gtest.h>
 #include <thread>
@@ -38,6 +39,7 @@ using Security::AccessToken::AccessTokenID;
 namespace {
 constexpr int32_t SENSOR_ID { 1 };
 constexpr int32_t INVALID_VALUE { -1 };
+constexpr uint32_t DATA_BUFFER_SIZE { 64 };
 
 PermissionStateFull g_infoManagerTestState = {
     .grantFlags = {1},
@@ -139,6 +141,24 @@ void SensorDataCallbackImpl2(SensorEvent *event)
         accelData->x, accelData->y, accelData->z, event[0].option);
 }
 
+std::atomic<int32_t> g_batchEventNum = 0;
+
+void SensorBatchCallbackImpl(SensorEvent *events, int32_t num)
+{
+    if ((events == nullptr) || (num <= 0)) {
+        SEN_HILOGE("events is null or num is invalid");
+        return;
+    }
+    for (int32_t i = 0; i < num; ++i) {
+        if (events[i].sensorTypeId != events[0].sensorTypeId) {
+            SEN_HILOGE("Events of different sensors in one batch");
+            return;
+        }
+    }
+    g_batchEventNum += num;
+    SEN_HILOGI("sensorId:%{public}d, num:%{public}d", events[0].sensorTypeId, num);
+}
+
 HWTEST_F(SensorAgentTest, GetAllSensorsTest_001, TestSize.Level1)
 {
     SEN_HILOGI("GetAllSensorsTest_001 in");
@@ -475,5 +495,68 @@ HWTEST_F(SensorAgentTest, SensorNativeApiTest_004, TestSize.Level1)
     int32_t ret = SetMode(SENSOR_ID, &user, SENSOR_DEFAULT_MODE);
     ASSERT_NE(ret, OHOS::Sensors::SUCCESS);
 }
+
+HWTEST_F(SensorAgentTest, SensorNativeApiTest_005, TestSize.Level1)
+{
+    SEN_HILOGI("SensorNativeApiTest_005 in");
+    SensorUser user;
+    user.callback = SensorDataCallbackImpl;
+    int32_t ret = SetBatchCallback(SENSOR_ID, &user, SensorBatchCallbackImpl);
+    ASSERT_NE(ret, OHOS::Sensors::SUCCESS);
+}
+
+HWTEST_F(SensorAgentTest, SensorNativeApiTest_006, TestSize.Level1)
+{
+    SEN_HILOGI("SensorNativeApiTest_006 in");
+    SensorUser user;
+    user.callback = SensorDataCallbackImpl;
+    g_batchEventNum = 0;
+    int32_t ret = SubscribeSensor(SENSOR_ID, &user);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    ret = SetBatchCallback(SENSOR_ID, &user, SensorBatchCallbackImpl);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    ret = SetBatch(SENSOR_ID, &user, 10000000, 100000000);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    ret = ActivateSensor(SENSOR_ID, &user);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    ret = DeactivateSensor(SENSOR_ID, &user);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    ret = UnsubscribeSensor(SENSOR_ID, &user);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    ASSERT_GT(g_batchEventNum.load(), 0);
+}
+
+HWTEST_F(SensorAgentTest, SensorNativeApiTest_007, TestSize.Level1)
+{
+    SEN_HILOGI("SensorNativeApiTest_007 in");
+    uint8_t buffer[DATA_BUFFER_SIZE] = {};
+    SensorEvent event;
+    event.data = buffer;
+    event.dataLen = sizeof(buffer);
+    int32_t ret = GetLatestSensorData(SENSOR_ID, nullptr);
+    ASSERT_NE(ret, OHOS::Sensors::SUCCESS);
+    SensorUser user;
+    user.callback = SensorDataCallbackImpl;
+    ret = SubscribeSensor(SENSOR_ID, &user);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    ret = SetBatch(SENSOR_ID, &user, 100000000, 100000000);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    ret = ActivateSensor(SENSOR_ID, &user);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    ret = GetLatestSensorData(SENSOR_ID, &event);
+    EXPECT_EQ(ret, OHOS::Sensors::SUCCESS);
+    EXPECT_EQ(event.sensorTypeId, SENSOR_ID);
+    EXPECT_GT(event.dataLen, 0U);
+    ret = DeactivateSensor(SENSOR_ID, &user);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    ret = UnsubscribeSensor(SENSOR_ID, &user);
+    ASSERT_EQ(ret, OHOS::Sensors::SUCCESS);
+    // Nobody keeps the sensor running, so there is no latest data to read
+    event.dataLen = sizeof(buffer);
+    ret = GetLatestSensorData(SENSOR_ID, &event);
+    ASSERT_NE(ret, OHOS::Sensors::SUCCESS);
+}
 } // namespace Sensors
 } // namespace OHOS
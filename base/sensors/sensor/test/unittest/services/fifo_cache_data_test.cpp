@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fifo_cache_data.h"
+#include "hdi_service_impl.h"
+#include "sensor_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "FifoCacheDataTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr int64_t MS_NS = 1000000;
+constexpr int64_t SECOND_NS = 1000 * MS_NS;
+constexpr int64_t SENSOR_PERIOD_NS = 5 * MS_NS;
+constexpr int64_t JITTER_NS = MS_NS;
+constexpr double RATE_TOLERANCE = 0.01;
+constexpr double MOCK_RATE_TOLERANCE = 0.05;
+constexpr int32_t MOCK_RUN_MS = 1000;
+std::mutex g_mockMutex;
+std::vector<int64_t> g_mockTimestamps;
+
+void MockDataCallback(SensorEvent *event)
+{
+    if (event == nullptr || event->sensorTypeId != SENSOR_TYPE_ID_ACCELEROMETER) {
+        return;
+    }
+    std::lock_guard<std::mutex> mockLock(g_mockMutex);
+    g_mockTimestamps.push_back(event->timestamp);
+}
+
+SensorData MakeSample(int64_t timestamp, float value)
+{
+    SensorData data = {};
+    data.sensorTypeId = SENSOR_TYPE_ID_ACCELEROMETER;
+    data.timestamp = timestamp;
+    data.dataLen = sizeof(float);
+    *reinterpret_cast<float *>(data.data) = value;
+    return data;
+}
+
+std::vector<int64_t> Decimate(const std::vector<int64_t> &timestamps, int64_t periodNs)
+{
+    sptr<FifoCacheData> fifoData = new (std::nothrow) FifoCacheData();
+    std::vector<int64_t> delivered;
+    if (fifoData == nullptr) {
+        return delivered;
+    }
+    for (int64_t timestamp : timestamps) {
+        if (fifoData->SelectSample(MakeSample(timestamp, 0.0F), periodNs, 1, nullptr)) {
+            delivered.push_back(timestamp);
+        }
+    }
+    return delivered;
+}
+
+double MeasureRate(const std::vector<int64_t> &delivered)
+{
+    if (delivered.size() < 2) {
+        return 0.0;
+    }
+    return static_cast<double>(delivered.size() - 1) * SECOND_NS / (delivered.back() - delivered.front());
+}
+} // namespace
+
+class FifoCacheDataTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void FifoCacheDataTest::SetUpTestCase() {}
+
+void FifoCacheDataTest::TearDownTestCase() {}
+
+void FifoCacheDataTest::SetUp() {}
+
+void FifoCacheDataTest::TearDown() {}
+
+HWTEST_F(FifoCacheDataTest, FifoCacheDataTest_001, TestSize.Level1)
+{
+    SEN_HILOGI("FifoCacheDataTest_001 in");
+    std::vector<int64_t> timestamps;
+    for (int64_t timestamp = SECOND_NS; timestamp <= 11 * SECOND_NS; timestamp += SENSOR_PERIOD_NS) {
+        timestamps.push_back(timestamp);
+    }
+    // 12ms is not a multiple of the sensor period, a period counter would deliver every 10ms
+    for (int64_t periodNs : { 12 * MS_NS, 20 * MS_NS, 33 * MS_NS }) {
+        std::vector<int64_t> delivered = Decimate(timestamps, periodNs);
+        ASSERT_FALSE(delivered.empty());
+        EXPECT_EQ(delivered.front(), timestamps.front());
+        double expectRate = static_cast<double>(SECOND_NS) / periodNs;
+        EXPECT_NEAR(MeasureRate(delivered), expectRate, expectRate * RATE_TOLERANCE);
+        for (size_t i = 0; i < delivered.size(); ++i) {
+            // Each delivered sample is the one closest to the client's time grid, so the rate does not drift
+            int64_t target = timestamps.front() + static_cast<int64_t>(i) * periodNs;
+            EXPECT_LE(std::llabs(delivered[i] - target), SENSOR_PERIOD_NS / 2);
+        }
+    }
+}
+
+HWTEST_F(FifoCacheDataTest, FifoCacheDataTest_002, TestSize.Level1)
+{
+    SEN_HILOGI("FifoCacheDataTest_002 in");
+    std::default_random_engine eng(1);
+    std::uniform_int_distribution<int64_t> jitter(-JITTER_NS, JITTER_NS);
+    std::vector<int64_t> timestamps;
+    for (int64_t timestamp = SECOND_NS; timestamp <= 11 * SECOND_NS; timestamp += SENSOR_PERIOD_NS) {
+        timestamps.push_back(timestamp + jitter(eng));
+    }
+    int64_t periodNs = 20 * MS_NS;
+    std::vector<int64_t> delivered = Decimate(timestamps, periodNs);
+    double expectRate = static_cast<double>(SECOND_NS) / periodNs;
+    EXPECT_NEAR(MeasureRate(delivered), expectRate, expectRate * RATE_TOLERANCE);
+    // A stalled stream restarts the grid instead of bursting to catch up
+    std::vector<int64_t> stalled = { SECOND_NS, SECOND_NS + SENSOR_PERIOD_NS, 3 * SECOND_NS,
+        3 * SECOND_NS + SENSOR_PERIOD_NS, 3 * SECOND_NS + 2 * SENSOR_PERIOD_NS };
+    delivered = Decimate(stalled, periodNs);
+    ASSERT_EQ(delivered.size(), 2U);
+    EXPECT_EQ(delivered[1], 3 * SECOND_NS);
+}
+
+HWTEST_F(FifoCacheDataTest, FifoCacheDataTest_003, TestSize.Level1)
+{
+    SEN_HILOGI("FifoCacheDataTest_003 in");
+    sptr<FifoCacheData> fifoData = new (std::nothrow) FifoCacheData();
+    ASSERT_NE(fifoData, nullptr);
+    // A signal at half the sensor rate aliases to a constant when decimated, the average removes it
+    SensorData average;
+    int32_t deliveredNum = 0;
+    for (int32_t i = 0; i < 100; ++i) {
+        float value = (i % 2 == 0) ? 1.0F : -1.0F;
+        SensorData data = MakeSample(SECOND_NS + i * SENSOR_PERIOD_NS, value);
+        if (!fifoData->SelectSample(data, 4 * SENSOR_PERIOD_NS, 4, &average)) {
+            continue;
+        }
+        ++deliveredNum;
+        if (deliveredNum > 1) {
+            EXPECT_NEAR(*reinterpret_cast<float *>(average.data), 0.0F, 0.01F);
+        }
+    }
+    EXPECT_EQ(deliveredNum, 25);
+    // Samples without timestamps fall back to the period count
+    sptr<FifoCacheData> untimedData = new (std::nothrow) FifoCacheData();
+    ASSERT_NE(untimedData, nullptr);
+    deliveredNum = 0;
+    for (int32_t i = 0; i < 30; ++i) {
+        if (untimedData->SelectSample(MakeSample(-1, 0.0F), 4 * SENSOR_PERIOD_NS, 3, nullptr)) {
+            ++deliveredNum;
+        }
+    }
+    EXPECT_EQ(deliveredNum, 10);
+}
+
+HWTEST_F(FifoCacheDataTest, FifoCacheDataTest_004, TestSize.Level1)
+{
+    SEN_HILOGI("FifoCacheDataTest_004 in");
+    HdiServiceImpl &hdiService = HdiServiceImpl::GetInstance();
+    ASSERT_EQ(hdiService.Register(MockDataCallback), ERR_OK);
+    ASSERT_EQ(hdiService.SetBatch(SENSOR_TYPE_ID_ACCELEROMETER, SENSOR_PERIOD_NS, 0), ERR_OK);
+    ASSERT_EQ(hdiService.EnableSensor(SENSOR_TYPE_ID_ACCELEROMETER), ERR_OK);
+    std::this_thread::sleep_for(std::chrono::milliseconds(MOCK_RUN_MS));
+    ASSERT_EQ(hdiService.DisableSensor(SENSOR_TYPE_ID_ACCELEROMETER), ERR_OK);
+    std::vector<int64_t> timestamps;
+    {
+        std::lock_guard<std::mutex> mockLock(g_mockMutex);
+        timestamps.swap(g_mockTimestamps);
+    }
+    ASSERT_GT(timestamps.size(), 2U);
+    double sensorRate = MeasureRate(timestamps);
+    for (int64_t periodNs : { 12 * MS_NS, 25 * MS_NS, 50 * MS_NS }) {
+        std::vector<int64_t> delivered = Decimate(timestamps, periodNs);
+        double expectRate = std::min(static_cast<double>(SECOND_NS) / periodNs, sensorRate);
+        double rate = MeasureRate(delivered);
+        SEN_HILOGI("Mock sensor rate:%{public}f, client period:%{public}" PRId64 ", rate:%{public}f",
+            sensorRate, periodNs, rate);
+        EXPECT_NEAR(rate, expectRate, expectRate * MOCK_RATE_TOLERANCE);
+    }
+}
+} // namespace Sensors
+} // namespace OHOS
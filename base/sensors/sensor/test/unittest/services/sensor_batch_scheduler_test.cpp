@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "hdi_service_impl.h"
+#include "sensor_batch_scheduler.h"
+#include "sensor_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "SensorBatchSchedulerTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr int64_t MS_NS = 1000000;
+constexpr int64_t SECOND_NS = 1000 * MS_NS;
+constexpr int64_t CHECK_DURATION_NS = 60 * SECOND_NS;
+constexpr int32_t SENSOR_ID_A = 1;
+constexpr int32_t SENSOR_ID_B = 2;
+constexpr int32_t SENSOR_ID_C = 6;
+constexpr int32_t SENSOR_ID_D = 10;
+constexpr int32_t SENSOR_ID_E = 256;
+constexpr double RATE_EPSILON = 0.001;
+
+SensorBatchPlan FindPlan(const std::vector<SensorBatchPlan> &plans, int32_t sensorId)
+{
+    auto it = std::find_if(plans.begin(), plans.end(),
+        [sensorId](const SensorBatchPlan &plan) { return plan.sensorId == sensorId; });
+    return (it == plans.end()) ? SensorBatchPlan() : *it;
+}
+} // namespace
+
+class SensorBatchSchedulerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void SensorBatchSchedulerTest::SetUpTestCase() {}
+
+void SensorBatchSchedulerTest::TearDownTestCase() {}
+
+void SensorBatchSchedulerTest::SetUp()
+{
+    SensorBatchScheduler &scheduler = SensorBatchScheduler::GetInstance();
+    for (int32_t sensorId : { SENSOR_ID_A, SENSOR_ID_B, SENSOR_ID_C, SENSOR_ID_D, SENSOR_ID_E }) {
+        scheduler.RemoveSensor(sensorId);
+    }
+}
+
+void SensorBatchSchedulerTest::TearDown() {}
+
+HWTEST_F(SensorBatchSchedulerTest, SensorBatchSchedulerTest_001, TestSize.Level1)
+{
+    SEN_HILOGI("SensorBatchSchedulerTest_001 in");
+    SensorBatchScheduler &scheduler = SensorBatchScheduler::GetInstance();
+    scheduler.UpdateSensor(SENSOR_ID_A, 10 * MS_NS, SECOND_NS);
+    scheduler.UpdateSensor(SENSOR_ID_B, 20 * MS_NS, 2500 * MS_NS);
+    std::vector<SensorBatchPlan> plans = scheduler.UpdateSensor(SENSOR_ID_C, 100 * MS_NS, 3700 * MS_NS);
+    ASSERT_EQ(plans.size(), 3U);
+    EXPECT_EQ(FindPlan(plans, SENSOR_ID_A).alignedDelayNs, SECOND_NS);
+    EXPECT_EQ(FindPlan(plans, SENSOR_ID_B).alignedDelayNs, 2 * SECOND_NS);
+    EXPECT_EQ(FindPlan(plans, SENSOR_ID_C).alignedDelayNs, 3 * SECOND_NS);
+    // A realtime sensor is set alone and does not disturb the batched ones
+    plans = scheduler.UpdateSensor(SENSOR_ID_D, 10 * MS_NS, 0);
+    ASSERT_EQ(plans.size(), 1U);
+    EXPECT_EQ(plans[0].sensorId, SENSOR_ID_D);
+    EXPECT_EQ(plans[0].alignedDelayNs, 0);
+    EXPECT_EQ(scheduler.GetBatchPlans().size(), 3U);
+    EXPECT_NEAR(scheduler.GetWakeupRate(false), 1.0 + 1.0 / 2.5 + 1.0 / 3.7, RATE_EPSILON);
+    EXPECT_NEAR(scheduler.GetWakeupRate(true), 1.0, RATE_EPSILON);
+}
+
+HWTEST_F(SensorBatchSchedulerTest, SensorBatchSchedulerTest_002, TestSize.Level1)
+{
+    SEN_HILOGI("SensorBatchSchedulerTest_002 in");
+    SensorBatchScheduler &scheduler = SensorBatchScheduler::GetInstance();
+    scheduler.UpdateSensor(SENSOR_ID_A, 10 * MS_NS, SECOND_NS);
+    // Rounded down to the tick it could not hold a single sample, so it keeps its own delay
+    std::vector<SensorBatchPlan> plans = scheduler.UpdateSensor(SENSOR_ID_E, 1500 * MS_NS, 1800 * MS_NS);
+    EXPECT_EQ(FindPlan(plans, SENSOR_ID_E).alignedDelayNs, 1800 * MS_NS);
+    EXPECT_NEAR(scheduler.GetWakeupRate(true), 1.0 + 1.0 / 1.8, RATE_EPSILON);
+    scheduler.UpdateSensor(SENSOR_ID_B, 20 * MS_NS, 2500 * MS_NS);
+    // The tick grows back once the shortest sensor is gone
+    plans = scheduler.RemoveSensor(SENSOR_ID_A);
+    EXPECT_EQ(FindPlan(plans, SENSOR_ID_B).alignedDelayNs, 1800 * MS_NS);
+    EXPECT_EQ(FindPlan(plans, SENSOR_ID_E).alignedDelayNs, 1800 * MS_NS);
+    EXPECT_TRUE(scheduler.RemoveSensor(SENSOR_ID_A).empty());
+}
+
+HWTEST_F(SensorBatchSchedulerTest, SensorBatchSchedulerTest_003, TestSize.Level1)
+{
+    SEN_HILOGI("SensorBatchSchedulerTest_003 in");
+    SensorBatchScheduler &scheduler = SensorBatchScheduler::GetInstance();
+    HdiServiceImpl &hdiService = HdiServiceImpl::GetInstance();
+    const std::vector<SensorBatchPlan> requests = {
+        { SENSOR_ID_A, 10 * MS_NS, SECOND_NS, 0 },
+        { SENSOR_ID_B, 20 * MS_NS, 2500 * MS_NS, 0 },
+        { SENSOR_ID_C, 100 * MS_NS, 3700 * MS_NS, 0 },
+    };
+    // Without alignment each client configures its sensor on its own
+    for (const auto &request : requests) {
+        ASSERT_EQ(hdiService.SetBatch(request.sensorId, request.samplingPeriodNs, request.requestDelayNs), ERR_OK);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    int64_t unalignedWakeups = hdiService.CountBatchWakeups(CHECK_DURATION_NS);
+    std::vector<SensorBatchPlan> plans;
+    for (const auto &request : requests) {
+        plans = scheduler.UpdateSensor(request.sensorId, request.samplingPeriodNs, request.requestDelayNs);
+    }
+    for (const auto &plan : plans) {
+        ASSERT_EQ(hdiService.SetBatch(plan.sensorId, plan.samplingPeriodNs, plan.alignedDelayNs), ERR_OK);
+    }
+    int64_t alignedWakeups = hdiService.CountBatchWakeups(CHECK_DURATION_NS);
+    SEN_HILOGI("Wakeups in 60s, unaligned:%{public}" PRId64 ", aligned:%{public}" PRId64,
+        unalignedWakeups, alignedWakeups);
+    EXPECT_LT(alignedWakeups, unalignedWakeups);
+    EXPECT_LE(alignedWakeups, CHECK_DURATION_NS / SECOND_NS);
+    EXPECT_GE(unalignedWakeups, static_cast<int64_t>(scheduler.GetWakeupRate(false) * 60) - 1);
+}
+} // namespace Sensors
+} // namespace OHOS
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sensor_dump_ring.h"
+#include "sensor_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "SensorDumpRingTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr size_t RING_CAPACITY = 16;
+constexpr int64_t STRESS_EVENT_NUM = 200000;
+
+SensorData MakeEvent(int64_t index)
+{
+    SensorData data = {};
+    data.sensorTypeId = 1;
+    data.timestamp = index;
+    data.dataLen = SENSOR_MAX_LENGTH;
+    // Every byte carries the index, a torn record would mix two of them
+    for (int32_t i = 0; i < SENSOR_MAX_LENGTH; ++i) {
+        data.data[i] = static_cast<uint8_t>(index);
+    }
+    return data;
+}
+
+bool IsConsistent(const SensorData &data)
+{
+    for (int32_t i = 0; i < SENSOR_MAX_LENGTH; ++i) {
+        if (data.data[i] != static_cast<uint8_t>(data.timestamp)) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+class SensorDumpRingTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void SensorDumpRingTest::SetUpTestCase() {}
+
+void SensorDumpRingTest::TearDownTestCase() {}
+
+void SensorDumpRingTest::SetUp() {}
+
+void SensorDumpRingTest::TearDown() {}
+
+HWTEST_F(SensorDumpRingTest, SensorDumpRingTest_001, TestSize.Level1)
+{
+    SEN_HILOGI("SensorDumpRingTest_001 in");
+    SensorDumpRing ring(RING_CAPACITY);
+    std::vector<SensorData> events;
+    EXPECT_EQ(ring.Snapshot(events), 0U);
+    for (int64_t i = 1; i <= 40; ++i) {
+        ring.Push(MakeEvent(i));
+    }
+    // Only the newest records survive, oldest first
+    ASSERT_EQ(ring.Snapshot(events), RING_CAPACITY);
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(events[i].timestamp, static_cast<int64_t>(40 - RING_CAPACITY + 1 + i));
+    }
+    events.clear();
+    ASSERT_EQ(ring.Snapshot(events, 30, 35), 6U);
+    EXPECT_EQ(events.front().timestamp, 30);
+    EXPECT_EQ(events.back().timestamp, 35);
+}
+
+HWTEST_F(SensorDumpRingTest, SensorDumpRingTest_002, TestSize.Level1)
+{
+    SEN_HILOGI("SensorDumpRingTest_002 in");
+    SensorDumpRing ring(RING_CAPACITY);
+    for (int64_t i = 1; i <= 10; ++i) {
+        ring.Push(MakeEvent(i));
+    }
+    ring.Clear();
+    std::vector<SensorData> events;
+    EXPECT_EQ(ring.Snapshot(events), 0U);
+    ring.Push(MakeEvent(11));
+    ASSERT_EQ(ring.Snapshot(events), 1U);
+    EXPECT_EQ(events[0].timestamp, 11);
+}
+
+HWTEST_F(SensorDumpRingTest, SensorDumpRingTest_003, TestSize.Level1)
+{
+    SEN_HILOGI("SensorDumpRingTest_003 in");
+    SensorDumpRing ring(RING_CAPACITY);
+    std::atomic_bool isDone = false;
+    std::thread writer([&ring, &isDone]() {
+        for (int64_t i = 1; i <= STRESS_EVENT_NUM; ++i) {
+            ring.Push(MakeEvent(i));
+        }
+        isDone = true;
+    });
+    std::vector<SensorData> events;
+    int64_t snapshotNum = 0;
+    while (!isDone) {
+        events.clear();
+        ring.Snapshot(events);
+        for (size_t i = 0; i < events.size(); ++i) {
+            ASSERT_TRUE(IsConsistent(events[i]));
+            if (i != 0) {
+                ASSERT_GT(events[i].timestamp, events[i - 1].timestamp);
+            }
+        }
+        ++snapshotNum;
+    }
+    writer.join();
+    events.clear();
+    ASSERT_EQ(ring.Snapshot(events), RING_CAPACITY);
+    EXPECT_EQ(events.back().timestamp, STRESS_EVENT_NUM);
+    EXPECT_GT(snapshotNum, 0);
+}
+} // namespace Sensors
+} // namespace OHOS
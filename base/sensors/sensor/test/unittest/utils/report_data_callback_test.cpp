@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "report_data_callback.h"
+#include "sensor_agent_type.h"
+#include "sensor_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "ReportDataCallbackTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr int32_t TEST_SENSOR_ID = 1;
+constexpr size_t TEST_BATCH_NUM = 50;
+constexpr int64_t TEST_PERIOD_NS = 10000000;
+constexpr int32_t STRESS_BATCH_ROUND = 2000;
+
+std::vector<SensorData> MakeBatch(int64_t firstTimestamp, size_t num)
+{
+    std::vector<SensorData> events(num);
+    for (size_t i = 0; i < num; ++i) {
+        events[i].sensorTypeId = TEST_SENSOR_ID;
+        events[i].timestamp = firstTimestamp + static_cast<int64_t>(i) * TEST_PERIOD_NS;
+        events[i].mode = SENSOR_FIFO_MODE;
+    }
+    return events;
+}
+
+size_t DrainEvents(sptr<ReportDataCallback> callback, std::vector<int64_t> &timestamps)
+{
+    std::vector<SensorData> events(CIRCULAR_BUF_LEN);
+    size_t total = 0;
+    size_t num = callback->PopEvents(events.data(), events.size());
+    while (num > 0) {
+        for (size_t i = 0; i < num; ++i) {
+            timestamps.push_back(events[i].timestamp);
+        }
+        total += num;
+        num = callback->PopEvents(events.data(), events.size());
+    }
+    return total;
+}
+} // namespace
+
+class ReportDataCallbackTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void ReportDataCallbackTest::SetUpTestCase() {}
+
+void ReportDataCallbackTest::TearDownTestCase() {}
+
+void ReportDataCallbackTest::SetUp() {}
+
+void ReportDataCallbackTest::TearDown() {}
+
+HWTEST_F(ReportDataCallbackTest, ReportDataCallbackTest_001, TestSize.Level1)
+{
+    SEN_HILOGI("ReportDataCallbackTest_001 in");
+    sptr<ReportDataCallback> callback = new (std::nothrow) ReportDataCallback();
+    ASSERT_NE(callback, nullptr);
+    std::vector<SensorData> batch = MakeBatch(0, TEST_BATCH_NUM);
+    EXPECT_EQ(callback->ReportEventsCallback(batch.data(), batch.size(), callback), ERR_OK);
+    std::vector<int64_t> timestamps;
+    ASSERT_EQ(DrainEvents(callback, timestamps), TEST_BATCH_NUM);
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        EXPECT_EQ(timestamps[i], batch[i].timestamp);
+    }
+    EXPECT_EQ(callback->GetOverflowCount(), 0U);
+    EXPECT_NE(callback->ReportEventsCallback(nullptr, 1, callback), ERR_OK);
+    EXPECT_NE(callback->ReportEventsCallback(batch.data(), batch.size(), nullptr), ERR_OK);
+}
+
+HWTEST_F(ReportDataCallbackTest, ReportDataCallbackTest_002, TestSize.Level1)
+{
+    SEN_HILOGI("ReportDataCallbackTest_002 in");
+    sptr<ReportDataCallback> callback = new (std::nothrow) ReportDataCallback();
+    ASSERT_NE(callback, nullptr);
+    std::vector<SensorData> fill = MakeBatch(0, CIRCULAR_BUF_LEN - TEST_BATCH_NUM / 2);
+    ASSERT_EQ(callback->ReportEventsCallback(fill.data(), fill.size(), callback), ERR_OK);
+    // Only part of the batch fits, the head of it is kept and the rest is counted as overflow
+    std::vector<SensorData> batch = MakeBatch(static_cast<int64_t>(fill.size()) * TEST_PERIOD_NS, TEST_BATCH_NUM);
+    EXPECT_NE(callback->ReportEventsCallback(batch.data(), batch.size(), callback), ERR_OK);
+    EXPECT_EQ(callback->GetOverflowCount(), TEST_BATCH_NUM - TEST_BATCH_NUM / 2);
+    std::vector<int64_t> timestamps;
+    ASSERT_EQ(DrainEvents(callback, timestamps), static_cast<size_t>(CIRCULAR_BUF_LEN));
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        EXPECT_EQ(timestamps[i], static_cast<int64_t>(i) * TEST_PERIOD_NS);
+    }
+}
+
+HWTEST_F(ReportDataCallbackTest, ReportDataCallbackTest_003, TestSize.Level1)
+{
+    SEN_HILOGI("ReportDataCallbackTest_003 in");
+    sptr<ReportDataCallback> callback = new (std::nothrow) ReportDataCallback();
+    ASSERT_NE(callback, nullptr);
+    std::thread producer([callback] {
+        for (int32_t round = 0; round < STRESS_BATCH_ROUND; ++round) {
+            std::vector<SensorData> batch =
+                MakeBatch(static_cast<int64_t>(round) * TEST_BATCH_NUM * TEST_PERIOD_NS, TEST_BATCH_NUM);
+            callback->ReportEventsCallback(batch.data(), batch.size(), callback);
+        }
+    });
+    std::vector<int64_t> timestamps;
+    uint64_t expected = static_cast<uint64_t>(STRESS_BATCH_ROUND) * TEST_BATCH_NUM;
+    while (timestamps.size() + callback->GetOverflowCount() < expected) {
+        callback->WaitEvents();
+        DrainEvents(callback, timestamps);
+    }
+    producer.join();
+    DrainEvents(callback, timestamps);
+    EXPECT_EQ(timestamps.size() + callback->GetOverflowCount(), expected);
+    for (size_t i = 1; i < timestamps.size(); ++i) {
+        ASSERT_LT(timestamps[i - 1], timestamps[i]);
+    }
+}
+} // namespace Sensors
+} // namespace OHOS
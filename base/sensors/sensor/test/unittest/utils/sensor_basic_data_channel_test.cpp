@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/socket.h>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sensor_agent_type.h"
+#include "sensor_basic_data_channel.h"
+#include "sensor_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "SensorBasicDataChannelTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr int32_t CONTINUOUS_SENSOR_ID = 1;
+constexpr int32_t ON_CHANGE_SENSOR_ID = 2;
+constexpr size_t EXTRA_EVENT_NUM = 10;
+constexpr size_t COALESCE_EVENT_NUM = 50;
+constexpr size_t MAX_FILL_EVENT_NUM = 100000;
+
+SensorData MakeEvent(int32_t sensorId, int32_t mode, int64_t timestamp)
+{
+    SensorData event = {};
+    event.sensorTypeId = sensorId;
+    event.mode = mode;
+    event.timestamp = timestamp;
+    return event;
+}
+
+// Sends single events until the socket is full, returns the number of events handed to the channel
+int64_t FillChannel(sptr<SensorBasicDataChannel> &channel)
+{
+    int64_t timestamp = 0;
+    bool hasPending = false;
+    while (!hasPending && (timestamp < static_cast<int64_t>(MAX_FILL_EVENT_NUM))) {
+        SensorData event = MakeEvent(CONTINUOUS_SENSOR_ID, SENSOR_REALTIME_MODE, timestamp++);
+        channel->SendOrQueueData(&event, 1, hasPending);
+    }
+    return timestamp;
+}
+
+// Reads everything the client can get, flushing the overflow queue whenever the socket is drained
+std::vector<SensorData> DrainChannel(sptr<SensorBasicDataChannel> &channel)
+{
+    std::vector<SensorData> received;
+    std::vector<SensorData> buff(MAX_SEND_BATCH_NUM);
+    bool hasPending = true;
+    while (true) {
+        ssize_t len = recv(channel->GetReceiveDataFd(), buff.data(), sizeof(SensorData) * buff.size(),
+            MSG_DONTWAIT);
+        if (len > 0) {
+            received.insert(received.end(), buff.begin(), buff.begin() + len / sizeof(SensorData));
+            continue;
+        }
+        if (!hasPending) {
+            break;
+        }
+        channel->FlushPendingData(hasPending);
+    }
+    return received;
+}
+} // namespace
+
+class SensorBasicDataChannelTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void SensorBasicDataChannelTest::SetUpTestCase() {}
+
+void SensorBasicDataChannelTest::TearDownTestCase() {}
+
+void SensorBasicDataChannelTest::SetUp() {}
+
+void SensorBasicDataChannelTest::TearDown() {}
+
+HWTEST_F(SensorBasicDataChannelTest, SensorBasicDataChannelTest_001, TestSize.Level1)
+{
+    SEN_HILOGI("SensorBasicDataChannelTest_001 in");
+    sptr<SensorBasicDataChannel> channel = new (std::nothrow) SensorBasicDataChannel();
+    ASSERT_NE(channel, nullptr);
+    ASSERT_EQ(channel->CreateSensorBasicChannel(), ERR_OK);
+    EXPECT_EQ(channel->GetOverflowPolicy(), DROP_OLDEST);
+    int64_t timestamp = FillChannel(channel);
+    ASSERT_LT(timestamp, static_cast<int64_t>(MAX_FILL_EVENT_NUM));
+    bool hasPending = false;
+    for (size_t i = 0; i < MAX_OVERFLOW_QUEUE_NUM + EXTRA_EVENT_NUM; ++i) {
+        SensorData event = MakeEvent(CONTINUOUS_SENSOR_ID, SENSOR_REALTIME_MODE, timestamp++);
+        EXPECT_NE(channel->SendOrQueueData(&event, 1, hasPending), ERR_OK);
+        EXPECT_TRUE(hasPending);
+    }
+    SensorChannelStats stats = channel->GetChannelStats();
+    EXPECT_EQ(stats.pendingNum, MAX_OVERFLOW_QUEUE_NUM);
+    EXPECT_EQ(stats.dropCount, EXTRA_EVENT_NUM + 1);
+    std::vector<SensorData> received = DrainChannel(channel);
+    ASSERT_EQ(received.size(), static_cast<size_t>(timestamp) - EXTRA_EVENT_NUM - 1);
+    for (size_t i = 1; i < received.size(); ++i) {
+        ASSERT_LT(received[i - 1].timestamp, received[i].timestamp);
+    }
+    EXPECT_EQ(received.back().timestamp, timestamp - 1);
+    stats = channel->GetChannelStats();
+    EXPECT_EQ(stats.pendingNum, 0U);
+    EXPECT_GT(stats.retryCount, 0U);
+    channel->DestroySensorBasicChannel();
+}
+
+HWTEST_F(SensorBasicDataChannelTest, SensorBasicDataChannelTest_002, TestSize.Level1)
+{
+    SEN_HILOGI("SensorBasicDataChannelTest_002 in");
+    sptr<SensorBasicDataChannel> channel = new (std::nothrow) SensorBasicDataChannel();
+    ASSERT_NE(channel, nullptr);
+    ASSERT_EQ(channel->CreateSensorBasicChannel(), ERR_OK);
+    channel->SetOverflowPolicy(DROP_NEWEST);
+    EXPECT_EQ(channel->GetOverflowPolicy(), DROP_NEWEST);
+    EXPECT_EQ(channel->GetChannelStats().overflowPolicy, DROP_NEWEST);
+    int64_t timestamp = FillChannel(channel);
+    ASSERT_LT(timestamp, static_cast<int64_t>(MAX_FILL_EVENT_NUM));
+    int64_t lastKept = timestamp + static_cast<int64_t>(MAX_OVERFLOW_QUEUE_NUM) - 2;
+    bool hasPending = false;
+    for (size_t i = 0; i < MAX_OVERFLOW_QUEUE_NUM + EXTRA_EVENT_NUM; ++i) {
+        SensorData event = MakeEvent(CONTINUOUS_SENSOR_ID, SENSOR_REALTIME_MODE, timestamp++);
+        channel->SendOrQueueData(&event, 1, hasPending);
+    }
+    EXPECT_EQ(channel->GetChannelStats().dropCount, EXTRA_EVENT_NUM + 1);
+    std::vector<SensorData> received = DrainChannel(channel);
+    ASSERT_EQ(received.size(), static_cast<size_t>(timestamp) - EXTRA_EVENT_NUM - 1);
+    EXPECT_EQ(received.back().timestamp, lastKept);
+    channel->DestroySensorBasicChannel();
+}
+
+HWTEST_F(SensorBasicDataChannelTest, SensorBasicDataChannelTest_003, TestSize.Level1)
+{
+    SEN_HILOGI("SensorBasicDataChannelTest_003 in");
+    sptr<SensorBasicDataChannel> channel = new (std::nothrow) SensorBasicDataChannel();
+    ASSERT_NE(channel, nullptr);
+    ASSERT_EQ(channel->CreateSensorBasicChannel(), ERR_OK);
+    int64_t timestamp = FillChannel(channel);
+    ASSERT_LT(timestamp, static_cast<int64_t>(MAX_FILL_EVENT_NUM));
+    bool hasPending = false;
+    for (size_t i = 0; i < COALESCE_EVENT_NUM; ++i) {
+        SensorData event = MakeEvent(ON_CHANGE_SENSOR_ID, SENSOR_ON_CHANGE, timestamp++);
+        channel->SendOrQueueData(&event, 1, hasPending);
+    }
+    SensorChannelStats stats = channel->GetChannelStats();
+    EXPECT_EQ(stats.pendingNum, 2U);
+    EXPECT_EQ(stats.dropCount, COALESCE_EVENT_NUM - 1);
+    std::vector<SensorData> received = DrainChannel(channel);
+    ASSERT_FALSE(received.empty());
+    EXPECT_EQ(received.back().sensorTypeId, ON_CHANGE_SENSOR_ID);
+    EXPECT_EQ(received.back().timestamp, timestamp - 1);
+    channel->SetOverflowPolicy(COALESCE_LATEST + 1);
+    EXPECT_EQ(channel->GetOverflowPolicy(), DROP_OLDEST);
+    channel->DestroySensorBasicChannel();
+}
+} // namespace Sensors
+} // namespace OHOS
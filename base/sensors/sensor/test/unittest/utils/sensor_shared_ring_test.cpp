@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sensor_errors.h"
+#include "sensor_shared_ring.h"
+
+#undef LOG_TAG
+#define LOG_TAG "SensorSharedRingTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr uint32_t TEST_CAPACITY = 16;
+constexpr int32_t TEST_SENSOR_ID = 1;
+constexpr uint64_t STRESS_EVENT_NUM = 200000;
+constexpr int32_t POLL_TIMEOUT_MS = 100;
+
+SensorData MakeEvent(int64_t timestamp)
+{
+    SensorData event = {};
+    event.sensorTypeId = TEST_SENSOR_ID;
+    event.timestamp = timestamp;
+    event.dataLen = sizeof(int64_t);
+    *reinterpret_cast<int64_t *>(event.data) = timestamp;
+    return event;
+}
+
+size_t DrainRing(SensorSharedRing &consumer, std::vector<int64_t> &timestamps)
+{
+    size_t total = 0;
+    const SensorData *events = nullptr;
+    size_t num = consumer.GetReadableData(&events);
+    while (num > 0) {
+        for (size_t i = 0; i < num; ++i) {
+            timestamps.push_back(events[i].timestamp);
+        }
+        consumer.ConsumeData(num);
+        total += num;
+        num = consumer.GetReadableData(&events);
+    }
+    return total;
+}
+} // namespace
+
+class SensorSharedRingTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void SensorSharedRingTest::SetUpTestCase() {}
+
+void SensorSharedRingTest::TearDownTestCase() {}
+
+void SensorSharedRingTest::SetUp() {}
+
+void SensorSharedRingTest::TearDown() {}
+
+HWTEST_F(SensorSharedRingTest, SensorSharedRingTest_001, TestSize.Level1)
+{
+    SEN_HILOGI("SensorSharedRingTest_001 in");
+    SensorSharedRing consumer;
+    ASSERT_EQ(consumer.Create(TEST_CAPACITY), ERR_OK);
+    SensorSharedRing producer;
+    ASSERT_EQ(producer.Attach(dup(consumer.GetMemFd())), ERR_OK);
+    EXPECT_EQ(producer.GetCapacity(), TEST_CAPACITY);
+    std::vector<SensorData> events;
+    for (int64_t i = 0; i < static_cast<int64_t>(TEST_CAPACITY / 2); ++i) {
+        events.push_back(MakeEvent(i));
+    }
+    bool needNotify = false;
+    EXPECT_EQ(producer.Write(events.data(), events.size(), needNotify), events.size());
+    EXPECT_TRUE(needNotify);
+    const SensorData *readEvents = nullptr;
+    ASSERT_EQ(consumer.GetReadableData(&readEvents), events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(readEvents[i].timestamp, events[i].timestamp);
+        EXPECT_EQ(*reinterpret_cast<const int64_t *>(readEvents[i].data), events[i].timestamp);
+    }
+    consumer.ConsumeData(events.size());
+    EXPECT_EQ(consumer.GetReadableData(&readEvents), 0U);
+}
+
+HWTEST_F(SensorSharedRingTest, SensorSharedRingTest_002, TestSize.Level1)
+{
+    SEN_HILOGI("SensorSharedRingTest_002 in");
+    SensorSharedRing consumer;
+    ASSERT_EQ(consumer.Create(TEST_CAPACITY), ERR_OK);
+    SensorSharedRing producer;
+    ASSERT_EQ(producer.Attach(dup(consumer.GetMemFd())), ERR_OK);
+    std::vector<SensorData> events;
+    for (int64_t i = 0; i < static_cast<int64_t>(TEST_CAPACITY + 5); ++i) {
+        events.push_back(MakeEvent(i));
+    }
+    bool needNotify = false;
+    EXPECT_EQ(producer.Write(events.data(), events.size(), needNotify), TEST_CAPACITY);
+    EXPECT_EQ(producer.GetDropCount(), 5U);
+    EXPECT_EQ(consumer.GetDropCount(), 5U);
+    EXPECT_EQ(producer.Write(events.data(), 1, needNotify), 0U);
+    EXPECT_EQ(consumer.GetDropCount(), 6U);
+    std::vector<int64_t> timestamps;
+    EXPECT_EQ(DrainRing(consumer, timestamps), TEST_CAPACITY);
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        EXPECT_EQ(timestamps[i], static_cast<int64_t>(i));
+    }
+}
+
+HWTEST_F(SensorSharedRingTest, SensorSharedRingTest_003, TestSize.Level1)
+{
+    SEN_HILOGI("SensorSharedRingTest_003 in");
+    SensorSharedRing consumer;
+    ASSERT_EQ(consumer.Create(TEST_CAPACITY), ERR_OK);
+    SensorSharedRing producer;
+    ASSERT_EQ(producer.Attach(dup(consumer.GetMemFd())), ERR_OK);
+    std::vector<int64_t> timestamps;
+    bool needNotify = false;
+    int64_t next = 0;
+    for (int32_t round = 0; round < 10; ++round) {
+        std::vector<SensorData> events;
+        for (uint32_t i = 0; i < TEST_CAPACITY - 3; ++i) {
+            events.push_back(MakeEvent(next++));
+        }
+        ASSERT_EQ(producer.Write(events.data(), events.size(), needNotify), events.size());
+        DrainRing(consumer, timestamps);
+    }
+    ASSERT_EQ(timestamps.size(), static_cast<size_t>(next));
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        EXPECT_EQ(timestamps[i], static_cast<int64_t>(i));
+    }
+    EXPECT_EQ(consumer.GetDropCount(), 0U);
+}
+
+HWTEST_F(SensorSharedRingTest, SensorSharedRingTest_004, TestSize.Level1)
+{
+    SEN_HILOGI("SensorSharedRingTest_004 in");
+    SensorSharedRing consumer;
+    ASSERT_EQ(consumer.Create(TEST_CAPACITY), ERR_OK);
+    SensorSharedRing producer;
+    ASSERT_EQ(producer.Attach(dup(consumer.GetMemFd())), ERR_OK);
+    SensorData event = MakeEvent(0);
+    bool needNotify = false;
+    producer.Write(&event, 1, needNotify);
+    EXPECT_TRUE(needNotify);
+    producer.Write(&event, 1, needNotify);
+    EXPECT_FALSE(needNotify);
+    EXPECT_FALSE(consumer.PrepareWait());
+    std::vector<int64_t> timestamps;
+    DrainRing(consumer, timestamps);
+    EXPECT_TRUE(consumer.PrepareWait());
+    producer.Write(&event, 1, needNotify);
+    EXPECT_TRUE(needNotify);
+}
+
+HWTEST_F(SensorSharedRingTest, SensorSharedRingTest_005, TestSize.Level1)
+{
+    SEN_HILOGI("SensorSharedRingTest_005 in");
+    SensorSharedRing consumer;
+    EXPECT_NE(consumer.Create(0), ERR_OK);
+    EXPECT_NE(consumer.Create(TEST_CAPACITY + 1), ERR_OK);
+    EXPECT_NE(consumer.Create(MAX_SHARED_RING_CAPACITY * 2), ERR_OK);
+    int32_t memFd = memfd_create("sensor_ring_test", MFD_CLOEXEC);
+    ASSERT_GE(memFd, 0);
+    std::vector<uint8_t> garbage(sizeof(SensorSharedRingHeader) + sizeof(SensorData) * TEST_CAPACITY, 0xA5);
+    ASSERT_EQ(write(memFd, garbage.data(), garbage.size()), static_cast<ssize_t>(garbage.size()));
+    SensorSharedRing producer;
+    EXPECT_EQ(producer.Attach(memFd), SENSOR_CHANNEL_SHARED_MEM_ERR);
+    EXPECT_EQ(producer.Attach(-1), SENSOR_CHANNEL_SHARED_MEM_ERR);
+    SensorData event = MakeEvent(0);
+    bool needNotify = false;
+    EXPECT_EQ(producer.Write(&event, 1, needNotify), 0U);
+}
+
+HWTEST_F(SensorSharedRingTest, SensorSharedRingTest_006, TestSize.Level1)
+{
+    SEN_HILOGI("SensorSharedRingTest_006 in");
+    SensorSharedRing consumer;
+    ASSERT_EQ(consumer.Create(DEFAULT_SHARED_RING_CAPACITY), ERR_OK);
+    SensorSharedRing producer;
+    ASSERT_EQ(producer.Attach(dup(consumer.GetMemFd())), ERR_OK);
+    int32_t doorbellFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ASSERT_GE(doorbellFd, 0);
+    std::thread producerThread([&producer, doorbellFd] {
+        for (uint64_t i = 0; i < STRESS_EVENT_NUM; ++i) {
+            SensorData event = MakeEvent(static_cast<int64_t>(i));
+            bool needNotify = false;
+            producer.Write(&event, 1, needNotify);
+            if (needNotify) {
+                eventfd_write(doorbellFd, 1);
+            }
+        }
+    });
+    std::vector<int64_t> timestamps;
+    uint64_t wakeups = 0;
+    bool lostWakeup = false;
+    while (timestamps.size() + consumer.GetDropCount() < STRESS_EVENT_NUM) {
+        struct pollfd pfd = { doorbellFd, POLLIN, 0 };
+        if (poll(&pfd, 1, POLL_TIMEOUT_MS) <= 0) {
+            const SensorData *events = nullptr;
+            if (consumer.GetReadableData(&events) > 0) {
+                lostWakeup = true;
+                break;
+            }
+            continue;
+        }
+        eventfd_t value = 0;
+        eventfd_read(doorbellFd, &value);
+        ++wakeups;
+        do {
+            DrainRing(consumer, timestamps);
+        } while (!consumer.PrepareWait());
+    }
+    producerThread.join();
+    close(doorbellFd);
+    ASSERT_FALSE(lostWakeup);
+    EXPECT_EQ(timestamps.size() + consumer.GetDropCount(), STRESS_EVENT_NUM);
+    for (size_t i = 1; i < timestamps.size(); ++i) {
+        ASSERT_LT(timestamps[i - 1], timestamps[i]);
+    }
+    EXPECT_LE(wakeups, STRESS_EVENT_NUM);
+}
+
+HWTEST_F(SensorSharedRingTest, SensorSharedRingTest_007, TestSize.Level1)
+{
+    SEN_HILOGI("SensorSharedRingTest_007 in");
+    SensorSharedRing consumer;
+    ASSERT_EQ(consumer.Create(TEST_CAPACITY), ERR_OK);
+    int32_t seals = fcntl(consumer.GetMemFd(), F_GET_SEALS);
+    EXPECT_EQ(seals & (F_SEAL_SHRINK | F_SEAL_GROW), F_SEAL_SHRINK | F_SEAL_GROW);
+    EXPECT_NE(ftruncate(consumer.GetMemFd(), 0), 0);
+    struct stat memStat = {};
+    ASSERT_EQ(fstat(consumer.GetMemFd(), &memStat), 0);
+    std::vector<uint8_t> ringCopy(static_cast<size_t>(memStat.st_size));
+    ASSERT_EQ(pread(consumer.GetMemFd(), ringCopy.data(), ringCopy.size(), 0), static_cast<ssize_t>(ringCopy.size()));
+    int32_t memFd = memfd_create("sensor_ring_test", MFD_CLOEXEC);
+    ASSERT_GE(memFd, 0);
+    ASSERT_EQ(write(memFd, ringCopy.data(), ringCopy.size()), static_cast<ssize_t>(ringCopy.size()));
+    SensorSharedRing producer;
+    EXPECT_EQ(producer.Attach(memFd), SENSOR_CHANNEL_SHARED_MEM_ERR);
+}
+} // namespace Sensors
+} // namespace OHOS
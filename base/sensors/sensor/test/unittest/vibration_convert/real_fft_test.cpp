@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "real_fft.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "RealFftTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr double PI_VALUE = 3.14159265358979323846;
+// Same scaling as RealFft::CalcMagnitudes
+constexpr double MAGNITUDE_SCALE = 2.0;
+constexpr double MAX_RELATIVE_ERROR = 1e-4;
+constexpr int32_t FFT_SIZES[] = { 4, 8, 64, 2048 };
+
+std::vector<float> MakeFrame(int32_t size)
+{
+    std::default_random_engine eng(1);
+    std::uniform_real_distribution<float> dist(-1.0F, 1.0F);
+    std::vector<float> frame(size);
+    for (auto &sample : frame) {
+        sample = dist(eng);
+    }
+    return frame;
+}
+
+std::vector<float> MakeHannWindow(int32_t size)
+{
+    std::vector<float> window(size);
+    for (int32_t i = 0; i < size; ++i) {
+        window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * PI_VALUE * i / size));
+    }
+    return window;
+}
+
+// Plain DFT of data * window, bins 0 to size / 2 - 1
+void CalcDft(const std::vector<float> &data, const std::vector<float> &window, std::vector<double> &magnitudes,
+    std::vector<double> &phases)
+{
+    size_t size = data.size();
+    magnitudes.assign(size / 2, 0.0);
+    phases.assign(size / 2, 0.0);
+    for (size_t k = 0; k < size / 2; ++k) {
+        double real = 0.0;
+        double imag = 0.0;
+        for (size_t n = 0; n < size; ++n) {
+            double angle = -2.0 * PI_VALUE * static_cast<double>(k * n) / size;
+            double sample = static_cast<double>(data[n]) * window[n];
+            real += sample * std::cos(angle);
+            imag += sample * std::sin(angle);
+        }
+        magnitudes[k] = MAGNITUDE_SCALE * std::sqrt(real * real + imag * imag);
+        phases[k] = std::atan2(imag, real);
+    }
+}
+} // namespace
+
+class RealFftTest : public testing::Test {
+public:
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: RealFftTest_001
+ * @tc.desc: Sizes that are not a power of 2, or out of range, are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(RealFftTest, RealFftTest_001, TestSize.Level1)
+{
+    RealFft realFft;
+    EXPECT_NE(realFft.Init(0), Sensors::SUCCESS);
+    EXPECT_NE(realFft.Init(2), Sensors::SUCCESS);
+    EXPECT_NE(realFft.Init(96), Sensors::SUCCESS);
+    EXPECT_NE(realFft.Init(131072), Sensors::SUCCESS);
+    EXPECT_EQ(realFft.Init(2048), Sensors::SUCCESS);
+    EXPECT_EQ(realFft.GetFftSize(), 2048);
+}
+
+/**
+ * @tc.name: RealFftTest_002
+ * @tc.desc: Magnitudes and phases match a plain DFT of the windowed frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(RealFftTest, RealFftTest_002, TestSize.Level1)
+{
+    for (int32_t size : FFT_SIZES) {
+        RealFft realFft;
+        ASSERT_EQ(realFft.Init(size), Sensors::SUCCESS);
+        std::vector<float> frame = MakeFrame(size);
+        std::vector<float> window = MakeHannWindow(size);
+        std::vector<float> magnitudes(size / 2, 0.0F);
+        std::vector<float> phases(size / 2, 0.0F);
+        realFft.CalcMagnitudes(frame.data(), window.data(), magnitudes.data());
+        realFft.CalcPhases(phases.data());
+
+        std::vector<double> expectedMagnitudes;
+        std::vector<double> expectedPhases;
+        CalcDft(frame, window, expectedMagnitudes, expectedPhases);
+        double maxMagnitude = 0.0;
+        for (double magnitude : expectedMagnitudes) {
+            maxMagnitude = std::max(maxMagnitude, magnitude);
+        }
+        double tolerance = MAX_RELATIVE_ERROR * maxMagnitude;
+        for (int32_t k = 0; k < size / 2; ++k) {
+            EXPECT_NEAR(magnitudes[k], expectedMagnitudes[k], tolerance) << "size:" << size << " bin:" << k;
+            // The phase of a bin close to 0 is only noise
+            if (expectedMagnitudes[k] > tolerance * size) {
+                double diff = std::remainder(phases[k] - expectedPhases[k], 2.0 * PI_VALUE);
+                EXPECT_NEAR(diff, 0.0, 1e-2) << "size:" << size << " bin:" << k;
+            }
+        }
+    }
+}
+} // namespace Sensors
+} // namespace OHOS
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sensors_errors.h"
+#include "utils.h"
+#include "vibration_convert_core.h"
+#include "vibration_convert_stream.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibrationConvertStreamTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr double PI_VALUE = 3.14159265358979323846;
+constexpr double INPUT_RATE = 44100.0;
+constexpr double TONE_AMP = 0.3;
+constexpr double TONE_FREQ = 440.0;
+constexpr double BURST_AMP = 0.5;
+constexpr size_t BURST_PERIOD = 11025;
+constexpr size_t BURST_LEN = 2048;
+constexpr size_t BLOCK_LEN = 4096;
+// Shorter than one segment
+constexpr size_t SHORT_CLIP_LEN = 88200;
+// Each sound is longer than the minimum segment, the silence between them is longer than the cut silence
+constexpr size_t SOUND_LEN = 131072;
+constexpr size_t SILENCE_LEN = 32768;
+// The stream cuts in the middle of the first SEGMENT_SILENCE_LEN (16384) silent samples
+constexpr size_t CUT_POS = SOUND_LEN + 8192;
+// A continuous sound reaching the maximum segment length (196608) with a short gap, cut in the middle of the gap
+constexpr size_t GAP_BEGIN = 163840;
+constexpr size_t GAP_LEN = 4096;
+constexpr size_t FORCED_CUT_POS = GAP_BEGIN + GAP_LEN / 2;
+constexpr size_t FORCED_CLIP_LEN = 233472;
+// The core keeps two of every four input samples
+constexpr size_t RESAMPLE_MULTIPLE = 4;
+constexpr size_t RESAMPLE_KEEP_COUNT = 2;
+
+// A tone with a decaying noise burst on every beat, so the clip has both transient and continuous events
+void AppendSound(size_t len, std::vector<double> &clip)
+{
+    std::default_random_engine eng(1);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    for (size_t i = 0; i < len; ++i) {
+        double sample = TONE_AMP * std::sin(2.0 * PI_VALUE * TONE_FREQ * static_cast<double>(i) / INPUT_RATE);
+        size_t burstPos = i % BURST_PERIOD;
+        if (burstPos < BURST_LEN) {
+            sample += BURST_AMP * noise(eng) * (1.0 - static_cast<double>(burstPos) / BURST_LEN);
+        }
+        clip.push_back(sample);
+    }
+}
+
+AudioSetting GetAudioSetting()
+{
+    AudioSetting audioSetting;
+    audioSetting.transientDetection = 30;
+    audioSetting.intensityTreshold = 30;
+    audioSetting.frequencyTreshold = 50;
+    audioSetting.frequencyMaxValue = 80;
+    audioSetting.frequencyMinValue = 20;
+    return audioSetting;
+}
+
+int32_t ConvertByBatch(const std::vector<double> &audio, std::vector<HapticEvent> &hapticEvents)
+{
+    VibrationConvertCore convertCore;
+    return convertCore.ConvertAudioToHaptic(GetAudioSetting(), audio, hapticEvents);
+}
+
+// Batch events of each segment, shifted by the segment start
+int32_t ConvertSegmentsByBatch(const std::vector<double> &clip, size_t cutPos, std::vector<HapticEvent> &hapticEvents)
+{
+    std::vector<double> firstSegment(clip.begin(), clip.begin() + cutPos);
+    std::vector<double> secondSegment(clip.begin() + cutPos, clip.end());
+    int32_t ret = ConvertByBatch(firstSegment, hapticEvents);
+    if (ret != Sensors::SUCCESS) {
+        return ret;
+    }
+    std::vector<HapticEvent> secondEvents;
+    ret = ConvertByBatch(secondSegment, secondEvents);
+    if (ret != Sensors::SUCCESS) {
+        return ret;
+    }
+    double beginTime = static_cast<double>(cutPos / RESAMPLE_MULTIPLE * RESAMPLE_KEEP_COUNT) / SAMPLE_RATE;
+    int32_t beginTimeMs = static_cast<int32_t>(round(beginTime * SAMPLE_IN_MS));
+    for (auto &event : secondEvents) {
+        event.startTime += beginTimeMs;
+        hapticEvents.push_back(event);
+    }
+    return Sensors::SUCCESS;
+}
+
+int32_t PushByBlock(VibrationConvertStream &stream, const std::vector<double> &audio,
+    std::vector<HapticEvent> &hapticEvents)
+{
+    for (size_t begin = 0; begin < audio.size(); begin += BLOCK_LEN) {
+        size_t end = std::min(begin + BLOCK_LEN, audio.size());
+        std::vector<double> block(audio.begin() + begin, audio.begin() + end);
+        int32_t ret = stream.PushAudioBlock(block, hapticEvents);
+        if (ret != Sensors::SUCCESS) {
+            return ret;
+        }
+    }
+    return Sensors::SUCCESS;
+}
+
+void ExpectSameEvents(const std::vector<HapticEvent> &actual, const std::vector<HapticEvent> &expected)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].vibrateTag, expected[i].vibrateTag);
+        EXPECT_EQ(actual[i].startTime, expected[i].startTime);
+        EXPECT_EQ(actual[i].duration, expected[i].duration);
+        EXPECT_EQ(actual[i].intensity, expected[i].intensity);
+        EXPECT_EQ(actual[i].frequency, expected[i].frequency);
+    }
+}
+} // namespace
+
+class VibrationConvertStreamTest : public testing::Test {
+public:
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: VibrationConvertStreamTest_001
+ * @tc.desc: A clip shorter than one segment gives the same events as the batch conversion
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibrationConvertStreamTest, VibrationConvertStreamTest_001, TestSize.Level1)
+{
+    std::vector<double> clip;
+    AppendSound(SHORT_CLIP_LEN, clip);
+    std::vector<HapticEvent> expected;
+    ASSERT_EQ(ConvertByBatch(clip, expected), Sensors::SUCCESS);
+    ASSERT_FALSE(expected.empty());
+
+    VibrationConvertStream stream(GetAudioSetting());
+    std::vector<HapticEvent> actual;
+    ASSERT_EQ(PushByBlock(stream, clip, actual), Sensors::SUCCESS);
+    EXPECT_TRUE(actual.empty());
+    ASSERT_EQ(stream.Finish(actual), Sensors::SUCCESS);
+    ExpectSameEvents(actual, expected);
+}
+
+/**
+ * @tc.name: VibrationConvertStreamTest_002
+ * @tc.desc: A clip cut in a silence gives the batch events of each segment, shifted by the segment start.
+ * Intensities and thresholds are relative to each segment, so the whole clip in one batch may give other events.
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibrationConvertStreamTest, VibrationConvertStreamTest_002, TestSize.Level1)
+{
+    std::vector<double> clip;
+    AppendSound(SOUND_LEN, clip);
+    clip.insert(clip.end(), SILENCE_LEN, 0.0);
+    AppendSound(SOUND_LEN, clip);
+
+    std::vector<double> firstSegment(clip.begin(), clip.begin() + CUT_POS);
+    std::vector<HapticEvent> firstEvents;
+    ASSERT_EQ(ConvertByBatch(firstSegment, firstEvents), Sensors::SUCCESS);
+    size_t firstEventNum = firstEvents.size();
+    ASSERT_NE(firstEventNum, 0U);
+    std::vector<HapticEvent> expected;
+    ASSERT_EQ(ConvertSegmentsByBatch(clip, CUT_POS, expected), Sensors::SUCCESS);
+    ASSERT_GT(expected.size(), firstEventNum);
+
+    VibrationConvertStream stream(GetAudioSetting());
+    std::vector<HapticEvent> actual;
+    std::vector<double> head(clip.begin(), clip.begin() + SOUND_LEN + SILENCE_LEN);
+    std::vector<double> rest(clip.begin() + SOUND_LEN + SILENCE_LEN, clip.end());
+    ASSERT_EQ(PushByBlock(stream, head, actual), Sensors::SUCCESS);
+    // The first segment is emitted as soon as the silence is long enough, before the end of the clip
+    EXPECT_EQ(actual.size(), firstEventNum);
+    ASSERT_EQ(PushByBlock(stream, rest, actual), Sensors::SUCCESS);
+    ASSERT_EQ(stream.Finish(actual), Sensors::SUCCESS);
+    ExpectSameEvents(actual, expected);
+}
+
+/**
+ * @tc.name: VibrationConvertStreamTest_003
+ * @tc.desc: Finish without any audio fails, and a finished stream takes a new clip
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibrationConvertStreamTest, VibrationConvertStreamTest_003, TestSize.Level1)
+{
+    VibrationConvertStream stream(GetAudioSetting());
+    std::vector<HapticEvent> actual;
+    EXPECT_NE(stream.Finish(actual), Sensors::SUCCESS);
+
+    std::vector<double> clip;
+    AppendSound(SHORT_CLIP_LEN, clip);
+    std::vector<HapticEvent> expected;
+    ASSERT_EQ(ConvertByBatch(clip, expected), Sensors::SUCCESS);
+    for (int32_t i = 0; i < 2; ++i) {
+        actual.clear();
+        ASSERT_EQ(PushByBlock(stream, clip, actual), Sensors::SUCCESS);
+        ASSERT_EQ(stream.Finish(actual), Sensors::SUCCESS);
+        ExpectSameEvents(actual, expected);
+    }
+}
+
+/**
+ * @tc.name: VibrationConvertStreamTest_004
+ * @tc.desc: A sound without long silence is cut when it reaches the maximum segment length,
+ * in the middle of its longest silence after the minimum segment length
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibrationConvertStreamTest, VibrationConvertStreamTest_004, TestSize.Level1)
+{
+    std::vector<double> clip;
+    AppendSound(GAP_BEGIN, clip);
+    clip.insert(clip.end(), GAP_LEN, 0.0);
+    AppendSound(FORCED_CLIP_LEN - GAP_BEGIN - GAP_LEN, clip);
+
+    std::vector<double> firstSegment(clip.begin(), clip.begin() + FORCED_CUT_POS);
+    std::vector<HapticEvent> firstEvents;
+    ASSERT_EQ(ConvertByBatch(firstSegment, firstEvents), Sensors::SUCCESS);
+    ASSERT_FALSE(firstEvents.empty());
+    std::vector<HapticEvent> expected;
+    ASSERT_EQ(ConvertSegmentsByBatch(clip, FORCED_CUT_POS, expected), Sensors::SUCCESS);
+    ASSERT_GT(expected.size(), firstEvents.size());
+
+    VibrationConvertStream stream(GetAudioSetting());
+    std::vector<HapticEvent> actual;
+    ASSERT_EQ(PushByBlock(stream, clip, actual), Sensors::SUCCESS);
+    // The first segment is emitted once the maximum length is reached, before the end of the clip
+    EXPECT_EQ(actual.size(), firstEvents.size());
+    ASSERT_EQ(stream.Finish(actual), Sensors::SUCCESS);
+    ExpectSameEvents(actual, expected);
+}
+} // namespace Sensors
+} // namespace OHOS
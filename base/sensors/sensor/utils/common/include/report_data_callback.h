@@ -16,28 +16,48 @@
 #ifndef REPORT_DATA_CALLBACK_H
 #define REPORT_DATA_CALLBACK_H
 
+#include <atomic>
+
 #include "refbase.h"
 #include "sensor_data_event.h"
 
 namespace OHOS {
 namespace Sensors {
+// Must be a power of two, the ring index is computed with a mask
 constexpr int32_t CIRCULAR_BUF_LEN = 1024;
 constexpr int32_t SENSOR_DATA_LENGTH = 64;
 
-struct CircularEventBuf {
-    struct SensorData *circularBuf;
-    int32_t readPos;
-    int32_t writePosition;
-    int32_t eventNum;
-};
-
+/*
+ * Lock-free event ring between the HDI callback threads and the OS_SenProducer thread.
+ * Producers never block: when the ring is full the newest event is dropped and counted.
+ * The consumer sleeps on an eventfd which is only written when it has announced that it is waiting,
+ * so a burst of events costs at most one wakeup.
+ */
 class ReportDataCallback : public RefBase {
 public:
     ReportDataCallback();
     ~ReportDataCallback();
     int32_t ReportEventCallback(SensorData *sensorData, sptr<ReportDataCallback> cb);
-    CircularEventBuf &GetEventData();
-    CircularEventBuf eventsBuf_;
+    int32_t ReportEventsCallback(const SensorData *events, size_t num, sptr<ReportDataCallback> cb);
+    int32_t WaitEvents();
+    size_t PopEvents(SensorData *events, size_t maxNum);
+    uint64_t GetOverflowCount() const;
+
+private:
+    struct EventSlot {
+        std::atomic<uint64_t> sequence;
+        SensorData data;
+    };
+    int32_t PushEvent(const SensorData &sensorData);
+    bool PushEvents(const SensorData *events, size_t num);
+    bool HasEvent() const;
+    void WakeupConsumer();
+    EventSlot *eventSlots_ = nullptr;
+    int32_t eventFd_ = -1;
+    alignas(64) std::atomic<uint64_t> writePos_ = 0;
+    alignas(64) uint64_t readPos_ = 0;
+    std::atomic_bool consumerWaiting_ = false;
+    std::atomic<uint64_t> overflowCount_ = 0;
 };
 
 using ReportDataCb = int32_t (ReportDataCallback::*)(SensorData *sensorData, sptr<ReportDataCallback> cb);
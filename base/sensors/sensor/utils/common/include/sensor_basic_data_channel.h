@@ -16,16 +16,48 @@
 #ifndef SENSOR_BASIC_DATA_CHANNEL_H
 #define SENSOR_BASIC_DATA_CHANNEL_H
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "message_parcel.h"
 #include "refbase.h"
 
 #include "sensor_data_event.h"
+#include "sensor_shared_ring.h"
 
 namespace OHOS {
 namespace Sensors {
+// Records per message, must not exceed the receive buffer of the client
+constexpr size_t MAX_SEND_BATCH_NUM = 100;
+
+enum SensorChannelType {
+    SOCKET_CHANNEL = 0,
+    // Records are written to a memfd ring mapped by both sides, only an eventfd doorbell is signalled
+    SHARED_MEM_CHANNEL = 1,
+};
+
+// What to give up when the overflow queue of a congested client is full
+enum SensorOverflowPolicy {
+    DROP_OLDEST = 0,
+    DROP_NEWEST = 1,
+    // Only the latest pending value of each sensor is kept, on-change events always use it
+    COALESCE_LATEST = 2,
+};
+
+// Records kept per channel while the client cannot keep up
+constexpr size_t MAX_OVERFLOW_QUEUE_NUM = 256;
+
+struct SensorChannelStats {
+    int32_t pid { -1 };
+    int32_t overflowPolicy { DROP_OLDEST };
+    size_t pendingNum { 0 };
+    uint64_t dropCount { 0 };
+    uint64_t retryCount { 0 };
+};
+
 class SensorBasicDataChannel : public RefBase {
 public:
     SensorBasicDataChannel();
@@ -38,17 +70,42 @@ public:
     int32_t SendToBinder(MessageParcel &data);
     void CloseSendFd();
     int32_t SendData(const void *vaddr, size_t size);
+    int32_t SendBatchData(const SensorData *events, size_t num, size_t &sentNum);
     int32_t ReceiveData(void *vaddr, size_t size);
     bool GetSensorStatus() const;
     void SetSensorStatus(bool isActive);
-    const std::unordered_map<int32_t, SensorData> &GetDataCacheBuf() const;
+    int32_t SendOrQueueData(const SensorData *events, size_t num, bool &hasPending);
+    int32_t FlushPendingData(bool &hasPending);
+    void ClearPendingData();
+    void SetOverflowPolicy(int32_t overflowPolicy);
+    int32_t GetOverflowPolicy() const;
+    SensorChannelStats GetChannelStats();
+    void SetPid(int32_t pid);
+    int32_t GetPid() const;
+    void SetChannelType(int32_t channelType);
+    // The ring stays valid for the holder of the returned pointer even if the channel is destroyed meanwhile
+    std::shared_ptr<SensorSharedRing> GetSharedRing() const;
+    uint64_t GetDropCount() const;
 
 private:
+    int32_t CreateSharedMemChannel();
+    void QueuePendingData(const SensorData *events, size_t num);
+    int32_t channelType_ = SOCKET_CHANNEL;
+    std::shared_ptr<SensorSharedRing> sharedRing_;
+    mutable std::mutex sharedRingMutex_;
     int32_t sendFd_;
     int32_t receiveFd_;
     bool isActive_;
     std::mutex statusLock_;
-    std::unordered_map<int32_t, SensorData> dataCacheBuf_;
+    std::atomic<int32_t> overflowPolicy_ = DROP_OLDEST;
+    // Serializes sending between the dispatch threads and the flusher, so that queued records go out first
+    std::mutex pendingMutex_;
+    std::vector<SensorData> pendingQueue_;
+    size_t pendingHead_ = 0;
+    size_t pendingNum_ = 0;
+    uint64_t overflowDropCount_ = 0;
+    uint64_t retryCount_ = 0;
+    std::atomic<int32_t> pid_ = -1;
 };
 } // namespace Sensors
 } // namespace OHOS
@@ -30,6 +30,9 @@ enum {
     ONE_SHOT_SENSOR = 4u,
 };
 
+// Set in SensorData::flags on the samples unpacked from a hardware FIFO batch
+constexpr uint32_t SENSOR_DATA_FLAG_HW_BATCH = 1u;
+
 struct SensorData {
     int32_t sensorTypeId;  /**< Sensor type ID */
     int32_t version;       /**< Sensor algorithm version */
@@ -38,6 +41,7 @@ struct SensorData {
     int32_t mode;          /**< Sensor data reporting mode (described in {@link SensorMode}) */
     uint8_t data[SENSOR_MAX_LENGTH];         /**< Sensor data */
     uint32_t dataLen;      /**< Sensor data length */
+    uint32_t flags;        /**< Marks set by the service (SENSOR_DATA_FLAG_*), 0 for the data of the drivers */
 };
 
 struct ExtraInfo {
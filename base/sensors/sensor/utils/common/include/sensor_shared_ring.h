@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SENSOR_SHARED_RING_H
+#define SENSOR_SHARED_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "nocopyable.h"
+
+#include "sensor_data_event.h"
+
+namespace OHOS {
+namespace Sensors {
+constexpr uint32_t DEFAULT_SHARED_RING_CAPACITY = 1024;
+constexpr uint32_t MAX_SHARED_RING_CAPACITY = 8192;
+
+// Placed at the start of the shared memory, followed by capacity records of SensorData
+struct SensorSharedRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t recordSize;
+    alignas(64) std::atomic<uint64_t> writePos;
+    std::atomic<uint64_t> dropCount;
+    alignas(64) std::atomic<uint64_t> readPos;
+    std::atomic<uint32_t> consumerWaiting;
+};
+
+/*
+ * Single producer, single consumer ring of SensorData in a memfd shared between the service
+ * (producer) and one client (consumer). The consumer creates the ring and passes the fd,
+ * the producer attaches to it and never trusts the positions written by the consumer.
+ */
+class SensorSharedRing {
+public:
+    SensorSharedRing() = default;
+    ~SensorSharedRing();
+    int32_t Create(uint32_t capacity);
+    int32_t Attach(int32_t memFd);
+    void Destroy();
+    int32_t GetMemFd() const;
+    void CloseMemFd();
+    uint32_t GetCapacity() const;
+    uint64_t GetDropCount() const;
+    size_t Write(const SensorData *events, size_t num, bool &needNotify);
+    size_t GetReadableData(const SensorData **events);
+    void ConsumeData(size_t num);
+    bool PrepareWait();
+
+private:
+    DISALLOW_COPY_AND_MOVE(SensorSharedRing);
+    int32_t Map(size_t size);
+    int32_t memFd_ { -1 };
+    void *addr_ { nullptr };
+    size_t size_ { 0 };
+    SensorSharedRingHeader *header_ { nullptr };
+    SensorData *slots_ { nullptr };
+    uint32_t capacity_ { 0 };
+    uint64_t writePos_ { 0 };
+    uint64_t readPos_ { 0 };
+};
+} // namespace Sensors
+} // namespace OHOS
+#endif // SENSOR_SHARED_RING_H
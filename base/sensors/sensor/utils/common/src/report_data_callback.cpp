@@ -14,6 +14,11 @@
  */
 
 #include "report_data_callback.h"
+
+#include <cerrno>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 #include "sensor_errors.h"
 
 #undef LOG_TAG
@@ -22,64 +27,189 @@
 namespace OHOS {
 namespace Sensors {
 using namespace OHOS::HiviewDFX;
+namespace {
+constexpr uint64_t RING_INDEX_MASK = static_cast<uint64_t>(CIRCULAR_BUF_LEN) - 1;
+constexpr uint64_t WAKEUP_VALUE = 1;
+} // namespace
 
 ReportDataCallback::ReportDataCallback()
 {
-    eventsBuf_.circularBuf = new (std::nothrow) SensorData[CIRCULAR_BUF_LEN];
-    CHKPL(eventsBuf_.circularBuf);
-    eventsBuf_.readPos = 0;
-    eventsBuf_.writePosition = 0;
-    eventsBuf_.eventNum = 0;
+    eventSlots_ = new (std::nothrow) EventSlot[CIRCULAR_BUF_LEN];
+    CHKPL(eventSlots_);
+    for (int32_t i = 0; i < CIRCULAR_BUF_LEN; ++i) {
+        eventSlots_[i].sequence.store(static_cast<uint64_t>(i), std::memory_order_relaxed);
+    }
+    eventFd_ = eventfd(0, EFD_CLOEXEC);
+    if (eventFd_ < 0) {
+        SEN_HILOGE("Create eventfd failed, errno:%{public}d", errno);
+    }
 }
 
 ReportDataCallback::~ReportDataCallback()
 {
-    if (eventsBuf_.circularBuf != nullptr) {
-        delete[] eventsBuf_.circularBuf;
-        eventsBuf_.circularBuf = nullptr;
-    }
-    eventsBuf_.circularBuf = nullptr;
-    eventsBuf_.readPos = 0;
-    eventsBuf_.writePosition = 0;
-    eventsBuf_.eventNum = 0;
+    if (eventSlots_ != nullptr) {
+        delete[] eventSlots_;
+        eventSlots_ = nullptr;
+    }
+    if (eventFd_ >= 0) {
+        close(eventFd_);
+        eventFd_ = -1;
+    }
 }
 
 int32_t ReportDataCallback::ReportEventCallback(SensorData *sensorData, sptr<ReportDataCallback> cb)
 {
     CHKPR(sensorData, ERROR);
-    if (cb == nullptr || cb->eventsBuf_.circularBuf == nullptr) {
-        SEN_HILOGE("Callback or circularBuf or event cannot be null");
+    if (cb == nullptr || cb->eventSlots_ == nullptr) {
+        SEN_HILOGE("Callback or eventSlots cannot be null");
         return ERROR;
     }
-    int32_t leftSize = CIRCULAR_BUF_LEN - cb->eventsBuf_.eventNum;
-    int32_t toEndLen = CIRCULAR_BUF_LEN - cb->eventsBuf_.writePosition;
-    if (leftSize < 0 || toEndLen < 0) {
-        SEN_HILOGE("Leftsize and toendlen cannot be less than zero");
+    return cb->PushEvent(*sensorData);
+}
+
+int32_t ReportDataCallback::PushEvent(const SensorData &sensorData)
+{
+    uint64_t pos = writePos_.load(std::memory_order_relaxed);
+    EventSlot *slot = nullptr;
+    while (true) {
+        slot = &eventSlots_[pos & RING_INDEX_MASK];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (writePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            overflowCount_.fetch_add(1, std::memory_order_relaxed);
+            WakeupConsumer();
+            return ERROR;
+        } else {
+            pos = writePos_.load(std::memory_order_relaxed);
+        }
+    }
+    slot->data = sensorData;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    WakeupConsumer();
+    return ERR_OK;
+}
+
+int32_t ReportDataCallback::ReportEventsCallback(const SensorData *events, size_t num, sptr<ReportDataCallback> cb)
+{
+    CHKPR(events, ERROR);
+    if (cb == nullptr || cb->eventSlots_ == nullptr) {
+        SEN_HILOGE("Callback or eventSlots cannot be null");
         return ERROR;
     }
-    if (toEndLen == 0) {
-            cb->eventsBuf_.circularBuf[0] = *sensorData;
-            cb->eventsBuf_.writePosition = 1;
-    } else {
-            cb->eventsBuf_.circularBuf[cb->eventsBuf_.writePosition] = *sensorData;
-            cb->eventsBuf_.writePosition += 1;
+    if (num == 0) {
+        return ERR_OK;
+    }
+    if (cb->PushEvents(events, num)) {
+        return ERR_OK;
+    }
+    // Not enough room for the whole batch, keep as many events as fit and count the rest as overflow
+    int32_t ret = ERR_OK;
+    for (size_t i = 0; i < num; ++i) {
+        if (cb->PushEvent(events[i]) != ERR_OK) {
+            ret = ERROR;
+        }
+    }
+    return ret;
+}
+
+bool ReportDataCallback::PushEvents(const SensorData *events, size_t num)
+{
+    if (num > static_cast<size_t>(CIRCULAR_BUF_LEN)) {
+        return false;
+    }
+    uint64_t pos = writePos_.load(std::memory_order_relaxed);
+    while (true) {
+        // The consumer frees slots in order, so the last slot being free means the whole range is
+        const EventSlot &lastSlot = eventSlots_[(pos + num - 1) & RING_INDEX_MASK];
+        uint64_t sequence = lastSlot.sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + num - 1);
+        if (diff == 0) {
+            if (writePos_.compare_exchange_weak(pos, pos + num, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = writePos_.load(std::memory_order_relaxed);
+        }
     }
-    if (leftSize < 1) {
-        cb->eventsBuf_.readPos = cb->eventsBuf_.writePosition;
+    for (size_t i = 0; i < num; ++i) {
+        EventSlot &slot = eventSlots_[(pos + i) & RING_INDEX_MASK];
+        slot.data = events[i];
+        slot.sequence.store(pos + i + 1, std::memory_order_release);
     }
-    cb->eventsBuf_.eventNum += 1;
-    if (cb->eventsBuf_.eventNum >= CIRCULAR_BUF_LEN) {
-        cb->eventsBuf_.eventNum = CIRCULAR_BUF_LEN;
+    WakeupConsumer();
+    return true;
+}
+
+void ReportDataCallback::WakeupConsumer()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!consumerWaiting_.load(std::memory_order_relaxed) || !consumerWaiting_.exchange(false)) {
+        return;
     }
-    if (cb->eventsBuf_.writePosition == CIRCULAR_BUF_LEN) {
-        cb->eventsBuf_.writePosition = 0;
+    ssize_t ret;
+    do {
+        ret = write(eventFd_, &WAKEUP_VALUE, sizeof(WAKEUP_VALUE));
+    } while (ret < 0 && errno == EINTR);
+}
+
+bool ReportDataCallback::HasEvent() const
+{
+    const EventSlot &slot = eventSlots_[readPos_ & RING_INDEX_MASK];
+    return slot.sequence.load(std::memory_order_acquire) == readPos_ + 1;
+}
+
+int32_t ReportDataCallback::WaitEvents()
+{
+    CHKPR(eventSlots_, ERROR);
+    if (eventFd_ < 0) {
+        SEN_HILOGE("eventFd_ is invalid");
+        return ERROR;
+    }
+    if (HasEvent()) {
+        return ERR_OK;
     }
+    consumerWaiting_.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (HasEvent()) {
+        consumerWaiting_.store(false);
+        return ERR_OK;
+    }
+    uint64_t value = 0;
+    ssize_t ret;
+    do {
+        ret = read(eventFd_, &value, sizeof(value));
+    } while (ret < 0 && errno == EINTR);
     return ERR_OK;
 }
 
-CircularEventBuf &ReportDataCallback::GetEventData()
+size_t ReportDataCallback::PopEvents(SensorData *events, size_t maxNum)
+{
+    if (events == nullptr || eventSlots_ == nullptr) {
+        SEN_HILOGE("events or eventSlots cannot be null");
+        return 0;
+    }
+    size_t num = 0;
+    while (num < maxNum) {
+        EventSlot &slot = eventSlots_[readPos_ & RING_INDEX_MASK];
+        if (slot.sequence.load(std::memory_order_acquire) != readPos_ + 1) {
+            break;
+        }
+        events[num++] = slot.data;
+        slot.sequence.store(readPos_ + CIRCULAR_BUF_LEN, std::memory_order_release);
+        ++readPos_;
+    }
+    return num;
+}
+
+uint64_t ReportDataCallback::GetOverflowCount() const
 {
-    return eventsBuf_;
+    return overflowCount_.load(std::memory_order_relaxed);
 }
 } // namespace Sensors
 } // namespace OHOS
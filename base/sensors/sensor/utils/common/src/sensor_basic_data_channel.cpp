@@ -15,11 +15,15 @@
 
 #include "sensor_basic_data_channel.h"
 
+#include <algorithm>
 #include <fcntl.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "hisysevent.h"
+#include "sensor_agent_type.h"
 #include "sensor_errors.h"
 
 #undef LOG_TAG
@@ -33,6 +37,7 @@ namespace {
 constexpr int32_t SENSOR_READ_DATA_SIZE = sizeof(SensorData) * 100;
 constexpr int32_t DEFAULT_CHANNEL_SIZE = 2 * 1024;
 constexpr int32_t SOCKET_PAIR_SIZE = 2;
+constexpr uint32_t MAX_SEND_MSG_NUM = 16;
 }  // namespace
 
 SensorBasicDataChannel::SensorBasicDataChannel() : sendFd_(-1), receiveFd_(-1), isActive_(false)
@@ -46,6 +51,9 @@ int32_t SensorBasicDataChannel::CreateSensorBasicChannel()
         SEN_HILOGD("Already create socketpair");
         return ERR_OK;
     }
+    if (channelType_ == SHARED_MEM_CHANNEL) {
+        return CreateSharedMemChannel();
+    }
 
     int32_t socketPair[SOCKET_PAIR_SIZE] = { 0 };
     if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, socketPair) != 0) {
@@ -93,6 +101,32 @@ int32_t SensorBasicDataChannel::CreateSensorBasicChannel()
     return SENSOR_CHANNEL_SOCKET_CREATE_ERR;
 }
 
+int32_t SensorBasicDataChannel::CreateSharedMemChannel()
+{
+    auto sharedRing = std::make_shared<SensorSharedRing>();
+    int32_t ret = sharedRing->Create(DEFAULT_SHARED_RING_CAPACITY);
+    if (ret != ERR_OK) {
+        SEN_HILOGE("Create shared ring failed, ret:%{public}d", ret);
+        return ret;
+    }
+    int32_t doorbellFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (doorbellFd < 0) {
+        SEN_HILOGE("Create eventfd failed, errno:%{public}d", errno);
+        return SENSOR_CHANNEL_SHARED_MEM_ERR;
+    }
+    int32_t sendFd = dup(doorbellFd);
+    if (sendFd < 0) {
+        SEN_HILOGE("Dup eventfd failed, errno:%{public}d", errno);
+        close(doorbellFd);
+        return SENSOR_CHANNEL_SHARED_MEM_ERR;
+    }
+    std::lock_guard<std::mutex> sharedRingLock(sharedRingMutex_);
+    sharedRing_ = std::move(sharedRing);
+    sendFd_ = sendFd;
+    receiveFd_ = doorbellFd;
+    return ERR_OK;
+}
+
 int32_t SensorBasicDataChannel::CreateSensorBasicChannel(MessageParcel &data)
 {
     CALL_LOG_ENTER;
@@ -106,6 +140,20 @@ int32_t SensorBasicDataChannel::CreateSensorBasicChannel(MessageParcel &data)
         sendFd_ = -1;
         return SENSOR_CHANNEL_READ_DESCRIPTOR_ERR;
     }
+    channelType_ = data.ReadInt32();
+    if (channelType_ != SHARED_MEM_CHANNEL) {
+        channelType_ = SOCKET_CHANNEL;
+        return ERR_OK;
+    }
+    auto sharedRing = std::make_shared<SensorSharedRing>();
+    int32_t ret = sharedRing->Attach(data.ReadFileDescriptor());
+    if (ret != ERR_OK) {
+        SEN_HILOGE("Attach shared ring failed, ret:%{public}d", ret);
+        CloseSendFd();
+        return ret;
+    }
+    std::lock_guard<std::mutex> sharedRingLock(sharedRingMutex_);
+    sharedRing_ = std::move(sharedRing);
     return ERR_OK;
 }
 
@@ -127,6 +175,18 @@ int32_t SensorBasicDataChannel::SendToBinder(MessageParcel &data)
         CloseSendFd();
         return SENSOR_CHANNEL_WRITE_DESCRIPTOR_ERR;
     }
+    if (!data.WriteInt32(channelType_)) {
+        SEN_HILOGE("Send channelType failed");
+        return SENSOR_CHANNEL_WRITE_DESCRIPTOR_ERR;
+    }
+    if (channelType_ == SHARED_MEM_CHANNEL) {
+        std::lock_guard<std::mutex> sharedRingLock(sharedRingMutex_);
+        CHKPR(sharedRing_, SENSOR_CHANNEL_BASIC_CHANNEL_NOT_INIT);
+        if (!data.WriteFileDescriptor(sharedRing_->GetMemFd())) {
+            SEN_HILOGE("Send memFd failed");
+            return SENSOR_CHANNEL_WRITE_DESCRIPTOR_ERR;
+        }
+    }
     return ERR_OK;
 }
 
@@ -137,6 +197,10 @@ void SensorBasicDataChannel::CloseSendFd()
         sendFd_ = -1;
         SEN_HILOGD("Close sendFd_");
     }
+    std::lock_guard<std::mutex> sharedRingLock(sharedRingMutex_);
+    if (sharedRing_ != nullptr) {
+        sharedRing_->CloseMemFd();
+    }
 }
 
 int32_t SensorBasicDataChannel::SendData(const void *vaddr, size_t size)
@@ -146,6 +210,10 @@ int32_t SensorBasicDataChannel::SendData(const void *vaddr, size_t size)
         SEN_HILOGE("Failed, param is invalid");
         return SENSOR_CHANNEL_SEND_ADDR_ERR;
     }
+    if (channelType_ == SHARED_MEM_CHANNEL) {
+        size_t sentNum = 0;
+        return SendBatchData(static_cast<const SensorData *>(vaddr), size / sizeof(SensorData), sentNum);
+    }
     ssize_t length;
     do {
         length = send(sendFd_, vaddr, size, MSG_DONTWAIT | MSG_NOSIGNAL);
@@ -157,6 +225,58 @@ int32_t SensorBasicDataChannel::SendData(const void *vaddr, size_t size)
     return ERR_OK;
 }
 
+int32_t SensorBasicDataChannel::SendBatchData(const SensorData *events, size_t num, size_t &sentNum)
+{
+    sentNum = 0;
+    CHKPR(events, SENSOR_CHANNEL_SEND_ADDR_ERR);
+    if (sendFd_ < 0) {
+        SEN_HILOGE("Failed, param is invalid");
+        return SENSOR_CHANNEL_SEND_ADDR_ERR;
+    }
+    if (channelType_ == SHARED_MEM_CHANNEL) {
+        std::lock_guard<std::mutex> sharedRingLock(sharedRingMutex_);
+        CHKPR(sharedRing_, SENSOR_CHANNEL_BASIC_CHANNEL_NOT_INIT);
+        bool needNotify = false;
+        sentNum = sharedRing_->Write(events, num, needNotify);
+        if (needNotify && (eventfd_write(sendFd_, 1) != 0)) {
+            SEN_HILOGD("Ring doorbell failed, errno:%{public}d", errno);
+        }
+        return (sentNum == num) ? ERR_OK : SENSOR_CHANNEL_SEND_DATA_ERR;
+    }
+    struct iovec iovs[MAX_SEND_MSG_NUM];
+    struct mmsghdr msgs[MAX_SEND_MSG_NUM];
+    while (sentNum < num) {
+        uint32_t msgNum = 0;
+        size_t offset = sentNum;
+        while ((offset < num) && (msgNum < MAX_SEND_MSG_NUM)) {
+            size_t count = std::min(num - offset, MAX_SEND_BATCH_NUM);
+            iovs[msgNum].iov_base = const_cast<SensorData *>(events + offset);
+            iovs[msgNum].iov_len = count * sizeof(SensorData);
+            msgs[msgNum] = {};
+            msgs[msgNum].msg_hdr.msg_iov = &iovs[msgNum];
+            msgs[msgNum].msg_hdr.msg_iovlen = 1;
+            offset += count;
+            ++msgNum;
+        }
+        int32_t ret;
+        do {
+            ret = sendmmsg(sendFd_, msgs, msgNum, MSG_DONTWAIT | MSG_NOSIGNAL);
+        } while ((ret < 0) && (errno == EINTR));
+        if (ret <= 0) {
+            SEN_HILOGD("Send fail:%{public}d, ret:%{public}d", errno, ret);
+            return SENSOR_CHANNEL_SEND_DATA_ERR;
+        }
+        for (int32_t i = 0; i < ret; ++i) {
+            sentNum += iovs[i].iov_len / sizeof(SensorData);
+        }
+        if (static_cast<uint32_t>(ret) < msgNum) {
+            SEN_HILOGD("Send partly, sent:%{public}d, total:%{public}u", ret, msgNum);
+            return SENSOR_CHANNEL_SEND_DATA_ERR;
+        }
+    }
+    return ERR_OK;
+}
+
 int32_t SensorBasicDataChannel::ReceiveData(void *vaddr, size_t size)
 {
     if ((vaddr == nullptr) || (receiveFd_ < 0)) {
@@ -192,12 +312,122 @@ int32_t SensorBasicDataChannel::DestroySensorBasicChannel()
         receiveFd_ = -1;
         SEN_HILOGD("Close receiveFd_ success");
     }
+    std::lock_guard<std::mutex> sharedRingLock(sharedRingMutex_);
+    sharedRing_.reset();
     return ERR_OK;
 }
 
-const std::unordered_map<int32_t, SensorData> &SensorBasicDataChannel::GetDataCacheBuf() const
+int32_t SensorBasicDataChannel::SendOrQueueData(const SensorData *events, size_t num, bool &hasPending)
+{
+    hasPending = false;
+    CHKPR(events, SENSOR_CHANNEL_SEND_ADDR_ERR);
+    if (channelType_ == SHARED_MEM_CHANNEL) {
+        // The ring is the buffer of a shared memory channel, what does not fit is counted as dropped by it
+        size_t sentNum = 0;
+        return SendBatchData(events, num, sentNum);
+    }
+    std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+    if (pendingNum_ != 0) {
+        QueuePendingData(events, num);
+        hasPending = true;
+        return SENSOR_CHANNEL_SEND_DATA_ERR;
+    }
+    size_t sentNum = 0;
+    int32_t ret = SendBatchData(events, num, sentNum);
+    if (sentNum < num) {
+        QueuePendingData(events + sentNum, num - sentNum);
+        hasPending = (pendingNum_ != 0);
+    }
+    return ret;
+}
+
+void SensorBasicDataChannel::QueuePendingData(const SensorData *events, size_t num)
 {
-    return dataCacheBuf_;
+    if (pendingQueue_.empty()) {
+        pendingQueue_.resize(MAX_OVERFLOW_QUEUE_NUM);
+    }
+    int32_t overflowPolicy = overflowPolicy_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < num; ++i) {
+        const SensorData &event = events[i];
+        if ((overflowPolicy == COALESCE_LATEST) || (event.mode == SENSOR_ON_CHANGE)) {
+            bool coalesced = false;
+            for (size_t j = 0; j < pendingNum_; ++j) {
+                SensorData &pending = pendingQueue_[(pendingHead_ + j) % MAX_OVERFLOW_QUEUE_NUM];
+                if (pending.sensorTypeId == event.sensorTypeId) {
+                    pending = event;
+                    coalesced = true;
+                    break;
+                }
+            }
+            if (coalesced) {
+                ++overflowDropCount_;
+                continue;
+            }
+        }
+        if (pendingNum_ == MAX_OVERFLOW_QUEUE_NUM) {
+            ++overflowDropCount_;
+            if (overflowPolicy == DROP_NEWEST) {
+                continue;
+            }
+            pendingHead_ = (pendingHead_ + 1) % MAX_OVERFLOW_QUEUE_NUM;
+            --pendingNum_;
+        }
+        pendingQueue_[(pendingHead_ + pendingNum_) % MAX_OVERFLOW_QUEUE_NUM] = event;
+        ++pendingNum_;
+    }
+}
+
+int32_t SensorBasicDataChannel::FlushPendingData(bool &hasPending)
+{
+    std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+    int32_t ret = ERR_OK;
+    while (pendingNum_ != 0) {
+        ++retryCount_;
+        size_t num = std::min(pendingNum_, MAX_OVERFLOW_QUEUE_NUM - pendingHead_);
+        size_t sentNum = 0;
+        ret = SendBatchData(pendingQueue_.data() + pendingHead_, num, sentNum);
+        pendingHead_ = (pendingHead_ + sentNum) % MAX_OVERFLOW_QUEUE_NUM;
+        pendingNum_ -= sentNum;
+        if (ret != ERR_OK) {
+            break;
+        }
+    }
+    hasPending = (pendingNum_ != 0);
+    return ret;
+}
+
+void SensorBasicDataChannel::ClearPendingData()
+{
+    std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+    overflowDropCount_ += pendingNum_;
+    pendingHead_ = 0;
+    pendingNum_ = 0;
+}
+
+void SensorBasicDataChannel::SetOverflowPolicy(int32_t overflowPolicy)
+{
+    if ((overflowPolicy < DROP_OLDEST) || (overflowPolicy > COALESCE_LATEST)) {
+        SEN_HILOGE("Invalid overflow policy:%{public}d", overflowPolicy);
+        return;
+    }
+    overflowPolicy_.store(overflowPolicy, std::memory_order_relaxed);
+}
+
+int32_t SensorBasicDataChannel::GetOverflowPolicy() const
+{
+    return overflowPolicy_.load(std::memory_order_relaxed);
+}
+
+SensorChannelStats SensorBasicDataChannel::GetChannelStats()
+{
+    SensorChannelStats stats;
+    stats.pid = GetPid();
+    stats.overflowPolicy = GetOverflowPolicy();
+    std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+    stats.pendingNum = pendingNum_;
+    stats.dropCount = overflowDropCount_ + GetDropCount();
+    stats.retryCount = retryCount_;
+    return stats;
 }
 
 bool SensorBasicDataChannel::GetSensorStatus() const
@@ -205,6 +435,33 @@ bool SensorBasicDataChannel::GetSensorStatus() const
     return isActive_;
 }
 
+void SensorBasicDataChannel::SetPid(int32_t pid)
+{
+    pid_.store(pid, std::memory_order_release);
+}
+
+int32_t SensorBasicDataChannel::GetPid() const
+{
+    return pid_.load(std::memory_order_acquire);
+}
+
+void SensorBasicDataChannel::SetChannelType(int32_t channelType)
+{
+    channelType_ = channelType;
+}
+
+std::shared_ptr<SensorSharedRing> SensorBasicDataChannel::GetSharedRing() const
+{
+    std::lock_guard<std::mutex> sharedRingLock(sharedRingMutex_);
+    return sharedRing_;
+}
+
+uint64_t SensorBasicDataChannel::GetDropCount() const
+{
+    std::lock_guard<std::mutex> sharedRingLock(sharedRingMutex_);
+    return (sharedRing_ == nullptr) ? 0 : sharedRing_->GetDropCount();
+}
+
 void SensorBasicDataChannel::SetSensorStatus(bool isActive)
 {
     SEN_HILOGD("isActive_:%{public}d", isActive);
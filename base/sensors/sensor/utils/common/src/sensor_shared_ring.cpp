@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sensor_shared_ring.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sensor_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "SensorSharedRing"
+
+namespace OHOS {
+namespace Sensors {
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr uint32_t SHARED_RING_MAGIC = 0x53524E47;
+constexpr uint32_t SHARED_RING_VERSION = 1;
+constexpr size_t HEADER_SIZE = (sizeof(SensorSharedRingHeader) + 63) & ~static_cast<size_t>(63);
+// The size of the memory can no longer change once sealed, so the mapping never faults on a truncated file
+constexpr int32_t SHARED_RING_SEALS = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+bool IsValidCapacity(uint32_t capacity)
+{
+    return (capacity != 0) && (capacity <= MAX_SHARED_RING_CAPACITY) && ((capacity & (capacity - 1)) == 0);
+}
+} // namespace
+
+SensorSharedRing::~SensorSharedRing()
+{
+    Destroy();
+}
+
+int32_t SensorSharedRing::Map(size_t size)
+{
+    void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memFd_, 0);
+    if (addr == MAP_FAILED) {
+        SEN_HILOGE("mmap failed, errno:%{public}d", errno);
+        return SENSOR_CHANNEL_SHARED_MEM_ERR;
+    }
+    addr_ = addr;
+    size_ = size;
+    header_ = static_cast<SensorSharedRingHeader *>(addr);
+    slots_ = reinterpret_cast<SensorData *>(static_cast<uint8_t *>(addr) + HEADER_SIZE);
+    return ERR_OK;
+}
+
+int32_t SensorSharedRing::Create(uint32_t capacity)
+{
+    if (addr_ != nullptr) {
+        SEN_HILOGD("Already create shared ring");
+        return ERR_OK;
+    }
+    if (!IsValidCapacity(capacity)) {
+        SEN_HILOGE("Invalid capacity:%{public}u", capacity);
+        return SENSOR_CHANNEL_SHARED_MEM_ERR;
+    }
+    memFd_ = memfd_create("sensor_data_ring", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memFd_ < 0) {
+        SEN_HILOGE("memfd_create failed, errno:%{public}d", errno);
+        return SENSOR_CHANNEL_SHARED_MEM_ERR;
+    }
+    size_t size = HEADER_SIZE + sizeof(SensorData) * capacity;
+    if ((ftruncate(memFd_, static_cast<off_t>(size)) != 0) || (fcntl(memFd_, F_ADD_SEALS, SHARED_RING_SEALS) != 0) ||
+        (Map(size) != ERR_OK)) {
+        SEN_HILOGE("Init shared memory failed, errno:%{public}d", errno);
+        Destroy();
+        return SENSOR_CHANNEL_SHARED_MEM_ERR;
+    }
+    new (header_) SensorSharedRingHeader();
+    header_->magic = SHARED_RING_MAGIC;
+    header_->version = SHARED_RING_VERSION;
+    header_->capacity = capacity;
+    header_->recordSize = sizeof(SensorData);
+    header_->writePos.store(0, std::memory_order_relaxed);
+    header_->dropCount.store(0, std::memory_order_relaxed);
+    header_->readPos.store(0, std::memory_order_relaxed);
+    header_->consumerWaiting.store(1, std::memory_order_release);
+    capacity_ = capacity;
+    writePos_ = 0;
+    readPos_ = 0;
+    return ERR_OK;
+}
+
+int32_t SensorSharedRing::Attach(int32_t memFd)
+{
+    if (memFd < 0) {
+        SEN_HILOGE("Invalid memFd");
+        return SENSOR_CHANNEL_SHARED_MEM_ERR;
+    }
+    Destroy();
+    memFd_ = memFd;
+    // The peer keeps the fd, only a memory it can no longer resize is safe to map
+    int32_t seals = fcntl(memFd_, F_GET_SEALS);
+    if ((seals < 0) || ((seals & SHARED_RING_SEALS) != SHARED_RING_SEALS)) {
+        SEN_HILOGE("Shared memory is not sealed, seals:%{public}d, errno:%{public}d", seals, errno);
+        Destroy();
+        return SENSOR_CHANNEL_SHARED_MEM_ERR;
+    }
+    struct stat memStat = {};
+    if ((fstat(memFd_, &memStat) != 0) || (memStat.st_size < static_cast<off_t>(HEADER_SIZE + sizeof(SensorData))) ||
+        (memStat.st_size > static_cast<off_t>(HEADER_SIZE + sizeof(SensorData) * MAX_SHARED_RING_CAPACITY)) ||
+        (Map(static_cast<size_t>(memStat.st_size)) != ERR_OK)) {
+        SEN_HILOGE("Map shared memory failed, errno:%{public}d", errno);
+        Destroy();
+        return SENSOR_CHANNEL_SHARED_MEM_ERR;
+    }
+    uint32_t capacity = header_->capacity;
+    if ((header_->magic != SHARED_RING_MAGIC) || (header_->version != SHARED_RING_VERSION) ||
+        (header_->recordSize != sizeof(SensorData)) || !IsValidCapacity(capacity) ||
+        (size_ != HEADER_SIZE + sizeof(SensorData) * capacity)) {
+        SEN_HILOGE("Invalid shared ring header");
+        Destroy();
+        return SENSOR_CHANNEL_SHARED_MEM_ERR;
+    }
+    capacity_ = capacity;
+    writePos_ = header_->writePos.load(std::memory_order_acquire);
+    readPos_ = 0;
+    return ERR_OK;
+}
+
+void SensorSharedRing::Destroy()
+{
+    if (addr_ != nullptr) {
+        munmap(addr_, size_);
+        addr_ = nullptr;
+        size_ = 0;
+        header_ = nullptr;
+        slots_ = nullptr;
+    }
+    CloseMemFd();
+    capacity_ = 0;
+}
+
+int32_t SensorSharedRing::GetMemFd() const
+{
+    return memFd_;
+}
+
+void SensorSharedRing::CloseMemFd()
+{
+    if (memFd_ >= 0) {
+        close(memFd_);
+        memFd_ = -1;
+    }
+}
+
+uint32_t SensorSharedRing::GetCapacity() const
+{
+    return capacity_;
+}
+
+uint64_t SensorSharedRing::GetDropCount() const
+{
+    return (header_ == nullptr) ? 0 : header_->dropCount.load(std::memory_order_relaxed);
+}
+
+size_t SensorSharedRing::Write(const SensorData *events, size_t num, bool &needNotify)
+{
+    needNotify = false;
+    if ((header_ == nullptr) || (events == nullptr) || (num == 0)) {
+        return 0;
+    }
+    uint64_t used = writePos_ - header_->readPos.load(std::memory_order_acquire);
+    size_t freeNum = (used > capacity_) ? 0 : static_cast<size_t>(capacity_ - used);
+    size_t count = std::min(num, freeNum);
+    uint32_t mask = capacity_ - 1;
+    for (size_t i = 0; i < count; ++i) {
+        slots_[(writePos_ + i) & mask] = events[i];
+    }
+    if (count < num) {
+        header_->dropCount.fetch_add(num - count, std::memory_order_relaxed);
+    }
+    if (count == 0) {
+        return 0;
+    }
+    writePos_ += count;
+    header_->writePos.store(writePos_, std::memory_order_release);
+    // Pairs with the fence in PrepareWait, either the consumer sees the new position or we see it waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header_->consumerWaiting.load(std::memory_order_relaxed) != 0) {
+        needNotify = (header_->consumerWaiting.exchange(0, std::memory_order_relaxed) != 0);
+    }
+    return count;
+}
+
+size_t SensorSharedRing::GetReadableData(const SensorData **events)
+{
+    if ((header_ == nullptr) || (events == nullptr)) {
+        return 0;
+    }
+    uint64_t available = header_->writePos.load(std::memory_order_acquire) - readPos_;
+    if (available == 0) {
+        return 0;
+    }
+    available = std::min<uint64_t>(available, capacity_);
+    size_t offset = static_cast<size_t>(readPos_ & (capacity_ - 1));
+    *events = slots_ + offset;
+    return std::min(static_cast<size_t>(available), static_cast<size_t>(capacity_) - offset);
+}
+
+void SensorSharedRing::ConsumeData(size_t num)
+{
+    if (header_ == nullptr) {
+        return;
+    }
+    readPos_ += num;
+    header_->readPos.store(readPos_, std::memory_order_release);
+}
+
+bool SensorSharedRing::PrepareWait()
+{
+    if (header_ == nullptr) {
+        return true;
+    }
+    header_->consumerWaiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header_->writePos.load(std::memory_order_acquire) != readPos_) {
+        header_->consumerWaiting.store(0, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+} // namespace Sensors
+} // namespace OHOS
@@ -17,6 +17,7 @@
 #define CONVERSION_FFT_H
 
 #include "fft.h"
+#include "real_fft.h"
 
 namespace OHOS {
 namespace Sensors {
@@ -76,6 +77,16 @@ public:
      */
     int32_t Process(const std::vector<double> &values, int32_t &frameCount, std::vector<float> &frameMagsArr);
 
+    /**
+     * @brief Same as Process, but all frames of values are transformed by RealFft over precomputed FFT tables.
+     *  Frames are read in place instead of being shifted through the buffer sample by sample, and the magnitudes
+     *  are written into frameMagsArr grown once. Phases are only kept for the last frame. Falls back to Process
+     *  when the window is longer than the FFT or RealFft does not take the FFT size.
+     * @param values A set of signal data
+     * @return Returns <b>0</b> if the operation is successful; returns a negative value otherwise.
+     */
+    int32_t ProcessFrames(const std::vector<double> &values, int32_t &frameCount, std::vector<float> &frameMagsArr);
+
     /**
      * @brief Process the sampled data one by one
      * @param value A sampling value.
@@ -196,6 +207,7 @@ private:
     FFTOutputResult fftResult_;
     int32_t pos_ { 0 };
     Fft fft_;
+    RealFft realFft_;
     bool isFrameFull_ { false };
     int32_t bins_ { 0 };
     bool isFftCalcFinish_ { false };
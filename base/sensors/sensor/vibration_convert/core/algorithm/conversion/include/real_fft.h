@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REAL_FFT_H
+#define REAL_FFT_H
+
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace Sensors {
+/**
+ * @brief FFT of real frames with all tables built once in Init.
+ *
+ * A frame of fftSize real samples is packed into fftSize / 2 complex values, transformed by an iterative radix-2
+ * FFT whose butterflies run four at a time with NEON or SSE when available, and split into the real spectrum.
+ * Bit reversal and twiddle factors are looked up instead of being computed per frame.
+ */
+class RealFft {
+public:
+    RealFft() = default;
+    ~RealFft() = default;
+
+    /**
+     * @brief Builds the tables for one FFT size.
+     * @param fftSize the FFT size. This must be a power of 2, at least 4.
+     * @return Returns <b>0</b> if the operation is successful; returns a negative value otherwise.
+     */
+    int32_t Init(int32_t fftSize);
+
+    int32_t GetFftSize() const
+    {
+        return fftSize_;
+    }
+
+    /**
+     * @brief Transforms data * window and outputs the magnitudes the way Fft::CalculatePowerSpectrum does.
+     * @param data fftSize samples.
+     * @param window fftSize window coefficients.
+     * @param magnitudes Receives fftSize / 2 magnitudes.
+     */
+    void CalcMagnitudes(const float *data, const float *window, float *magnitudes);
+
+    /**
+     * @brief Outputs the fftSize / 2 phases of the last transform.
+     */
+    void CalcPhases(float *phases) const;
+
+private:
+    void Transform();
+
+private:
+    int32_t fftSize_ { 0 };
+    int32_t half_ { 0 };
+    std::vector<uint32_t> bitReverse_;
+    /** Twiddles of the stage with h butterflies per group start at h - 1 */
+    std::vector<float> twiddleReal_;
+    std::vector<float> twiddleImag_;
+    /** exp(-2 * PI * i * k / fftSize), used to split the packed spectrum */
+    std::vector<float> splitReal_;
+    std::vector<float> splitImag_;
+    std::vector<float> real_;
+    std::vector<float> imag_;
+    std::vector<float> spectrumReal_;
+    std::vector<float> spectrumImag_;
+};
+} // namespace Sensors
+} // namespace OHOS
+#endif // REAL_FFT_H
@@ -15,6 +15,8 @@
 
 #include "conversion_fft.h"
 
+#include <algorithm>
+
 #include "sensor_log.h"
 #include "sensors_errors.h"
 #include "utils.h"
@@ -40,6 +42,10 @@ int32_t ConversionFFT::Init(const FFTInputPara &fftPara)
     }
     para_ = fftPara;
     fft_.Init(para_.fftSize);
+    if (realFft_.Init(para_.fftSize) != Sensors::SUCCESS) {
+        // Sizes RealFft does not take, such as below 4, are still valid for Process
+        SEN_HILOGW("RealFft init failed, ProcessFrames falls back to Process, fftSize:%{public}d", para_.fftSize);
+    }
     para_.windowSize = (fftPara.windowSize > para_.fftSize) ? fftPara.windowSize : para_.fftSize;
     pos_ = para_.windowSize - para_.hopSize;
     if (pos_ < 0) {
@@ -125,6 +131,42 @@ int32_t ConversionFFT::Process(const std::vector<double> &values, int32_t &frame
     return Sensors::SUCCESS;
 }
 
+int32_t ConversionFFT::ProcessFrames(const std::vector<double> &values, int32_t &frameCount,
+    std::vector<float> &frameMagsArr)
+{
+    int32_t overlap = para_.windowSize - para_.hopSize;
+    if ((para_.windowSize != para_.fftSize) || (overlap < 0) || (realFft_.GetFftSize() != para_.fftSize)) {
+        // Frames that do not fill the FFT exactly, or sizes RealFft does not take, are handled sample by sample
+        return Process(values, frameCount, frameMagsArr);
+    }
+    frameCount = 0;
+    // The frames see the overlap kept by the previous call followed by values
+    size_t signalSize = static_cast<size_t>(overlap) + values.size();
+    std::vector<float> signal(signalSize);
+    std::copy(fftResult_.buffer.begin(), fftResult_.buffer.begin() + overlap, signal.begin());
+    std::transform(values.begin(), values.end(), signal.begin() + overlap,
+        [](double value) { return static_cast<float>(value); });
+    size_t hopSize = static_cast<size_t>(para_.hopSize);
+    size_t frameNum = values.size() / hopSize;
+    size_t magsBegin = frameMagsArr.size();
+    frameMagsArr.resize(magsBegin + frameNum * bins_);
+    for (size_t i = 0; i < frameNum; ++i) {
+        realFft_.CalcMagnitudes(signal.data() + i * hopSize, fftResult_.window.data(),
+            frameMagsArr.data() + magsBegin + i * bins_);
+    }
+    if (frameNum != 0) {
+        auto lastMags = frameMagsArr.begin() + magsBegin + (frameNum - 1) * bins_;
+        std::copy(lastMags, lastMags + bins_, fftResult_.magnitudes.begin());
+        realFft_.CalcPhases(fftResult_.phases.data());
+        isFftCalcFinish_ = true;
+    }
+    // Leave the buffer as Process does: the overlap of the next frame followed by the samples after it
+    std::copy(signal.begin() + frameNum * hopSize, signal.end(), fftResult_.buffer.begin());
+    pos_ = static_cast<int32_t>(signalSize - frameNum * hopSize);
+    frameCount = static_cast<int32_t>(frameNum);
+    return Sensors::SUCCESS;
+}
+
 std::vector<float> &ConversionFFT::ConvertDB()
 {
     if (isFftCalcFinish_) {
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "real_fft.h"
+
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define REAL_FFT_USE_NEON
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define REAL_FFT_USE_SSE
+#endif
+
+#include "sensor_log.h"
+#include "sensors_errors.h"
+#include "utils.h"
+
+#undef LOG_TAG
+#define LOG_TAG "RealFft"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr int32_t MIN_FFT_SIZE { 4 };
+constexpr int32_t MAX_FFT_SIZE { 65536 };
+constexpr int32_t SIMD_WIDTH { 4 };
+constexpr double PI_VALUE { 3.14159265358979323846 };
+// Same scaling as Fft::CalculatePowerSpectrum
+constexpr float MAGNITUDE_SCALE { 2.0F };
+
+// Butterflies a[k] +- w[k] * b[k] for k < count
+void Butterflies(float *aReal, float *aImag, float *bReal, float *bImag, const float *wReal, const float *wImag,
+    int32_t count)
+{
+    int32_t k = 0;
+#if defined(REAL_FFT_USE_NEON)
+    for (; (k + SIMD_WIDTH) <= count; k += SIMD_WIDTH) {
+        float32x4_t wr = vld1q_f32(wReal + k);
+        float32x4_t wi = vld1q_f32(wImag + k);
+        float32x4_t br = vld1q_f32(bReal + k);
+        float32x4_t bi = vld1q_f32(bImag + k);
+        float32x4_t tr = vmlsq_f32(vmulq_f32(br, wr), bi, wi);
+        float32x4_t ti = vmlaq_f32(vmulq_f32(br, wi), bi, wr);
+        float32x4_t ar = vld1q_f32(aReal + k);
+        float32x4_t ai = vld1q_f32(aImag + k);
+        vst1q_f32(bReal + k, vsubq_f32(ar, tr));
+        vst1q_f32(bImag + k, vsubq_f32(ai, ti));
+        vst1q_f32(aReal + k, vaddq_f32(ar, tr));
+        vst1q_f32(aImag + k, vaddq_f32(ai, ti));
+    }
+#elif defined(REAL_FFT_USE_SSE)
+    for (; (k + SIMD_WIDTH) <= count; k += SIMD_WIDTH) {
+        __m128 wr = _mm_loadu_ps(wReal + k);
+        __m128 wi = _mm_loadu_ps(wImag + k);
+        __m128 br = _mm_loadu_ps(bReal + k);
+        __m128 bi = _mm_loadu_ps(bImag + k);
+        __m128 tr = _mm_sub_ps(_mm_mul_ps(br, wr), _mm_mul_ps(bi, wi));
+        __m128 ti = _mm_add_ps(_mm_mul_ps(br, wi), _mm_mul_ps(bi, wr));
+        __m128 ar = _mm_loadu_ps(aReal + k);
+        __m128 ai = _mm_loadu_ps(aImag + k);
+        _mm_storeu_ps(bReal + k, _mm_sub_ps(ar, tr));
+        _mm_storeu_ps(bImag + k, _mm_sub_ps(ai, ti));
+        _mm_storeu_ps(aReal + k, _mm_add_ps(ar, tr));
+        _mm_storeu_ps(aImag + k, _mm_add_ps(ai, ti));
+    }
+#endif
+    for (; k < count; ++k) {
+        float tr = bReal[k] * wReal[k] - bImag[k] * wImag[k];
+        float ti = bReal[k] * wImag[k] + bImag[k] * wReal[k];
+        bReal[k] = aReal[k] - tr;
+        bImag[k] = aImag[k] - ti;
+        aReal[k] += tr;
+        aImag[k] += ti;
+    }
+}
+}  // namespace
+
+int32_t RealFft::Init(int32_t fftSize)
+{
+    if ((fftSize < MIN_FFT_SIZE) || (fftSize > MAX_FFT_SIZE) || !IsPowerOfTwo(static_cast<uint32_t>(fftSize))) {
+        SEN_HILOGE("Invalid fftSize:%{public}d", fftSize);
+        return Sensors::PARAMETER_ERROR;
+    }
+    fftSize_ = fftSize;
+    half_ = fftSize / 2;
+    uint32_t numBits = ObtainNumberOfBits(static_cast<uint32_t>(half_));
+    bitReverse_.resize(half_);
+    for (int32_t i = 0; i < half_; ++i) {
+        bitReverse_[i] = ReverseBits(static_cast<uint32_t>(i), numBits);
+    }
+    twiddleReal_.assign(half_, 0.0F);
+    twiddleImag_.assign(half_, 0.0F);
+    for (int32_t h = 1; h < half_; h *= 2) {
+        for (int32_t k = 0; k < h; ++k) {
+            double angle = -PI_VALUE * k / h;
+            twiddleReal_[h - 1 + k] = static_cast<float>(cos(angle));
+            twiddleImag_[h - 1 + k] = static_cast<float>(sin(angle));
+        }
+    }
+    splitReal_.resize(half_);
+    splitImag_.resize(half_);
+    for (int32_t k = 0; k < half_; ++k) {
+        double angle = -2.0 * PI_VALUE * k / fftSize_;
+        splitReal_[k] = static_cast<float>(cos(angle));
+        splitImag_[k] = static_cast<float>(sin(angle));
+    }
+    real_.assign(half_, 0.0F);
+    imag_.assign(half_, 0.0F);
+    spectrumReal_.assign(half_, 0.0F);
+    spectrumImag_.assign(half_, 0.0F);
+    return Sensors::SUCCESS;
+}
+
+void RealFft::Transform()
+{
+    float *real = real_.data();
+    float *imag = imag_.data();
+    for (int32_t h = 1; h < half_; h *= 2) {
+        const float *wReal = twiddleReal_.data() + h - 1;
+        const float *wImag = twiddleImag_.data() + h - 1;
+        for (int32_t group = 0; group < half_; group += 2 * h) {
+            Butterflies(real + group, imag + group, real + group + h, imag + group + h, wReal, wImag, h);
+        }
+    }
+}
+
+void RealFft::CalcMagnitudes(const float *data, const float *window, float *magnitudes)
+{
+    CHKPV(data);
+    CHKPV(window);
+    CHKPV(magnitudes);
+    // Even samples go to the real part and odd samples to the imaginary part, already in bit reversed order
+    for (int32_t n = 0; n < half_; ++n) {
+        uint32_t pos = bitReverse_[n];
+        real_[pos] = data[2 * n] * window[2 * n];
+        imag_[pos] = data[2 * n + 1] * window[2 * n + 1];
+    }
+    Transform();
+    for (int32_t k = 0; k < half_; ++k) {
+        int32_t mirror = (k == 0) ? 0 : (half_ - k);
+        float evenReal = (real_[k] + real_[mirror]) * 0.5F;
+        float evenImag = (imag_[k] - imag_[mirror]) * 0.5F;
+        float oddReal = (imag_[k] + imag_[mirror]) * 0.5F;
+        float oddImag = (real_[mirror] - real_[k]) * 0.5F;
+        spectrumReal_[k] = evenReal + splitReal_[k] * oddReal - splitImag_[k] * oddImag;
+        spectrumImag_[k] = evenImag + splitReal_[k] * oddImag + splitImag_[k] * oddReal;
+    }
+    for (int32_t k = 0; k < half_; ++k) {
+        magnitudes[k] = MAGNITUDE_SCALE *
+            std::sqrt(spectrumReal_[k] * spectrumReal_[k] + spectrumImag_[k] * spectrumImag_[k]);
+    }
+}
+
+void RealFft::CalcPhases(float *phases) const
+{
+    CHKPV(phases);
+    for (int32_t k = 0; k < half_; ++k) {
+        phases[k] = std::atan2(spectrumImag_[k], spectrumReal_[k]);
+    }
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATION_CONVERT_STREAM_H
+#define VIBRATION_CONVERT_STREAM_H
+
+#include <cstdint>
+#include <vector>
+
+#include "vibration_convert_type.h"
+
+namespace OHOS {
+namespace Sensors {
+/**
+ * @brief Converts audio pushed block by block instead of as one whole clip.
+ *
+ * The audio is cut into segments in the middle of long silences. A segment reaching the maximum length is cut in
+ * its longest silence after the minimum length, or at the maximum length if it has none. Every segment is converted
+ * the same way as a whole clip by VibrationConvertCore. Only the pending segment and the events are kept, so memory
+ * does not grow with the audio of the clip, and the events of a segment are emitted as soon as it is cut.
+ * A clip shorter than one segment gives the same events as the batch conversion. A longer clip gives the batch
+ * events of each segment, shifted by the segment start. The intensities and the detection thresholds are then
+ * relative to the segment instead of the whole clip, so a quiet segment is not scaled down by a louder one.
+ */
+class VibrationConvertStream {
+public:
+    explicit VibrationConvertStream(const AudioSetting &audioSetting);
+    ~VibrationConvertStream() = default;
+    /**
+     * @brief Appends one block of decoded audio.
+     * @param audioBlock Samples following the ones of the previous block, at the rate of the batch input.
+     * @param hapticEvents Events of the segments completed by this block are appended to it, clip relative.
+     * @return Returns <b>0</b> if the operation is successful; returns an error code otherwise.
+     */
+    int32_t PushAudioBlock(const std::vector<double> &audioBlock, std::vector<HapticEvent> &hapticEvents);
+    /**
+     * @brief Converts the pending audio at the end of the clip and writes the vibration json file of the whole clip.
+     * The stream can then take a new clip.
+     * @param hapticEvents Events of the last segment are appended to it.
+     * @return Returns <b>0</b> if the operation is successful; returns an error code otherwise.
+     */
+    int32_t Finish(std::vector<HapticEvent> &hapticEvents);
+
+private:
+    int32_t ConvertSegment(size_t segmentLen, std::vector<HapticEvent> &hapticEvents);
+    void Reset();
+    AudioSetting audioSetting_;
+    std::vector<double> segment_;
+    // Index in the clip of the first sample of segment_
+    size_t segmentBegin_ { 0 };
+    // Silent samples at the end of segment_
+    size_t silenceCount_ { 0 };
+    // Longest silence of segment_ ending after the minimum segment length, and its end in segment_
+    size_t longestSilenceLen_ { 0 };
+    size_t longestSilenceEnd_ { 0 };
+    bool hasSound_ { false };
+    // Events of the clip so far, clip relative, for the json file
+    std::vector<HapticEvent> clipEvents_;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif // VIBRATION_CONVERT_STREAM_H
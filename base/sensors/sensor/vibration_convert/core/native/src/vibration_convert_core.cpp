@@ -112,6 +112,18 @@ int32_t VibrationConvertCore::GetAudioData()
 
 int32_t VibrationConvertCore::ConvertAudioToHaptic(const AudioSetting &audioSetting,
     const std::vector<double> &audioData, std::vector<HapticEvent> &hapticEvents)
+{
+    if (ConvertAudioToHapticEvents(audioSetting, audioData, hapticEvents) != Sensors::SUCCESS) {
+        SEN_HILOGE("ConvertAudioToHapticEvents failed");
+        return Sensors::ERROR;
+    }
+    GenerateVibrationJsonFile jsonFile;
+    jsonFile.GenerateJsonFile(hapticEvents_);
+    return Sensors::SUCCESS;
+}
+
+int32_t VibrationConvertCore::ConvertAudioToHapticEvents(const AudioSetting &audioSetting,
+    const std::vector<double> &audioData, std::vector<HapticEvent> &hapticEvents)
 {
     if (audioData.empty()) {
         SEN_HILOGE("audioData is empty");
@@ -128,8 +140,6 @@ int32_t VibrationConvertCore::ConvertAudioToHaptic(const AudioSetting &audioSett
     }
     StoreHapticEvent();
     hapticEvents = hapticEvents_;
-    GenerateVibrationJsonFile jsonFile;
-    jsonFile.GenerateJsonFile(hapticEvents_);
     return Sensors::SUCCESS;
 }
 
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vibration_convert_stream.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "generate_vibration_json_file.h"
+#include "sensor_log.h"
+#include "sensors_errors.h"
+#include "utils.h"
+#include "vibration_convert_core.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibrationConvertStream"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+// Same silence threshold as the preprocessing of VibrationConvertCore
+constexpr double AMP_INVALIDE_DELTA { 0.001 };
+// VibrationConvertCore keeps the first two of every four input samples, segments begin on such a group
+constexpr size_t RESAMPLE_MULTIPLE { 4 };
+constexpr size_t RESAMPLE_KEEP_COUNT { 2 };
+// Longer than two transient event windows after resampling, so no event spans a cut
+constexpr size_t SEGMENT_SILENCE_LEN { 16384 };
+// About 3 s and 4.5 s at 44.1 kHz, the maximum bounds the pending audio when the clip has no long silence
+constexpr size_t SEGMENT_MIN_LEN { 131072 };
+constexpr size_t SEGMENT_MAX_LEN { 196608 };
+}  // namespace
+
+VibrationConvertStream::VibrationConvertStream(const AudioSetting &audioSetting) : audioSetting_(audioSetting) {}
+
+int32_t VibrationConvertStream::PushAudioBlock(const std::vector<double> &audioBlock,
+    std::vector<HapticEvent> &hapticEvents)
+{
+    for (double sample : audioBlock) {
+        segment_.push_back(sample);
+        if (std::fabs(sample) < AMP_INVALIDE_DELTA) {
+            ++silenceCount_;
+            if ((segment_.size() > SEGMENT_MIN_LEN) && (silenceCount_ > longestSilenceLen_)) {
+                longestSilenceLen_ = silenceCount_;
+                longestSilenceEnd_ = segment_.size();
+            }
+        } else {
+            silenceCount_ = 0;
+            hasSound_ = true;
+        }
+        size_t segmentLen = 0;
+        if (hasSound_ && (silenceCount_ >= SEGMENT_SILENCE_LEN) && (segment_.size() >= SEGMENT_MIN_LEN)) {
+            // Cut in the middle of the silence, so both segments keep a silent margin
+            segmentLen = segment_.size() - silenceCount_ / 2;
+        } else if (segment_.size() >= SEGMENT_MAX_LEN) {
+            // Cut in the longest silence after the minimum length, if any, so an event is less likely to be split
+            segmentLen = (longestSilenceLen_ == 0) ? segment_.size() : (longestSilenceEnd_ - longestSilenceLen_ / 2);
+        } else {
+            continue;
+        }
+        segmentLen -= segmentLen % RESAMPLE_MULTIPLE;
+        int32_t ret = ConvertSegment(segmentLen, hapticEvents);
+        if (ret != Sensors::SUCCESS) {
+            SEN_HILOGE("ConvertSegment failed, segmentBegin:%{public}zu", segmentBegin_);
+            Reset();
+            return ret;
+        }
+    }
+    return Sensors::SUCCESS;
+}
+
+int32_t VibrationConvertStream::Finish(std::vector<HapticEvent> &hapticEvents)
+{
+    CALL_LOG_ENTER;
+    if (segmentBegin_ == 0 && segment_.empty()) {
+        SEN_HILOGE("No audio was pushed");
+        return Sensors::ERROR;
+    }
+    int32_t ret = ConvertSegment(segment_.size(), hapticEvents);
+    if (ret != Sensors::SUCCESS) {
+        SEN_HILOGE("ConvertSegment failed, segmentBegin:%{public}zu", segmentBegin_);
+        Reset();
+        return ret;
+    }
+    // Same file as the batch conversion of the whole clip, written once instead of for every segment
+    GenerateVibrationJsonFile jsonFile;
+    jsonFile.GenerateJsonFile(clipEvents_);
+    Reset();
+    return Sensors::SUCCESS;
+}
+
+int32_t VibrationConvertStream::ConvertSegment(size_t segmentLen, std::vector<HapticEvent> &hapticEvents)
+{
+    // Only the short tail after the cut is copied, the segment itself is handed over as it is
+    std::vector<double> tail(segment_.begin() + segmentLen, segment_.end());
+    segment_.resize(segmentLen);
+    int32_t ret = Sensors::SUCCESS;
+    if (hasSound_ && (segmentLen != 0)) {
+        VibrationConvertCore convertCore;
+        std::vector<HapticEvent> segmentEvents;
+        ret = convertCore.ConvertAudioToHapticEvents(audioSetting_, segment_, segmentEvents);
+        double beginTime = static_cast<double>(segmentBegin_ / RESAMPLE_MULTIPLE * RESAMPLE_KEEP_COUNT) / SAMPLE_RATE;
+        int32_t beginTimeMs = static_cast<int32_t>(round(beginTime * SAMPLE_IN_MS));
+        for (auto &event : segmentEvents) {
+            event.startTime += beginTimeMs;
+            hapticEvents.push_back(event);
+            clipEvents_.push_back(event);
+        }
+    }
+    segmentBegin_ += segmentLen;
+    segment_.swap(tail);
+    silenceCount_ = std::min(silenceCount_, segment_.size());
+    hasSound_ = (silenceCount_ < segment_.size());
+    longestSilenceLen_ = 0;
+    longestSilenceEnd_ = 0;
+    return ret;
+}
+
+void VibrationConvertStream::Reset()
+{
+    std::vector<double>().swap(segment_);
+    segmentBegin_ = 0;
+    silenceCount_ = 0;
+    longestSilenceLen_ = 0;
+    longestSilenceEnd_ = 0;
+    hasSound_ = false;
+    std::vector<HapticEvent>().swap(clipEvents_);
+}
+}  // namespace Sensors
+}  // namespace OHOS
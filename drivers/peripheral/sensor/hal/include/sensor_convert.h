@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HDI_SENSOR_CONVERT_H
+#define HDI_SENSOR_CONVERT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Least common multiple of every SensorDataDimension, so a pattern row lines up with whole samples */
+#define SENSOR_CONVERT_PATTERN_LEN 24
+
+void SensorFillConvertPattern(const float *coff, uint32_t dim, float *pattern);
+void SensorConvertBatch(const int32_t *data, float *value, uint32_t num, const float *pattern);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HDI_SENSOR_CONVERT_H */
@@ -46,6 +46,7 @@ struct SensorDevManager {
     int32_t sensorSum;
     struct OsalMutex mutex;
     struct OsalMutex eventMutex;
+    struct OsalMutex dataMutex;
 };
 
 struct SensorDevManager *GetSensorDevManager(void);
@@ -19,6 +19,7 @@
 #include "osal_mutex.h"
 #include "osal_time.h"
 #include "sensor_common.h"
+#include "sensor_convert.h"
 #include "sensor_manager.h"
 #include "sensor_type.h"
 
@@ -54,9 +55,52 @@ static struct SensorCovertCoff g_sensorCovertCoff[] = {
     { SENSOR_TYPE_HUMIDITY, SENSOR_TYPE_MAX, DATA_X, { HUMIDITY_ACCURACY } },
 };
 
+#define SENSOR_CONVERT_COFF_NUM (sizeof(g_sensorCovertCoff) / sizeof(g_sensorCovertCoff[0]))
+#define SENSOR_CONVERT_INDEX_NONE (-1)
+
+static float g_sensorConvertPattern[SENSOR_CONVERT_COFF_NUM][SENSOR_CONVERT_PATTERN_LEN];
+static int16_t g_sensorConvertIndex[SENSOR_TYPE_MAX];
+static bool g_sensorConvertInited = false;
+
 static struct SensorDumpDate g_dumpDate = { 0 };
 static struct SensorDatePack g_listDump = { 0 };
 
+static void BuildSensorConvertTable(void)
+{
+    for (uint32_t i = 0; i < SENSOR_TYPE_MAX; ++i) {
+        g_sensorConvertIndex[i] = SENSOR_CONVERT_INDEX_NONE;
+    }
+    for (uint32_t i = 0; i < SENSOR_CONVERT_COFF_NUM; ++i) {
+        SensorFillConvertPattern(g_sensorCovertCoff[i].coff, g_sensorCovertCoff[i].dim, g_sensorConvertPattern[i]);
+        int32_t sensorId = g_sensorCovertCoff[i].sensorId;
+        if (g_sensorCovertCoff[i].dim == 0 || sensorId < 0 || sensorId >= SENSOR_TYPE_MAX) {
+            continue;
+        }
+        if (g_sensorConvertIndex[sensorId] == SENSOR_CONVERT_INDEX_NONE) {
+            g_sensorConvertIndex[sensorId] = (int16_t)i;
+        }
+    }
+    g_sensorConvertInited = true;
+}
+
+/* Called with dataMutex held, the table is built once and rebuilt only by SetSensorIdBySensorType */
+static int32_t FindSensorConvertIndex(int32_t sensorId)
+{
+    if (!g_sensorConvertInited) {
+        BuildSensorConvertTable();
+    }
+    if (sensorId >= 0 && sensorId < SENSOR_TYPE_MAX) {
+        return g_sensorConvertIndex[sensorId];
+    }
+    /* Ids outside the type range are not indexed, keep resolving them by search */
+    for (uint32_t i = 0; i < SENSOR_CONVERT_COFF_NUM; ++i) {
+        if (g_sensorCovertCoff[i].sensorId == sensorId && g_sensorCovertCoff[i].dim != 0) {
+            return (int32_t)i;
+        }
+    }
+    return SENSOR_CONVERT_INDEX_NONE;
+}
+
 struct SensorDatePack *GetEventData(void)
 {
     return &g_listDump;
@@ -65,13 +109,38 @@ struct SensorDatePack *GetEventData(void)
 void SetSensorIdBySensorType(enum SensorTypeTag type, int32_t sensorId)
 {
     uint32_t count = sizeof(g_sensorCovertCoff) / sizeof(g_sensorCovertCoff[0]);
+    struct SensorDevManager *manager = GetSensorDevManager();
 
+    (void)OsalMutexLock(&manager->dataMutex);
     for (uint32_t i = 0; i < count; ++i) {
         if (g_sensorCovertCoff[i].sensorTypeId == (int32_t)type) {
             g_sensorCovertCoff[i].sensorId = sensorId;
             break;
         }
     }
+    BuildSensorConvertTable();
+    (void)OsalMutexUnlock(&manager->dataMutex);
+}
+
+static bool ParseSensorBatch(const struct SensorEvents *event, struct SensorBatchHeader *header,
+    uint32_t *samplesOffset)
+{
+    if (event->dataLen < sizeof(*header) ||
+        memcpy_s(header, sizeof(*header), event->data, sizeof(*header)) != EOK) {
+        return false;
+    }
+    if (header->sampleNum == 0 || header->sampleNum > SENSOR_BATCH_MAX_SAMPLE_NUM ||
+        header->sampleSize == 0 || header->sampleSize > SENSOR_BATCH_MAX_SAMPLE_SIZE ||
+        header->sampleSize % sizeof(int32_t) != 0) {
+        return false;
+    }
+    /* Both limits are small, so the products below cannot overflow */
+    uint32_t offset = sizeof(*header) + header->sampleNum * sizeof(uint32_t);
+    if (event->dataLen < offset + header->sampleNum * header->sampleSize) {
+        return false;
+    }
+    *samplesOffset = offset;
+    return true;
 }
 
 void CopyEventData(struct SensorEvents *event)
@@ -81,13 +150,28 @@ void CopyEventData(struct SensorEvents *event)
         return;
     }
 
-    for (uint32_t i = 0; i < event->dataLen; i++) {
-        g_dumpDate.data[i] = event->data[i];
+    const uint8_t *data = event->data;
+    uint32_t dataLen = event->dataLen;
+    int64_t timestamp = event->timestamp;
+    struct SensorBatchHeader header;
+    uint32_t samplesOffset;
+    /* A batch is dumped as its newest sample */
+    if (event->mode == SENSOR_MODE_FIFO_BATCH && ParseSensorBatch(event, &header, &samplesOffset)) {
+        const uint32_t *deltas = (const uint32_t *)(event->data + sizeof(header));
+        for (uint32_t i = 0; i < header.sampleNum; i++) {
+            timestamp += deltas[i];
+        }
+        data = event->data + samplesOffset + (header.sampleNum - 1) * header.sampleSize;
+        dataLen = header.sampleSize;
     }
-    g_dumpDate.dataLen = event->dataLen;
+    dataLen = dataLen < DATA_LENGTH ? dataLen : DATA_LENGTH;
+    for (uint32_t i = 0; i < dataLen; i++) {
+        g_dumpDate.data[i] = data[i];
+    }
+    g_dumpDate.dataLen = dataLen;
     g_dumpDate.sensorId = event->sensorId;
     g_dumpDate.version = event->version;
-    g_dumpDate.timestamp = event->timestamp;
+    g_dumpDate.timestamp = timestamp;
     g_dumpDate.option = event->option;
     g_dumpDate.mode = event->mode;
 
@@ -109,23 +193,34 @@ void CopyEventData(struct SensorEvents *event)
 
 void ConvertSensorData(struct SensorEvents *event)
 {
-    uint32_t dataLen;
-    uint32_t axis;
-    int32_t *data = NULL;
-    float *value = NULL;
-
-    data = (int32_t *)event->data;
-    value = (float *)event->data;
-
-    for (uint32_t i = 0; i < sizeof(g_sensorCovertCoff) / sizeof(g_sensorCovertCoff[0]); ++i) {
-        if ((g_sensorCovertCoff[i].sensorId == event->sensorId) && (g_sensorCovertCoff[i].dim != 0)) {
-            dataLen = event->dataLen / sizeof(int32_t);
-            for (uint32_t j = 0; j < dataLen; ++j) {
-                axis = j % g_sensorCovertCoff[i].dim;
-                value[j] = (float)(data[j] * g_sensorCovertCoff[i].coff[axis]);
-            }
+    float pattern[SENSOR_CONVERT_PATTERN_LEN];
+    struct SensorDevManager *manager = GetSensorDevManager();
+
+    /* Only the pattern is read under the lock, the samples are converted outside it */
+    (void)OsalMutexLock(&manager->dataMutex);
+    int32_t index = FindSensorConvertIndex(event->sensorId);
+    if (index == SENSOR_CONVERT_INDEX_NONE) {
+        (void)OsalMutexUnlock(&manager->dataMutex);
+        return;
+    }
+    (void)memcpy_s(pattern, sizeof(pattern), g_sensorConvertPattern[index], sizeof(g_sensorConvertPattern[index]));
+    (void)OsalMutexUnlock(&manager->dataMutex);
+
+    uint8_t *samples = event->data;
+    uint32_t samplesLen = event->dataLen;
+    if (event->mode == SENSOR_MODE_FIFO_BATCH) {
+        struct SensorBatchHeader header;
+        uint32_t samplesOffset;
+        if (!ParseSensorBatch(event, &header, &samplesOffset)) {
+            HDF_LOGE("%{public}s: sensor %{public}d batch is malformed", __func__, event->sensorId);
+            return;
         }
+        /* The header and the time deltas stay raw, only the samples are converted */
+        samples = event->data + samplesOffset;
+        samplesLen = header.sampleNum * header.sampleSize;
     }
+    /* A fifo payload carries several samples back to back, the pattern repeats per sample */
+    SensorConvertBatch((const int32_t *)samples, (float *)samples, samplesLen / sizeof(int32_t), pattern);
 }
 
 static int OnSensorEventReceived(struct HdfDevEventlistener *listener,
@@ -138,16 +233,13 @@ static int OnSensorEventReceived(struct HdfDevEventlistener *listener,
     (void)service;
     (void)id;
 
-    (void)OsalMutexLock(&manager->eventMutex);
     if (!HdfSbufReadBuffer(data, (const void **)&event, &len) || event == NULL) {
         HDF_LOGE("%{public}s: Read sensor event fail!", __func__);
-        (void)OsalMutexUnlock(&manager->eventMutex);
         return SENSOR_FAILURE;
     }
 
     uint8_t *buf = NULL;
     if (!HdfSbufReadBuffer(data, (const void **)&buf, &len) || buf == NULL) {
-        (void)OsalMutexUnlock(&manager->eventMutex);
         HDF_LOGE("%{public}s: Read sensor data fail!", __func__);
         return SENSOR_FAILURE;
     } else {
@@ -164,14 +256,18 @@ static int OnSensorEventReceived(struct HdfDevEventlistener *listener,
     event->option = SENSOR_STATUS_ACCURACY_HIGH;
 
     ConvertSensorData(event);
-    CopyEventData(event);
 
+    /* Only the callback table is shared with Register/Unregister */
+    (void)OsalMutexLock(&manager->eventMutex);
     if (manager->recordDataCb[groupType] != NULL) {
         manager->recordDataCb[groupType](event);
     }
-
     (void)OsalMutexUnlock(&manager->eventMutex);
 
+    (void)OsalMutexLock(&manager->dataMutex);
+    CopyEventData(event);
+    (void)OsalMutexUnlock(&manager->dataMutex);
+
     return SENSOR_SUCCESS;
 }
 
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sensor_convert.h"
+#include <stddef.h>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SENSOR_CONVERT_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SENSOR_CONVERT_SSE2
+#endif
+
+#define SENSOR_CONVERT_LANES 4
+
+void SensorFillConvertPattern(const float *coff, uint32_t dim, float *pattern)
+{
+    if (coff == NULL || pattern == NULL || dim == 0) {
+        return;
+    }
+    for (uint32_t i = 0; i < SENSOR_CONVERT_PATTERN_LEN; ++i) {
+        pattern[i] = coff[i % dim];
+    }
+}
+
+/*
+ * value may alias data, every lane group is loaded before it is stored.
+ * The result equals the scalar (float)data[i] * coff[i % dim] bit for bit.
+ */
+void SensorConvertBatch(const int32_t *data, float *value, uint32_t num, const float *pattern)
+{
+    uint32_t i = 0;
+    if (data == NULL || value == NULL || pattern == NULL) {
+        return;
+    }
+#if defined(SENSOR_CONVERT_NEON)
+    for (; i + SENSOR_CONVERT_PATTERN_LEN <= num; i += SENSOR_CONVERT_PATTERN_LEN) {
+        for (uint32_t j = 0; j < SENSOR_CONVERT_PATTERN_LEN; j += SENSOR_CONVERT_LANES) {
+            float32x4_t raw = vcvtq_f32_s32(vld1q_s32(data + i + j));
+            vst1q_f32(value + i + j, vmulq_f32(raw, vld1q_f32(pattern + j)));
+        }
+    }
+#elif defined(SENSOR_CONVERT_SSE2)
+    for (; i + SENSOR_CONVERT_PATTERN_LEN <= num; i += SENSOR_CONVERT_PATTERN_LEN) {
+        for (uint32_t j = 0; j < SENSOR_CONVERT_PATTERN_LEN; j += SENSOR_CONVERT_LANES) {
+            __m128 raw = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)(data + i + j)));
+            _mm_storeu_ps(value + i + j, _mm_mul_ps(raw, _mm_loadu_ps(pattern + j)));
+        }
+    }
+#endif
+    /* The vector loops stop on a pattern boundary, so the tail restarts the pattern every period too */
+    for (; i < num; ++i) {
+        value[i] = (float)data[i] * pattern[i % SENSOR_CONVERT_PATTERN_LEN];
+    }
+}
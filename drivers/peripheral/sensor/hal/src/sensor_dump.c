@@ -138,10 +138,15 @@ int32_t SensorShowData(struct HdfSBuf *reply)
 {
     int32_t len;
     int32_t ret = 0;
-    struct SensorDatePack *eventDumpList;
+    struct SensorDatePack dumpList;
+    struct SensorDatePack *eventDumpList = &dumpList;
     char sensorInfoDate[STRING_LEN] = { 0 };
+    struct SensorDevManager *manager = GetSensorDevManager();
 
-    eventDumpList = GetEventData();
+    /* Copy the records out, the event thread keeps writing them */
+    (void)OsalMutexLock(&manager->dataMutex);
+    dumpList = *GetEventData();
+    (void)OsalMutexUnlock(&manager->dataMutex);
 
     ret = sprintf_s(sensorInfoDate, STRING_LEN, "======The last 10 data records======\n\r");
     if (ret < DUMP_SUCCESS) {
@@ -134,6 +134,7 @@ static int32_t InitSensorManager(void)
     DListHeadInit(&manager->sensorIdListHead);
     OsalMutexInit(&manager->mutex);
     OsalMutexInit(&manager->eventMutex);
+    OsalMutexInit(&manager->dataMutex);
 
     int32_t ret = GetSensorServiceList();
     if (ret != SENSOR_SUCCESS) {
@@ -141,6 +142,7 @@ static int32_t InitSensorManager(void)
         ReleaseSensorServiceList();
         OsalMutexDestroy(&manager->mutex);
         OsalMutexDestroy(&manager->eventMutex);
+        OsalMutexDestroy(&manager->dataMutex);
         return SENSOR_INVALID_SERVICE;
     }
 
@@ -184,6 +186,7 @@ int32_t FreeSensorInterfaceInstance(void)
 
     OsalMutexDestroy(&manager->mutex);
     OsalMutexDestroy(&manager->eventMutex);
+    OsalMutexDestroy(&manager->dataMutex);
 
     manager->initState = false;
 
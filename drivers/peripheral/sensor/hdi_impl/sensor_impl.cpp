@@ -44,22 +44,17 @@ int32_t ReportSensorEventsData(int32_t sensorType, const struct SensorEvents *ev
         return SENSOR_SUCCESS;
     }
 
-    HdfSensorEventsVdi hdfSensorEvents;
+    // A SENSOR_MODE_FIFO_BATCH event is forwarded whole, the payload vector keeps its capacity between bursts
+    static thread_local HdfSensorEventsVdi hdfSensorEvents;
     hdfSensorEvents.sensorId = event->sensorId;
     hdfSensorEvents.version = event->version;
     hdfSensorEvents.timestamp = event->timestamp;
     hdfSensorEvents.option = event->option;
     hdfSensorEvents.mode = event->mode;
     hdfSensorEvents.dataLen = event->dataLen;
-    uint32_t len = event->dataLen;
-    uint8_t *tmp = event->data;
+    hdfSensorEvents.data.assign(event->data, event->data + event->dataLen);
 
-    while ((len--) != 0) {
-        hdfSensorEvents.data.push_back(*tmp);
-        tmp++;
-    }
-
-    for (auto callBack : g_groupIdCallBackMap[sensorType]) {
+    for (const auto &callBack : groupCallBackIter->second) {
         callBack->OnDataEventVdi(hdfSensorEvents);
     }
 
@@ -14,9 +14,7 @@
  */
 
 #include "sensor_callback_vdi.h"
-#include "osal_mem.h"
 #include <securec.h>
-#include <unordered_map>
 
 #define HDF_LOG_TAG uhdf_sensor_callback_vdi
 
@@ -27,20 +25,19 @@ namespace V2_0 {
 namespace {
     constexpr int32_t DATA_LEN = 256;
     constexpr int64_t REPOPRT_TIME = 60000000000;
-    static std::unordered_map<int32_t, int64_t> firstTimestampMap_;
-    static std::unordered_map<int32_t, int64_t> lastTimestampMap_;
 }
 
 int32_t SensorCallbackVdi::OnDataEventVdi(const OHOS::HDI::Sensor::V1_1::HdfSensorEventsVdi& eventVdi)
 {
-    SENSOR_TRACE;
-    struct HdfSensorEvents event;
+    SENSOR_TRACE_EVENT;
+    // Reused by every event on the report thread so the payload vector keeps its capacity
+    static thread_local struct HdfSensorEvents event;
     event.sensorId = eventVdi.sensorId;
     event.version = eventVdi.version;
     event.timestamp = eventVdi.timestamp;
     event.option = eventVdi.option;
     event.mode = eventVdi.mode;
-    event.data = eventVdi.data;
+    event.data.assign(eventVdi.data.begin(), eventVdi.data.end());
     event.dataLen = eventVdi.dataLen;
     int32_t ret = OnDataEvent(event);
     return ret;
@@ -48,68 +45,63 @@ int32_t SensorCallbackVdi::OnDataEventVdi(const OHOS::HDI::Sensor::V1_1::HdfSens
 
 int32_t SensorCallbackVdi::OnDataEvent(const V2_0::HdfSensorEvents& event)
 {
-    SENSOR_TRACE;
+    SENSOR_TRACE_EVENT;
     SensorClientsManager::GetInstance()->CopyEventData(event);
-    const std::string reportResult = SensorClientsManager::GetInstance()->ReportEachClient(event);
-    HDF_LOGD("%{public}s sensorId=%{public}d, %{public}s", __func__, event.sensorId, reportResult.c_str());
-    PrintData(event, reportResult);
+    int32_t reportNum = SensorClientsManager::GetInstance()->ReportEachClient(event);
+    HDF_LOGD("%{public}s sensorId=%{public}d, reportNum=%{public}d", __func__, event.sensorId, reportNum);
+    PrintData(event, reportNum);
     return HDF_SUCCESS;
 }
 
-void SensorCallbackVdi::PrintData(const HdfSensorEvents &event, const std::string &reportResult)
+void SensorCallbackVdi::PrintData(const HdfSensorEvents &event, int32_t reportNum)
 {
-    SENSOR_TRACE;
-    std::unique_lock<std::mutex> lock(timestampMapMutex_);
-    bool result = false;
-    if (firstTimestampMap_[event.sensorId] == 0) {
-        firstTimestampMap_[event.sensorId] = event.timestamp;
-        result = true;
-    } else {
-        lastTimestampMap_[event.sensorId] = event.timestamp;
+    if (event.sensorId < 0 || event.sensorId >= HDF_SENSOR_TYPE_MAX) {
+        return;
     }
-
-    if (lastTimestampMap_[event.sensorId] - firstTimestampMap_[event.sensorId] >= REPOPRT_TIME) {
-        firstTimestampMap_[event.sensorId] = lastTimestampMap_[event.sensorId];
-        result = true;
+    std::atomic<int64_t> &firstTimestamp = firstTimestamp_[event.sensorId];
+    int64_t first = firstTimestamp.load(std::memory_order_relaxed);
+    if (first != 0 && event.timestamp - first < REPOPRT_TIME) {
+        return;
     }
-
-    if (result) {
-        std::string st = {0};
-        DataToStr(st, event);
-        st += reportResult;
-        HDF_LOGI("%{public}s: %{public}s", __func__, st.c_str());
+    // Only the thread that moves the window forward prints
+    if (!firstTimestamp.compare_exchange_strong(first, event.timestamp, std::memory_order_relaxed)) {
+        return;
     }
+    SENSOR_TRACE;
+    std::string st = {0};
+    DataToStr(st, event);
+    st += ", reportNum: " + std::to_string(reportNum) + ", " +
+        SensorClientsManager::GetInstance()->GetServiceIdsStr(event.sensorId);
+    HDF_LOGI("%{public}s: %{public}s", __func__, st.c_str());
 }
 
 void SensorCallbackVdi::DataToStr(std::string &str, const HdfSensorEvents &event)
 {
-    void *origin = OsalMemCalloc(sizeof(uint8_t) * (event.dataLen));
-    if (origin == nullptr) {
-        HDF_LOGE("%{public}s: OsalMemCalloc failed", __func__);
+    // A batch is printed as its newest sample, anything else as at most one record of data
+    HdfSensorEventRecord record = {};
+    if (!PackSensorBatchLastSample(event, record)) {
+        PackSensorEventRecord(event, record);
+    }
+    float data[HDF_SENSOR_EVENT_RECORD_DATA_SIZE / sizeof(float)] = {0};
+    if (memcpy_s(data, sizeof(data), record.data, sizeof(record.data)) != EOK) {
+        HDF_LOGE("%{public}s: memcpy_s failed", __func__);
         return;
     }
-
-    uint8_t *eventData = static_cast<uint8_t*>(origin);
-    std::copy(event.data.begin(), event.data.end(), eventData);
-    float *data = reinterpret_cast<float*>(eventData);
-    int32_t dataLen = event.dataLen;
-    int32_t dataDimension = static_cast<int32_t>(dataLen / sizeof(float));
+    int32_t dataDimension = static_cast<int32_t>(record.dataLen / sizeof(float));
     std::string dataStr = {0};
     char arrayStr[DATA_LEN] = {0};
 
     for (int32_t i = 0; i < dataDimension; i++) {
-        if (sprintf_s(arrayStr + strlen(arrayStr), DATA_LEN, "[%f]", data[i]) < 0) {
+        size_t used = strlen(arrayStr);
+        if (sprintf_s(arrayStr + used, DATA_LEN - used, "[%f]", data[i]) < 0) {
             HDF_LOGE("%{public}s: sprintf_s failed", __func__);
-            OsalMemFree(origin);
             return;
         }
     }
 
     dataStr = arrayStr;
     str = "sensorId: " + std::to_string(event.sensorId) + ", ts: " +
-        std::to_string(event.timestamp / 1e9) + ", data: " + dataStr;
-
-    OsalMemFree(origin);
+        std::to_string(record.timestamp / 1e9) + ", data: " + dataStr;
     return;
 }
 
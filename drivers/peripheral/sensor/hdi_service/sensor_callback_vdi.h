@@ -16,6 +16,8 @@
 #ifndef HDI_SENSOR_CALLBACK_VDI_H
 #define HDI_SENSOR_CALLBACK_VDI_H
 
+#include <array>
+#include <atomic>
 #include <iproxy_broker.h>
 #include "sensor_uhdf_log.h"
 #include "isensor_callback_vdi.h"
@@ -38,11 +40,11 @@ public:
     int32_t OnDataEvent(const V2_0::HdfSensorEvents& event) override;
     sptr<IRemoteObject> HandleCallbackDeath() override;
 private:
-    void PrintData(const HdfSensorEvents &event, const std::string &reportResult);
+    void PrintData(const HdfSensorEvents &event, int32_t reportNum);
     void DataToStr(std::string &str, const HdfSensorEvents &event);
     sptr<ISensorCallback> sensorCallback_;
     SensorClientInfo sensorClientInfo_;
-    std::mutex timestampMapMutex_;
+    std::array<std::atomic<int64_t>, HDF_SENSOR_TYPE_MAX> firstTimestamp_ {};
 };
 
 } // V2_0
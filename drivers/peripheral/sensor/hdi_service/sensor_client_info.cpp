@@ -39,10 +39,28 @@ void SensorClientInfo::SetReportDataCb(const sptr<ISensorCallback> &callbackObj)
     pollCallback_ = callbackObj;
 }
 
+std::shared_ptr<std::atomic<int32_t>> SensorClientInfo::GetCurCount(int32_t sensorId)
+{
+    auto &curCount = curCountMap_[sensorId];
+    if (curCount == nullptr) {
+        curCount = std::make_shared<std::atomic<int32_t>>(0);
+    }
+    return curCount;
+}
+
+int32_t SensorClientInfo::GetCurCountValue(int32_t sensorId) const
+{
+    auto it = curCountMap_.find(sensorId);
+    if (it == curCountMap_.end() || it->second == nullptr) {
+        return 0;
+    }
+    return it->second->load(std::memory_order_relaxed);
+}
+
 void SensorClientInfo::PrintClientMapInfo(int32_t serviceId, int32_t sensorId)
 {
     HDF_LOGD("%{public}s: service = %{public}d, sensorId = %{public}d, curCount/periodCount = %{public}d/%{public}d",
-             __func__, serviceId, sensorId, curCountMap_[sensorId], periodCountMap_[sensorId]);
+             __func__, serviceId, sensorId, GetCurCountValue(sensorId), periodCountMap_[sensorId]);
 }
 
 const sptr<ISensorCallback> SensorClientInfo::GetReportDataCb()
@@ -50,6 +68,16 @@ const sptr<ISensorCallback> SensorClientInfo::GetReportDataCb()
     return pollCallback_;
 }
 
+void SensorClientInfo::SetEventQueue(const std::shared_ptr<SensorEventQueue> &eventQueue)
+{
+    eventQueue_ = eventQueue;
+}
+
+const std::shared_ptr<SensorEventQueue> SensorClientInfo::GetEventQueue()
+{
+    return eventQueue_;
+}
+
 } // V2_0
 } // Sensor
 } // HDI
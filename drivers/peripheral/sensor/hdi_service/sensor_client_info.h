@@ -16,10 +16,13 @@
 #ifndef HDI_SENSOR_CLIENT_H
 #define HDI_SENSOR_CLIENT_H
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include "v2_0/isensor_interface.h"
 #include "isensor_interface_vdi.h"
+#include "sensor_event_queue.h"
 
 namespace OHOS {
 namespace HDI {
@@ -34,12 +37,17 @@ public:
         : pollCallback_(callbackObj) {};
     void SetReportDataCb(const sptr<ISensorCallback> &callbackObj);
     const sptr<ISensorCallback> GetReportDataCb();
+    void SetEventQueue(const std::shared_ptr<SensorEventQueue> &eventQueue);
+    const std::shared_ptr<SensorEventQueue> GetEventQueue();
     std::unordered_map<int32_t, struct SensorConfig> sensorConfigMap_;
     std::unordered_map<int32_t, int32_t> periodCountMap_;
-    std::unordered_map<int32_t, int32_t> curCountMap_;
+    std::unordered_map<int32_t, std::shared_ptr<std::atomic<int32_t>>> curCountMap_;
+    std::shared_ptr<std::atomic<int32_t>> GetCurCount(int32_t sensorId);
+    int32_t GetCurCountValue(int32_t sensorId) const;
     void PrintClientMapInfo(int32_t serviceId, int32_t sensorId);
 private:
     sptr<ISensorCallback> pollCallback_;
+    std::shared_ptr<SensorEventQueue> eventQueue_;
 };
 
 struct SensorConfig {
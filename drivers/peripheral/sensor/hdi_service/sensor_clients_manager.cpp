@@ -15,6 +15,7 @@
 
 #include "sensor_uhdf_log.h"
 #include "sensor_clients_manager.h"
+#include <algorithm>
 #include <cinttypes>
 
 #define HDF_LOG_TAG uhdf_sensor_clients_manager
@@ -67,28 +68,45 @@ void SensorClientsManager::CopySensorInfo(std::vector<HdfSensorInformation> &inf
 
 void SensorClientsManager::GetEventData(struct SensorsDataPack &dataPack)
 {
-    std::unique_lock<std::mutex> lock(sensorsDataPackMutex_);
-    dataPack = listDump_;
+    dataPack.count = 0;
+    dataPack.pos = 0;
+    uint64_t writePos = dumpWritePos_.load(std::memory_order_acquire);
+    uint64_t readPos = writePos > MAX_DUMP_DATA_SIZE ? writePos - MAX_DUMP_DATA_SIZE : 0;
+    for (; readPos < writePos; ++readPos) {
+        SensorDumpSlot &slot = dumpRing_[readPos % MAX_DUMP_DATA_SIZE];
+        uint32_t seq = slot.seq.load(std::memory_order_acquire);
+        if ((seq & 1) != 0) {
+            continue;
+        }
+        HdfSensorEventRecord record = slot.record;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) {
+            continue;
+        }
+        dataPack.listDumpArray[dataPack.count++] = record;
+    }
     return;
 }
 
-void SensorClientsManager::CopyEventData(const struct HdfSensorEvents event)
+void SensorClientsManager::CopyEventData(const struct HdfSensorEvents &event)
 {
-    std::unique_lock<std::mutex> lock(sensorsDataPackMutex_);
     if (event.data.empty()) {
         HDF_LOGE("%{public}s: event data is empty!", __func__);
         return;
     }
-
-    if (listDump_.count == MAX_DUMP_DATA_SIZE) {
-        listDump_.listDumpArray[listDump_.pos++] = event;
-        if (listDump_.pos == MAX_DUMP_DATA_SIZE) {
-            listDump_.pos = 0;
-        }
-    } else {
-        listDump_.listDumpArray[listDump_.count] = event;
-        listDump_.count++;
+    uint64_t writePos = dumpWritePos_.load(std::memory_order_relaxed);
+    SensorDumpSlot &slot = dumpRing_[writePos % MAX_DUMP_DATA_SIZE];
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    // Another report thread owns the slot, the dump only needs recent samples so skip this one
+    if ((seq & 1) != 0 || !slot.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+        return;
     }
+    std::atomic_thread_fence(std::memory_order_release);
+    if (!PackSensorBatchLastSample(event, slot.record)) {
+        PackSensorEventRecord(event, slot.record);
+    }
+    slot.seq.store(seq + 2, std::memory_order_release);
+    dumpWritePos_.fetch_add(1, std::memory_order_release);
     return;
 }
 
@@ -115,16 +133,35 @@ void SensorClientsManager::ReportDataCbRegister(int groupId, int serviceId, cons
         }
         clients_[groupId].emplace(serviceId, callbackObj);
         HDF_LOGD("%{public}s: service %{public}d insert the callback", __func__, serviceId);
+        lock.unlock();
+        RebuildDispatchTable();
         return;
     }
 
     auto it = clients_[groupId].find(serviceId);
     it -> second.SetReportDataCb(callbackObj);
     HDF_LOGD("%{public}s: service %{public}d update the callback", __func__, serviceId);
-
+    lock.unlock();
+    RebuildDispatchTable();
     return;
 }
 
+bool SensorClientsManager::EventQueueRegister(int groupId, int serviceId,
+    const std::shared_ptr<SensorEventQueue> &eventQueue)
+{
+    SENSOR_TRACE_PID;
+    std::unique_lock<std::mutex> lock(clientsMutex_);
+    if (clients_.find(groupId) == clients_.end() || clients_[groupId].find(serviceId) == clients_[groupId].end()) {
+        HDF_LOGE("%{public}s: service %{public}d has no callback registered", __func__, serviceId);
+        return false;
+    }
+    clients_[groupId].find(serviceId)->second.SetEventQueue(eventQueue);
+    HDF_LOGI("%{public}s: service %{public}d event queue registered", __func__, serviceId);
+    lock.unlock();
+    RebuildDispatchTable();
+    return true;
+}
+
 void SensorClientsManager::ReportDataCbUnRegister(int groupId, int serviceId, const sptr<ISensorCallback> &callbackObj)
 {
     SENSOR_TRACE_PID;
@@ -137,6 +174,8 @@ void SensorClientsManager::ReportDataCbUnRegister(int groupId, int serviceId, co
     auto it = clients_[groupId].find(serviceId);
     clients_[groupId].erase(it);
     HDF_LOGD("%{public}s: service: %{public}d, UnRegisterCB Success", __func__, serviceId);
+    lock.unlock();
+    RebuildDispatchTable();
     return;
 }
 
@@ -190,9 +229,8 @@ void SensorClientsManager::UpdateClientPeriodCount(int sensorId, int64_t samplin
     std::string result = "";
     for (auto &entry : clients_[groupId]) {
         auto &client = entry.second;
-        if (client.curCountMap_.find(sensorId) == client.curCountMap_.end()) {
-            client.curCountMap_[sensorId] = INIT_CUR_COUNT;
-        }
+        // Only a client new to the sensor starts counting, the others keep their phase
+        (void)client.GetCurCount(sensorId);
         if (client.sensorConfigMap_.find(sensorId) != client.sensorConfigMap_.end()) {
             int32_t periodCount = client.sensorConfigMap_.find(sensorId)->second.samplingInterval / samplingInterval;
             result += " serviceId=" + std::to_string(entry.first) + ", sensorId=" + std::to_string(sensorId) +
@@ -202,6 +240,8 @@ void SensorClientsManager::UpdateClientPeriodCount(int sensorId, int64_t samplin
         }
     }
     HDF_LOGI("%{public}s: %{public}s", __func__, result.c_str());
+    lock.unlock();
+    RebuildDispatchTable();
 }
 
 void SensorClientsManager::SetSensorBestConfig(int sensorId, int64_t &samplingInterval, int64_t &reportInterval)
@@ -282,6 +322,8 @@ void SensorClientsManager::OpenSensor(int sensorId, int serviceId)
     std::set<int> service = {serviceId};
     sensorUsed_.emplace(sensorId, service);
     HDF_LOGD("%{public}s: service: %{public}d enabled sensor %{public}d", __func__,  serviceId, sensorId);
+    lock.unlock();
+    RebuildDispatchTable();
 }
 
 bool SensorClientsManager::IsNeedOpenSensor(int sensorId, int serviceId)
@@ -337,13 +379,10 @@ bool SensorClientsManager::IsUpadateSensorState(int sensorId, int serviceId, boo
 {
     SENSOR_TRACE_PID;
     std::unique_lock<std::mutex> lock(sensorUsedMutex_);
-    if (isOpen && IsNeedOpenSensor(sensorId, serviceId)) {
-        return true;
-    }
-    if (!isOpen && IsNeedCloseSensor(sensorId, serviceId)) {
-        return true;
-    }
-    return false;
+    bool result = isOpen ? IsNeedOpenSensor(sensorId, serviceId) : IsNeedCloseSensor(sensorId, serviceId);
+    lock.unlock();
+    RebuildDispatchTable();
+    return result;
 }
 
 bool SensorClientsManager::IsClientsEmpty(int groupId)
@@ -413,80 +452,100 @@ bool SensorClientsManager::IsSensorContinues(int32_t sensorId)
     return std::find(continuesSensor.begin(), continuesSensor.end(), sensorId) != continuesSensor.end();
 }
 
-bool SensorClientsManager::IsNotNeedReportData(SensorClientInfo &sensorClientInfo, const int32_t &sensorId,
-                                               const int32_t &serviceId)
+bool SensorClientsManager::IsNotNeedReportData(const SensorDispatchEntry &entry)
 {
-    SENSOR_TRACE;
-    if (!SensorClientsManager::IsSensorContinues(sensorId)) {
-        return false;
-    }
-    if (sensorClientInfo.periodCountMap_.find(sensorId) == sensorClientInfo.periodCountMap_.end()) {
+    if (entry.periodCount <= 0 || entry.curCount == nullptr) {
         return false;
     }
-    bool result = true;
-    sensorClientInfo.PrintClientMapInfo(serviceId, sensorId);
-    if (sensorClientInfo.curCountMap_[sensorId] == 0) {
-        result = false;
-    }
-    sensorClientInfo.curCountMap_[sensorId]++;
-    if (sensorClientInfo.curCountMap_[sensorId] >= sensorClientInfo.periodCountMap_[sensorId]) {
-        sensorClientInfo.curCountMap_[sensorId] = 0;
-    }
-    return result;
+    int32_t curCount = entry.curCount->load(std::memory_order_relaxed);
+    int32_t nextCount;
+    do {
+        nextCount = curCount + 1 >= entry.periodCount ? INIT_CUR_COUNT : curCount + 1;
+    } while (!entry.curCount->compare_exchange_weak(curCount, nextCount, std::memory_order_relaxed));
+    return curCount != INIT_CUR_COUNT;
 }
 
-std::set<int32_t> SensorClientsManager::GetServiceIds(int32_t &sensorId)
+void SensorClientsManager::RebuildDispatchTable()
 {
     SENSOR_TRACE;
-    std::unique_lock<std::mutex> lock(sensorUsedMutex_);
-    if (sensorUsed_.find(sensorId) == sensorUsed_.end()) {
-        HDF_LOGD("%{public}s sensor %{public}d is not enabled by anyone", __func__, sensorId);
-        return std::set<int32_t>();
+    std::scoped_lock lock(clientsMutex_, sensorUsedMutex_);
+    auto table = std::make_shared<SensorDispatchTable>();
+    auto groupIt = clients_.find(HDF_TRADITIONAL_SENSOR_TYPE);
+    if (groupIt != clients_.end()) {
+        for (const auto &[sensorId, services] : sensorUsed_) {
+            bool isContinues = IsSensorContinues(sensorId);
+            std::vector<SensorDispatchEntry> entries;
+            for (int32_t serviceId : services) {
+                auto clientIt = groupIt->second.find(serviceId);
+                if (clientIt == groupIt->second.end() || clientIt->second.GetReportDataCb() == nullptr) {
+                    continue;
+                }
+                SensorClientInfo &client = clientIt->second;
+                SensorDispatchEntry entry = {
+                    .serviceId = serviceId,
+                    .callback = client.GetReportDataCb(),
+                    .eventQueue = client.GetEventQueue(),
+                    .periodCount = 0,
+                    .curCount = nullptr,
+                };
+                auto periodIt = client.periodCountMap_.find(sensorId);
+                if (isContinues && periodIt != client.periodCountMap_.end()) {
+                    entry.periodCount = periodIt->second;
+                    entry.curCount = client.GetCurCount(sensorId);
+                }
+                entries.push_back(std::move(entry));
+            }
+            if (!entries.empty()) {
+                table->emplace(sensorId, std::move(entries));
+            }
+        }
     }
-    return sensorUsed_.find(sensorId)->second;
+    std::atomic_store(&dispatchTable_, std::shared_ptr<const SensorDispatchTable>(std::move(table)));
 }
 
-std::string SensorClientsManager::ReportEachClient(const V2_0::HdfSensorEvents& event)
+std::string SensorClientsManager::GetServiceIdsStr(int32_t sensorId)
 {
-    SENSOR_TRACE;
     std::string result = "services=";
-    int32_t sensorId = event.sensorId;
-    const std::set<int32_t> services = GetServiceIds(sensorId);
-    int32_t groupId = HDF_TRADITIONAL_SENSOR_TYPE;
-    {
-        std::unique_lock<std::mutex> lock(clientsMutex_);
-        if (clients_.find(groupId) == clients_.end() || clients_.find(groupId)->second.empty()) {
-            HDF_LOGE("%{public}s groupId %{public}d is not enabled by anyone", __func__, sensorId);
-            return result;
-        }
+    auto table = std::atomic_load(&dispatchTable_);
+    auto it = table->find(sensorId);
+    if (it == table->end()) {
+        return result;
     }
-    for (auto it = services.begin(); it != services.end(); ++it) {
-        int32_t serviceId = *it;
-        sptr<ISensorCallback> callback;
-        {
-            std::unique_lock<std::mutex> lock(clientsMutex_);
-            if (clients_.find(groupId)->second.find(serviceId) == clients_.find(groupId)->second.end()) {
-                continue;
-            }
-            SensorClientInfo &sensorClientInfo = clients_.find(groupId)->second.find(serviceId)->second;
-            if (IsNotNeedReportData(sensorClientInfo, sensorId, serviceId)) {
-                continue;
-            }
-            callback = sensorClientInfo.GetReportDataCb();
-            if (callback == nullptr) {
-                HDF_LOGD("%{public}s the callback of %{public}d is nullptr", __func__, serviceId);
-                continue;
-            }
+    for (const auto &entry : it->second) {
+        result += std::to_string(entry.serviceId) + " ";
+    }
+    return result;
+}
+
+int32_t SensorClientsManager::ReportEachClient(const V2_0::HdfSensorEvents& event)
+{
+    SENSOR_TRACE_EVENT;
+    int32_t reportNum = 0;
+    std::shared_ptr<const SensorDispatchTable> table = std::atomic_load(&dispatchTable_);
+    auto it = table->find(event.sensorId);
+    if (it == table->end()) {
+        HDF_LOGD("%{public}s sensor %{public}d is not enabled by anyone", __func__, event.sensorId);
+        return reportNum;
+    }
+    // Decimating whole hardware batches would drop bursts, the service decimates their samples instead
+    bool isBatch = event.mode == HDF_SENSOR_MODE_FIFO_BATCH;
+    for (const SensorDispatchEntry &entry : it->second) {
+        if (!isBatch && IsNotNeedReportData(entry)) {
+            continue;
+        }
+        int32_t ret;
+        if (entry.eventQueue != nullptr && entry.eventQueue->CanCarry(event)) {
+            ret = entry.eventQueue->Write(event);
+        } else {
+            ret = entry.callback->OnDataEvent(event);
         }
-        SENSOR_TRACE_MSG("serviceId=" + std::to_string(serviceId) + ",sensorId=" + std::to_string(event.sensorId));
-        int32_t ret = callback->OnDataEvent(event);
         if (ret != HDF_SUCCESS) {
             HDF_LOGD("%{public}s Sensor OnDataEvent failed, error code is %{public}d", __func__, ret);
         } else {
-            result += std::to_string(serviceId) + " ";
+            reportNum++;
         }
     }
-    return result;
+    return reportNum;
 }
 
 std::unordered_map<int32_t, std::set<int32_t>> SensorClientsManager::GetSensorUsed()
@@ -16,6 +16,8 @@
 #ifndef HDI_SENSOR_MANAGER_H
 #define HDI_SENSOR_MANAGER_H
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 #include <set>
@@ -35,24 +37,39 @@ constexpr uint32_t MAX_DUMP_DATA_SIZE = 10;
 struct SensorsDataPack {
     int32_t count;
     int32_t pos;
-    struct HdfSensorEvents listDumpArray[MAX_DUMP_DATA_SIZE];
+    struct HdfSensorEventRecord listDumpArray[MAX_DUMP_DATA_SIZE];
 };
 
+struct SensorDumpSlot {
+    std::atomic<uint32_t> seq { 0 };
+    HdfSensorEventRecord record;
+};
+
+struct SensorDispatchEntry {
+    int32_t serviceId;
+    sptr<ISensorCallback> callback;
+    std::shared_ptr<SensorEventQueue> eventQueue;
+    int32_t periodCount;
+    std::shared_ptr<std::atomic<int32_t>> curCount;
+};
+
+using SensorDispatchTable = std::unordered_map<int32_t, std::vector<SensorDispatchEntry>>;
+
 class SensorClientsManager {
 public:
     ~SensorClientsManager();
     void ReportDataCbRegister(int groupId, int serviceId, const sptr<ISensorCallback> &callbackObj);
     void ReportDataCbUnRegister(int groupId, int serviceId, const sptr<ISensorCallback> &callbackObj);
+    bool EventQueueRegister(int groupId, int serviceId, const std::shared_ptr<SensorEventQueue> &eventQueue);
     void SetSensorBestConfig(int sensorId, int64_t &samplingInterval, int64_t &reportInterval);
     void SetSdcSensorBestConfig(int sensorId, int64_t &samplingInterval, int64_t &reportInterval);
     void GetSensorBestConfig(int sensorId, int64_t &samplingInterval, int64_t &reportInterval);
     void EraseSdcSensorBestConfig(int sensorId);
     bool IsUpadateSensorState(int sensorId, int serviceId, bool isOpen);
-    static bool IsNotNeedReportData(SensorClientInfo &sensorClientInfo, const int32_t &sensorId,
-                                    const int32_t &serviceId);
-    std::string ReportEachClient(const V2_0::HdfSensorEvents& event);
+    static bool IsNotNeedReportData(const SensorDispatchEntry &entry);
+    int32_t ReportEachClient(const V2_0::HdfSensorEvents& event);
     bool GetClients(int groupId, std::unordered_map<int32_t, SensorClientInfo> &client);
-    std::set<int32_t> GetServiceIds(int32_t &sensorId);
+    std::string GetServiceIdsStr(int32_t sensorId);
     bool GetBestSensorConfigMap(std::unordered_map<int32_t, struct BestSensorConfig> &map);
     bool IsClientsEmpty(int groupId);
     bool IsNoSensorUsed();
@@ -70,22 +87,24 @@ public:
     std::mutex sensorConfigMutex_;
     std::mutex sdcSensorConfigMutex_;
     std::mutex sensorInfoMutex_;
-    std::mutex sensorsDataPackMutex_;
     void SetClientSenSorConfig(int32_t sensorId, int32_t serviceId, int64_t samplingInterval, int64_t &reportInterval);
     static bool IsSensorContinues(int32_t sensorId);
     void UpdateClientPeriodCount(int sensorId, int64_t samplingInterval, int64_t reportInterval);
     void CopySensorInfo(std::vector<HdfSensorInformation> &info, bool cFlag);
     void GetEventData(struct SensorsDataPack &dataPack);
-    void CopyEventData(const struct HdfSensorEvents event);
+    void CopyEventData(const struct HdfSensorEvents &event);
 private:
     SensorClientsManager();
+    void RebuildDispatchTable();
     static std::mutex instanceMutex_;
     std::unordered_map<int32_t, std::unordered_map<int, SensorClientInfo>> clients_;
     std::unordered_map<int32_t, std::set<int32_t>> sensorUsed_;
     std::unordered_map<int32_t, struct BestSensorConfig> sensorConfig_;
     std::unordered_map<int32_t, struct BestSensorConfig> sdcSensorConfig_;
     std::vector<HdfSensorInformation> sensorInfo_;
-    SensorsDataPack listDump_ = {0};
+    std::array<SensorDumpSlot, MAX_DUMP_DATA_SIZE> dumpRing_;
+    std::atomic<uint64_t> dumpWritePos_ { 0 };
+    std::shared_ptr<const SensorDispatchTable> dispatchTable_ = std::make_shared<const SensorDispatchTable>();
 };
 
 struct BestSensorConfig {
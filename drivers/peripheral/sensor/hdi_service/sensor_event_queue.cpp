@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sensor_event_queue.h"
+#include <algorithm>
+#include <cinttypes>
+#include <hdf_base.h>
+#include <securec.h>
+#include "sensor_uhdf_log.h"
+
+#define HDF_LOG_TAG uhdf_sensor_event_queue
+
+namespace OHOS {
+namespace HDI {
+namespace Sensor {
+namespace V2_0 {
+namespace {
+// Only reached when the space checked before has been taken meanwhile, the vdi thread never waits longer
+constexpr int64_t EVENT_QUEUE_WRITE_WAIT_NS = 1000;
+} // namespace
+
+void PackSensorEventRecord(const HdfSensorEvents &event, HdfSensorEventRecord &record)
+{
+    size_t dataSize = std::min(event.data.size(), sizeof(record.data));
+    record.sensorId = event.sensorId;
+    record.version = event.version;
+    record.timestamp = event.timestamp;
+    record.option = event.option;
+    record.mode = event.mode;
+    record.dataLen = std::min(event.dataLen, static_cast<uint32_t>(dataSize));
+    record.reserved = 0;
+    if (dataSize > 0 && memcpy_s(record.data, sizeof(record.data), event.data.data(), dataSize) != EOK) {
+        HDF_LOGE("%{public}s: memcpy_s failed", __func__);
+        record.dataLen = 0;
+    }
+}
+
+bool PackSensorBatchLastSample(const HdfSensorEvents &event, HdfSensorEventRecord &record)
+{
+    uint32_t header[HDF_SENSOR_BATCH_HEADER_SIZE / sizeof(uint32_t)] = {0};
+    if (event.mode != HDF_SENSOR_MODE_FIFO_BATCH || event.data.size() < sizeof(header) ||
+        memcpy_s(header, sizeof(header), event.data.data(), sizeof(header)) != EOK) {
+        return false;
+    }
+    uint32_t sampleNum = header[0];
+    uint32_t sampleSize = header[1];
+    if (sampleNum == 0 || sampleNum > HDF_SENSOR_BATCH_MAX_SAMPLE_NUM || sampleSize == 0 ||
+        sampleSize > HDF_SENSOR_BATCH_MAX_SAMPLE_SIZE) {
+        return false;
+    }
+    size_t samplesOffset = sizeof(header) + sampleNum * sizeof(uint32_t);
+    if (event.data.size() < samplesOffset + sampleNum * sampleSize) {
+        return false;
+    }
+    int64_t timestamp = event.timestamp;
+    for (uint32_t i = 0; i < sampleNum; ++i) {
+        uint32_t delta = 0;
+        (void)memcpy_s(&delta, sizeof(delta), event.data.data() + sizeof(header) + i * sizeof(delta), sizeof(delta));
+        timestamp += delta;
+    }
+    record.sensorId = event.sensorId;
+    record.version = event.version;
+    record.timestamp = timestamp;
+    record.option = event.option;
+    record.mode = event.mode;
+    record.dataLen = sampleSize;
+    record.reserved = 0;
+    const uint8_t *lastSample = event.data.data() + samplesOffset + (sampleNum - 1) * sampleSize;
+    if (memcpy_s(record.data, sizeof(record.data), lastSample, sampleSize) != EOK) {
+        HDF_LOGE("%{public}s: memcpy_s failed", __func__);
+        record.dataLen = 0;
+    }
+    return true;
+}
+
+bool SensorEventQueue::IsValid()
+{
+    if (queue_ == nullptr || !queue_->IsGood()) {
+        return false;
+    }
+    // A synced queue keeps one element free, so it must hold more than one record
+    return queue_->GetMeta()->GetElementCount() > HDF_SENSOR_EVENT_RECORD_SIZE;
+}
+
+bool SensorEventQueue::CanCarry(const HdfSensorEvents &event) const
+{
+    return event.dataLen <= HDF_SENSOR_EVENT_RECORD_DATA_SIZE && event.data.size() <= HDF_SENSOR_EVENT_RECORD_DATA_SIZE;
+}
+
+int32_t SensorEventQueue::Write(const HdfSensorEvents &event)
+{
+    if (!CanCarry(event)) {
+        return HDF_ERR_INVALID_PARAM;
+    }
+    HdfSensorEventRecord record = {};
+    PackSensorEventRecord(event, record);
+    std::unique_lock<std::mutex> lock(writeMutex_);
+    // Never block the vdi thread, the subscriber catches up from what is already queued
+    if (queue_->GetAvalidWriteSize() <= HDF_SENSOR_EVENT_RECORD_SIZE) {
+        dropCount_++;
+        HDF_LOGD("%{public}s: queue is full, sensorId %{public}d, dropCount %{public}" PRIu64,
+            __func__, event.sensorId, dropCount_);
+        return HDF_ERR_QUEUE_FULL;
+    }
+    // The bounded write still wakes the subscriber, which a non blocking write of a synced queue does not
+    int32_t ret = queue_->Write(reinterpret_cast<const uint8_t *>(&record), HDF_SENSOR_EVENT_RECORD_SIZE,
+        EVENT_QUEUE_WRITE_WAIT_NS);
+    if (ret != HDF_SUCCESS) {
+        dropCount_++;
+        HDF_LOGD("%{public}s: write failed, sensorId %{public}d, dropCount %{public}" PRIu64,
+            __func__, event.sensorId, dropCount_);
+    }
+    return ret;
+}
+
+uint64_t SensorEventQueue::GetDropCount()
+{
+    std::unique_lock<std::mutex> lock(writeMutex_);
+    return dropCount_;
+}
+
+} // V2_0
+} // Sensor
+} // HDI
+} // OHOS
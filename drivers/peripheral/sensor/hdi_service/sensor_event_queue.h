@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HDI_SENSOR_EVENT_QUEUE_H
+#define HDI_SENSOR_EVENT_QUEUE_H
+
+#include <memory>
+#include <mutex>
+#include <hdi_smq.h>
+#include "v2_0/sensor_types.h"
+#include "v2_1/sensor_types.h"
+
+namespace OHOS {
+namespace HDI {
+namespace Sensor {
+namespace V2_0 {
+
+using OHOS::HDI::Base::SharedMemQueue;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_EVENT_RECORD_DATA_SIZE;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_EVENT_RECORD_SIZE;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_MODE_FIFO_BATCH;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_BATCH_HEADER_SIZE;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_BATCH_MAX_SAMPLE_NUM;
+using OHOS::HDI::Sensor::V2_1::HDF_SENSOR_BATCH_MAX_SAMPLE_SIZE;
+
+struct HdfSensorEventRecord {
+    int32_t sensorId;
+    int32_t version;
+    int64_t timestamp;
+    uint32_t option;
+    int32_t mode;
+    uint32_t dataLen;
+    uint32_t reserved;
+    uint8_t data[HDF_SENSOR_EVENT_RECORD_DATA_SIZE];
+};
+static_assert(sizeof(HdfSensorEventRecord) == HDF_SENSOR_EVENT_RECORD_SIZE, "record layout mismatch");
+
+/* Payload beyond HDF_SENSOR_EVENT_RECORD_DATA_SIZE is truncated, callers that cannot lose data check it first */
+void PackSensorEventRecord(const HdfSensorEvents &event, HdfSensorEventRecord &record);
+/* Packs the newest sample of a HDF_SENSOR_MODE_FIFO_BATCH event, returns false if the batch is malformed */
+bool PackSensorBatchLastSample(const HdfSensorEvents &event, HdfSensorEventRecord &record);
+
+class SensorEventQueue {
+public:
+    explicit SensorEventQueue(const std::shared_ptr<SharedMemQueue<uint8_t>> &queue) : queue_(queue) {}
+    ~SensorEventQueue() = default;
+    bool IsValid();
+    bool CanCarry(const HdfSensorEvents &event) const;
+    int32_t Write(const HdfSensorEvents &event);
+    uint64_t GetDropCount();
+private:
+    std::shared_ptr<SharedMemQueue<uint8_t>> queue_;
+    std::mutex writeMutex_;
+    uint64_t dropCount_ = 0;
+};
+
+} // V2_0
+} // Sensor
+} // HDI
+} // OHOS
+
+#endif // HDI_SENSOR_EVENT_QUEUE_H
@@ -14,7 +14,6 @@
  */
 
 #include "sensor_hdi_dump.h"
-#include "osal_mem.h"
 #include <securec.h>
 #include <unordered_map>
 #include "sensor_uhdf_log.h"
@@ -127,7 +126,7 @@ int32_t SensorHdiDump::ShowData(const float *data,
 int32_t SensorHdiDump::SensorShowData(struct HdfSBuf *reply)
 {
     struct SensorsDataPack eventDumpList;
-    uint8_t *eventData = nullptr;
+    float data[HDF_SENSOR_EVENT_RECORD_DATA_SIZE / sizeof(float)];
 
     SensorClientsManager::GetInstance()->GetEventData(eventDumpList);
 
@@ -136,29 +135,19 @@ int32_t SensorHdiDump::SensorShowData(struct HdfSBuf *reply)
     for (int32_t i = 0; i < eventDumpList.count; i++) {
         int32_t index = static_cast<const uint32_t>(eventDumpList.pos + i) < MAX_DUMP_DATA_SIZE ?
             (eventDumpList.pos + i) : (eventDumpList.pos + i - MAX_DUMP_DATA_SIZE);
-        uint32_t dataLen = eventDumpList.listDumpArray[index].dataLen;
-        eventData = static_cast<uint8_t*>(OsalMemCalloc(dataLen));
-        if (eventData == nullptr) {
-            HDF_LOGE("%{public}s: malloc failed!", __func__);
+        const HdfSensorEventRecord &record = eventDumpList.listDumpArray[index];
+        if (memcpy_s(data, sizeof(data), record.data, record.dataLen) != EOK) {
+            HDF_LOGE("%{public}s: memcpy_s failed!", __func__);
             return HDF_FAILURE;
         }
 
-        std::copy(eventDumpList.listDumpArray[index].data.begin(),
-                  eventDumpList.listDumpArray[index].data.end(), eventData);
-        float *data = reinterpret_cast<float*>(eventData);
+        int32_t dataDimension = static_cast<int32_t>(record.dataLen / sizeof(float));
 
-        int32_t dataDimension = static_cast<int32_t>(dataLen / sizeof(float));
-
-        int32_t ret = ShowData(data, eventDumpList.listDumpArray[index].timestamp, dataDimension,
-                               eventDumpList.listDumpArray[index].sensorId, reply);
+        int32_t ret = ShowData(data, record.timestamp, dataDimension, record.sensorId, reply);
         if (ret != HDF_SUCCESS) {
-            OsalMemFree(eventData);
             HDF_LOGE("%{public}s: print sensor infomation data failed!", __func__);
             return HDF_FAILURE;
         }
-
-        OsalMemFree(eventData);
-        eventData = nullptr;
     }
 
     return HDF_SUCCESS;
@@ -199,7 +188,7 @@ int32_t SensorHdiDump::SensorShowClient(struct HdfSBuf *reply)
             sensorInfoData += "sensorConfig={";
             sensorInfoData += "samplingInterval=" + std::to_string(sensorConfig.samplingInterval) + ",";
             sensorInfoData += "reportInterval=" + std::to_string(sensorConfig.reportInterval) + ",";
-            sensorInfoData += "curCount/periodCount=" + std::to_string(sensorClientInfo.curCountMap_[sensorId]) + "/" +
+            sensorInfoData += "curCount/periodCount=" + std::to_string(sensorClientInfo.GetCurCountValue(sensorId)) + "/" +
                     std::to_string(sensorClientInfo.periodCountMap_[sensorId]) + ",";
             if (sensorEnabled.find(sensorId) != sensorEnabled.end() &&
                 sensorEnabled.find(sensorId)->second.find(serviceId) != sensorEnabled.find(sensorId)->second.end()) {
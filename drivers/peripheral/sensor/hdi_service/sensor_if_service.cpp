@@ -455,6 +455,36 @@ int32_t SensorIfService::Register(int32_t groupId, const sptr<ISensorCallback> &
     return ret;
 }
 
+int32_t SensorIfService::RegisterEventQueue(int32_t groupId, const sptr<ISensorCallback> &callbackObj,
+                                            const std::shared_ptr<SharedMemQueue<uint8_t>> &eventQueue)
+{
+    SENSOR_TRACE_PID;
+    uint32_t serviceId = static_cast<uint32_t>(HdfRemoteGetCallingPid());
+    HDF_LOGI("%{public}s: groupId %{public}d, service %{public}d", __func__, groupId, serviceId);
+    if (groupId < TRADITIONAL_SENSOR_TYPE || groupId >= SENSOR_GROUP_TYPE_MAX) {
+        HDF_LOGE("%{public}s: groupId %{public}d is error", __func__, groupId);
+        return SENSOR_INVALID_PARAM;
+    }
+    auto sensorEventQueue = std::make_shared<SensorEventQueue>(eventQueue);
+    if (!sensorEventQueue->IsValid()) {
+        HDF_LOGE("%{public}s: event queue of service %{public}d is invalid", __func__, serviceId);
+        return SENSOR_INVALID_PARAM;
+    }
+    int32_t ret = Register(groupId, callbackObj);
+    if (ret != SENSOR_SUCCESS) {
+        return ret;
+    }
+    if (!SensorClientsManager::GetInstance()->EventQueueRegister(groupId, serviceId, sensorEventQueue)) {
+        HDF_LOGE("%{public}s: register event queue of service %{public}d failed", __func__, serviceId);
+        // Leave nothing registered, so that the caller can fall back to Register
+        if (Unregister(groupId, callbackObj) != SENSOR_SUCCESS) {
+            HDF_LOGE("%{public}s: Unregister failed, groupId[%{public}d]", __func__, groupId);
+        }
+        return HDF_FAILURE;
+    }
+    return SENSOR_SUCCESS;
+}
+
 int32_t SensorIfService::Unregister(int32_t groupId, const sptr<ISensorCallback> &callbackObj)
 {
     SENSOR_TRACE_PID;
@@ -791,7 +821,7 @@ int32_t SensorIfService::GetSdcSensorInfo(std::vector<SdcSensorInfo>& sdcSensorI
     return ret;
 }
 
-extern "C" ISensorInterface *SensorInterfaceImplGetInstance(void)
+extern "C" V2_1::ISensorInterface *SensorInterfaceImplGetInstance(void)
 {
     SensorIfService *impl = new (std::nothrow) SensorIfService();
     if (impl == nullptr) {
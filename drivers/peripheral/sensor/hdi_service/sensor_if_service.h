@@ -18,6 +18,7 @@
 
 #include <map>
 #include "v2_0/isensor_interface.h"
+#include "v2_1/isensor_interface.h"
 #include "isensor_interface_vdi.h"
 #include "sensor_callback_vdi.h"
 #include "sensor_client_info.h"
@@ -30,7 +31,7 @@ namespace V2_0 {
 
 using GroupIdCallBackMap = std::unordered_map<int32_t, std::vector<sptr<ISensorCallback>>>;
 
-class SensorIfService : public ISensorInterface {
+class SensorIfService : public V2_1::ISensorInterface {
 public:
     SensorIfService();
     ~SensorIfService();
@@ -45,6 +46,8 @@ public:
     int32_t SetOption(int32_t sensorId, uint32_t option) override;
     int32_t Register(int32_t groupId, const sptr<ISensorCallback> &callbackObj) override;
     int32_t Unregister(int32_t groupId, const sptr<ISensorCallback> &callbackObj) override;
+    int32_t RegisterEventQueue(int32_t groupId, const sptr<ISensorCallback> &callbackObj,
+                               const std::shared_ptr<SharedMemQueue<uint8_t>> &eventQueue) override;
     int32_t ReadData(int32_t sensorId, std::vector<HdfSensorEvents> &event) override;
     int32_t SetSdcSensor(int32_t sensorId, bool enabled, int32_t rateLevel) override;
     int32_t GetSdcSensorInfo(std::vector<SdcSensorInfo>& sdcSensorInfo) override;
@@ -50,6 +50,8 @@ extern "C" {
 
 #define SENSOR_NAME_MAX_LEN       32 /**< Maximum length of the sensor name */
 #define SENSOR_VERSION_MAX_LEN    16 /**< Maximum length of the sensor version */
+#define SENSOR_BATCH_MAX_SAMPLE_NUM  1024 /**< Maximum number of samples in a {@link SENSOR_MODE_FIFO_BATCH} event */
+#define SENSOR_BATCH_MAX_SAMPLE_SIZE 64   /**< Maximum size of one sample in a {@link SENSOR_MODE_FIFO_BATCH} event */
 
 /**
  * @brief Enumerates return values of the sensor module.
@@ -152,6 +154,7 @@ enum SensorModeType {
     SENSOR_MODE_ON_CHANGE = 2, /**< Real-time data reporting mode to report data upon status changes */
     SENSOR_MODE_ONE_SHOT  = 3, /**< Real-time data reporting mode to report data only once */
     SENSOR_MODE_FIFO_MODE = 4, /**< FIFO-based data reporting mode to report data based on the configured cache size */
+    SENSOR_MODE_FIFO_BATCH = 5, /**< A whole hardware FIFO burst packed in one event, see {@link SensorBatchHeader} */
     SENSOR_MODE_MAX,           /**< Maximum sensor data reporting mode */
 };
 
@@ -208,6 +211,20 @@ struct SensorEvents {
     uint32_t dataLen;  /**< Sensor data length */
 };
 
+/**
+ * @brief Defines the header of the data of a {@link SENSOR_MODE_FIFO_BATCH} event.
+ *
+ * The header is followed by <b>sampleNum</b> uint32_t time deltas in nanoseconds, the first one relative to
+ * the event timestamp and each other one relative to the previous sample, and then by <b>sampleNum</b> samples
+ * of <b>sampleSize</b> bytes each.
+ *
+ * @since 5.0
+ */
+struct SensorBatchHeader {
+    uint32_t sampleNum;  /**< Number of samples in the batch */
+    uint32_t sampleSize; /**< Size of one sample in bytes */
+};
+
 /**
  * @brief Defines SDC reports data object operations to the node.
  *
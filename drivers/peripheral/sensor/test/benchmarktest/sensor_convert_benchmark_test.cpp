@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+#include "sensor_convert.h"
+
+namespace {
+    constexpr uint32_t SENSOR_AXIS_NUM = 3;
+    constexpr int32_t MIN_FIFO_SAMPLES = 1;
+    constexpr int32_t MAX_FIFO_SAMPLES = 256;
+    constexpr int32_t RAW_VALUE_RANGE = 8192;
+    constexpr float ACCEL_COFF = 9.80665f / 1000 / 1000;
+    const float g_coff[SENSOR_AXIS_NUM] = { ACCEL_COFF, ACCEL_COFF * 2, ACCEL_COFF * 3 };
+
+std::vector<int32_t> MakeRawData(uint32_t num)
+{
+    std::vector<int32_t> raw(num);
+    for (uint32_t i = 0; i < num; ++i) {
+        raw[i] = static_cast<int32_t>(i * 7919 % RAW_VALUE_RANGE) - RAW_VALUE_RANGE / 2;
+    }
+    return raw;
+}
+
+/* The per-element modulo loop the channel used before the batch kernel */
+void ConvertScalar(const int32_t *data, float *value, uint32_t num, const float *coff, uint32_t dim)
+{
+    for (uint32_t i = 0; i < num; ++i) {
+        value[i] = static_cast<float>(data[i] * coff[i % dim]);
+    }
+}
+
+/**
+  * @tc.name: DriverSystem_SensorBenchmark_ConvertScalar
+  * @tc.desc: Benchmarktest for the per-element raw to SI conversion of range(0) xyz samples
+  * @tc.type: FUNC
+  */
+void ConvertScalarBenchmark(benchmark::State &state)
+{
+    uint32_t num = static_cast<uint32_t>(state.range(0)) * SENSOR_AXIS_NUM;
+    std::vector<int32_t> raw = MakeRawData(num);
+    std::vector<float> value(num);
+    for (auto _ : state) {
+        ConvertScalar(raw.data(), value.data(), num, g_coff, SENSOR_AXIS_NUM);
+        benchmark::DoNotOptimize(value.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+  * @tc.name: DriverSystem_SensorBenchmark_ConvertBatch
+  * @tc.desc: Benchmarktest for SensorConvertBatch on range(0) xyz samples, checked against the scalar loop
+  * @tc.type: FUNC
+  */
+void ConvertBatchBenchmark(benchmark::State &state)
+{
+    uint32_t num = static_cast<uint32_t>(state.range(0)) * SENSOR_AXIS_NUM;
+    std::vector<int32_t> raw = MakeRawData(num);
+    std::vector<float> expected(num);
+    std::vector<float> value(num);
+    float pattern[SENSOR_CONVERT_PATTERN_LEN];
+    SensorFillConvertPattern(g_coff, SENSOR_AXIS_NUM, pattern);
+    ConvertScalar(raw.data(), expected.data(), num, g_coff, SENSOR_AXIS_NUM);
+    SensorConvertBatch(raw.data(), value.data(), num, pattern);
+    if (memcmp(expected.data(), value.data(), num * sizeof(float)) != 0) {
+        state.SkipWithError("batch conversion differs from the scalar conversion");
+        return;
+    }
+    for (auto _ : state) {
+        SensorConvertBatch(raw.data(), value.data(), num, pattern);
+        benchmark::DoNotOptimize(value.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ConvertScalarBenchmark)->RangeMultiplier(4)->Range(MIN_FIFO_SAMPLES, MAX_FIFO_SAMPLES);
+BENCHMARK(ConvertBatchBenchmark)->RangeMultiplier(4)->Range(MIN_FIFO_SAMPLES, MAX_FIFO_SAMPLES);
+}
+
+BENCHMARK_MAIN();
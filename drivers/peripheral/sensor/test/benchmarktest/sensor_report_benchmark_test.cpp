@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "hdf_base.h"
+#include "sensor_callback_vdi.h"
+#include "sensor_clients_manager.h"
+
+using namespace OHOS::HDI::Sensor::V2_0;
+using OHOS::HDI::Sensor::V1_1::HdfSensorEventsVdi;
+
+namespace {
+    std::atomic<uint64_t> g_allocCount = 0;
+    thread_local bool g_countAlloc = false;
+
+    constexpr int32_t REPORT_SENSOR_ID = HDF_SENSOR_TYPE_ACCELEROMETER;
+    constexpr int32_t REPORT_SERVICE_BASE = 10000;
+    constexpr int64_t REPORT_INTERVAL_NS = 5000000;
+    constexpr uint32_t REPORT_DATA_LEN = 12;
+    constexpr int32_t MAX_SERVICE_NUM = 4;
+
+class NullSensorCallback : public ISensorCallback {
+public:
+    int32_t OnDataEvent(const HdfSensorEvents &event) override
+    {
+        (void)event;
+        return HDF_SUCCESS;
+    }
+};
+}
+
+void *operator new(size_t size)
+{
+    if (g_countAlloc) {
+        g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    void *ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t size) noexcept
+{
+    (void)size;
+    free(ptr);
+}
+
+namespace {
+/**
+  * @tc.name: DriverSystem_SensorBenchmark_ReportEvent
+  * @tc.desc: Benchmarktest for the vdi data path, from OnDataEventVdi to the subscriber callbacks
+  * Reports the heap allocations made per event with range(0) subscribed services
+  * @tc.type: FUNC
+  */
+void ReportEvent(benchmark::State &state)
+{
+    SensorClientsManager *manager = SensorClientsManager::GetInstance();
+    int32_t serviceNum = static_cast<int32_t>(state.range(0));
+    std::vector<OHOS::sptr<ISensorCallback>> callbacks;
+    for (int32_t i = 0; i < serviceNum; ++i) {
+        OHOS::sptr<ISensorCallback> callback = new NullSensorCallback();
+        callbacks.push_back(callback);
+        manager->ReportDataCbRegister(HDF_TRADITIONAL_SENSOR_TYPE, REPORT_SERVICE_BASE + i, callback);
+        if (manager->IsUpadateSensorState(REPORT_SENSOR_ID, REPORT_SERVICE_BASE + i, true)) {
+            manager->OpenSensor(REPORT_SENSOR_ID, REPORT_SERVICE_BASE + i);
+        }
+    }
+    OHOS::sptr<SensorCallbackVdi> callbackVdi = new SensorCallbackVdi(callbacks.empty() ? nullptr : callbacks[0]);
+    HdfSensorEventsVdi eventVdi = {
+        .sensorId = REPORT_SENSOR_ID,
+        .version = 0,
+        .timestamp = 0,
+        .option = 0,
+        .mode = 0,
+        .data = std::vector<uint8_t>(REPORT_DATA_LEN, 0),
+        .dataLen = REPORT_DATA_LEN,
+    };
+    // Warm up the reused buffers so that only the steady state is counted
+    callbackVdi->OnDataEventVdi(eventVdi);
+    g_allocCount = 0;
+    g_countAlloc = true;
+    for (auto _ : state) {
+        eventVdi.timestamp += REPORT_INTERVAL_NS;
+        callbackVdi->OnDataEventVdi(eventVdi);
+    }
+    g_countAlloc = false;
+    state.counters["allocs_per_event"] = benchmark::Counter(static_cast<double>(g_allocCount.load()),
+        benchmark::Counter::kAvgIterations);
+    for (int32_t i = 0; i < serviceNum; ++i) {
+        manager->IsUpadateSensorState(REPORT_SENSOR_ID, REPORT_SERVICE_BASE + i, false);
+        manager->ReportDataCbUnRegister(HDF_TRADITIONAL_SENSOR_TYPE, REPORT_SERVICE_BASE + i, callbacks[i]);
+    }
+}
+
+BENCHMARK(ReportEvent)->DenseRange(1, MAX_SERVICE_NUM);
+}
+
+BENCHMARK_MAIN();
@@ -21,6 +21,11 @@
 #define SENSOR_TRACE_TAG HITRACE_TAG_HDF
 #define SENSOR_TRACE HITRACE_METER_NAME(SENSOR_TRACE_TAG, __func__)
 
+/* Same as SENSOR_TRACE, but the name is built once, for functions that run for every sensor event */
+#define SENSOR_TRACE_EVENT \
+    static const std::string SENSOR_TRACE_EVENT_NAME(__func__); \
+    HITRACE_METER_NAME(SENSOR_TRACE_TAG, SENSOR_TRACE_EVENT_NAME)
+
 #define SENSOR_TRACE_PID HITRACE_METER_NAME(SENSOR_TRACE_TAG, (std::string(__func__) + ":pid " + \
     std::to_string(static_cast<uint32_t>(HdfRemoteGetCallingPid()))).c_str())
 